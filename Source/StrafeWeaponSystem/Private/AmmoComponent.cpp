@@ -0,0 +1,223 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AmmoComponent.h"
+#include "StrafeCharacter.h"
+#include "Net/UnrealNetwork.h"
+
+void FAmmoEntry::PostReplicatedAdd(const FAmmoList& InArraySerializer)
+{
+    if (InArraySerializer.Owner)
+    {
+        InArraySerializer.Owner->OnEntryReplicated(*this, true);
+    }
+}
+
+void FAmmoEntry::PostReplicatedChange(const FAmmoList& InArraySerializer)
+{
+    if (InArraySerializer.Owner)
+    {
+        InArraySerializer.Owner->OnEntryReplicated(*this, false);
+    }
+}
+
+void FAmmoEntry::PreReplicatedRemove(const FAmmoList& InArraySerializer)
+{
+    if (InArraySerializer.Owner)
+    {
+        InArraySerializer.Owner->OnEntryRemoved(*this);
+    }
+}
+
+UAmmoComponent::UAmmoComponent()
+{
+    PrimaryComponentTick.bCanEverTick = false;
+    SetIsReplicatedByDefault(true);
+
+    AmmoList.Owner = this;
+}
+
+void UAmmoComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+    // Only the owner needs exact counts (see UStrafeAttributeSet::HasAmmo for the other clients'
+    // view of attribute ammo). The fast array tracks its own changes through MarkItemDirty.
+    FDoRepLifetimeParams Params;
+    Params.Condition = COND_OwnerOnly;
+    DOREPLIFETIME_WITH_PARAMS_FAST(UAmmoComponent, AmmoList, Params);
+}
+
+UAmmoComponent* UAmmoComponent::FindAmmoComponent(const AActor* Actor)
+{
+    if (const AStrafeCharacter* Character = Cast<AStrafeCharacter>(Actor))
+    {
+        return Character->GetAmmoComponent();
+    }
+    return Actor ? Actor->FindComponentByClass<UAmmoComponent>() : nullptr;
+}
+
+void UAmmoComponent::SetAmmo(FGameplayTag AmmoType, int32 Current, int32 Max)
+{
+    if (!AmmoType.IsValid() || !GetOwner() || !GetOwner()->HasAuthority())
+    {
+        return;
+    }
+
+    Max = FMath::Max(Max, 0);
+    Current = FMath::Clamp(Current, 0, Max);
+
+    FAmmoEntry* Entry = const_cast<FAmmoEntry*>(FindEntry(AmmoType));
+    if (!Entry)
+    {
+        Entry = &AmmoList.Entries.AddDefaulted_GetRef();
+        Entry->AmmoType = AmmoType;
+        EntryIndexByType.Add(AmmoType, AmmoList.Entries.Num() - 1);
+    }
+    else if (Entry->Current == Current && Entry->Max == Max)
+    {
+        return;
+    }
+
+    Entry->Current = Current;
+    Entry->Max = Max;
+    AmmoList.MarkItemDirty(*Entry);
+    OnAmmoChanged.Broadcast(AmmoType, Current, Max);
+}
+
+int32 UAmmoComponent::AddAmmo(FGameplayTag AmmoType, int32 Amount)
+{
+    if (!GetOwner() || !GetOwner()->HasAuthority())
+    {
+        return 0;
+    }
+
+    FAmmoEntry* Entry = const_cast<FAmmoEntry*>(FindEntry(AmmoType));
+    if (!Entry)
+    {
+        return 0;
+    }
+
+    const int32 NewCurrent = FMath::Clamp(Entry->Current + Amount, 0, Entry->Max);
+    const int32 Applied = NewCurrent - Entry->Current;
+    if (Applied != 0)
+    {
+        Entry->Current = NewCurrent;
+        AmmoList.MarkItemDirty(*Entry);
+        OnAmmoChanged.Broadcast(AmmoType, Entry->Current, Entry->Max);
+    }
+    return Applied;
+}
+
+void UAmmoComponent::RemoveAmmoType(FGameplayTag AmmoType)
+{
+    if (!GetOwner() || !GetOwner()->HasAuthority())
+    {
+        return;
+    }
+
+    const FAmmoEntry* Entry = FindEntry(AmmoType);
+    if (!Entry)
+    {
+        return;
+    }
+
+    // Nobody depends on the order, so the last entry is swapped in
+    AmmoList.Entries.RemoveAtSwap(UE_PTRDIFF_TO_INT32(Entry - AmmoList.Entries.GetData()));
+    AmmoList.MarkArrayDirty();
+    bIndexStale = true;
+    OnAmmoChanged.Broadcast(AmmoType, 0, 0);
+}
+
+void UAmmoComponent::PredictSpend(FGameplayTag AmmoType, int32 Amount, FPredictionKey PredictionKey)
+{
+    if (Amount <= 0 || !PredictionKey.IsLocalClientKey() || !FindEntry(AmmoType))
+    {
+        return;
+    }
+
+    PredictedSpends.Add({ AmmoType, Amount, PredictionKey.Current });
+    PredictionKey.NewRejectOrCaughtUpDelegate(FPredictionKeyEvent::CreateUObject(this, &UAmmoComponent::OnSpendPredictionResolved, PredictionKey.Current));
+    OnAmmoChanged.Broadcast(AmmoType, GetAmmo(AmmoType), GetMaxAmmo(AmmoType));
+}
+
+int32 UAmmoComponent::GetAmmo(FGameplayTag AmmoType) const
+{
+    const FAmmoEntry* Entry = FindEntry(AmmoType);
+    return Entry ? FMath::Max(Entry->Current - GetPredictedSpend(AmmoType), 0) : 0;
+}
+
+int32 UAmmoComponent::GetMaxAmmo(FGameplayTag AmmoType) const
+{
+    const FAmmoEntry* Entry = FindEntry(AmmoType);
+    return Entry ? Entry->Max : 0;
+}
+
+const FAmmoEntry* UAmmoComponent::FindEntry(const FGameplayTag& AmmoType) const
+{
+    if (bIndexStale)
+    {
+        RebuildIndex();
+    }
+
+    const int32* Index = EntryIndexByType.Find(AmmoType);
+    if (Index && (!AmmoList.Entries.IsValidIndex(*Index) || AmmoList.Entries[*Index].AmmoType != AmmoType))
+    {
+        // A lookup from inside a replication callback can see the array mid-update
+        RebuildIndex();
+        Index = EntryIndexByType.Find(AmmoType);
+    }
+    return Index ? &AmmoList.Entries[*Index] : nullptr;
+}
+
+void UAmmoComponent::OnEntryReplicated(const FAmmoEntry& Entry, bool bAdded)
+{
+    // Adds and removes can shift entries, so the index is rebuilt on the next lookup rather than patched
+    if (bAdded)
+    {
+        bIndexStale = true;
+    }
+    OnAmmoChanged.Broadcast(Entry.AmmoType, FMath::Max(Entry.Current - GetPredictedSpend(Entry.AmmoType), 0), Entry.Max);
+}
+
+void UAmmoComponent::OnEntryRemoved(const FAmmoEntry& Entry)
+{
+    bIndexStale = true;
+    OnAmmoChanged.Broadcast(Entry.AmmoType, 0, 0);
+}
+
+int32 UAmmoComponent::GetPredictedSpend(const FGameplayTag& AmmoType) const
+{
+    int32 Amount = 0;
+    for (const FPredictedSpend& Spend : PredictedSpends)
+    {
+        if (Spend.AmmoType == AmmoType)
+        {
+            Amount += Spend.Amount;
+        }
+    }
+    return Amount;
+}
+
+void UAmmoComponent::OnSpendPredictionResolved(int16 PredictionKeyId)
+{
+    // Caught up means the server's count already carries the spend; rejected means it never happened
+    for (int32 Index = PredictedSpends.Num() - 1; Index >= 0; --Index)
+    {
+        if (PredictedSpends[Index].PredictionKeyId == PredictionKeyId)
+        {
+            const FGameplayTag AmmoType = PredictedSpends[Index].AmmoType;
+            PredictedSpends.RemoveAtSwap(Index);
+            OnAmmoChanged.Broadcast(AmmoType, GetAmmo(AmmoType), GetMaxAmmo(AmmoType));
+        }
+    }
+}
+
+void UAmmoComponent::RebuildIndex() const
+{
+    EntryIndexByType.Reset();
+    for (int32 Index = 0; Index < AmmoList.Entries.Num(); ++Index)
+    {
+        EntryIndexByType.Add(AmmoList.Entries[Index].AmmoType, Index);
+    }
+    bIndexStale = false;
+}
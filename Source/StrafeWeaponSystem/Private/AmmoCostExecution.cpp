@@ -0,0 +1,48 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AmmoCostExecution.h"
+#include "AmmoComponent.h"
+#include "BaseWeapon.h"
+#include "StrafeCharacter.h"
+#include "WeaponDataAsset.h"
+#include "StrafeGameplayTags.h"
+#include "AbilitySystemComponent.h"
+
+FGameplayTag UAmmoCostExecution::ResolveAmmoType(const FGameplayTagContainer& AssetTags, const UWeaponDataAsset* WeaponData)
+{
+    for (const FGameplayTag& Tag : AssetTags)
+    {
+        if (Tag.MatchesTag(StrafeGameplayTags::Ammo) && Tag != StrafeGameplayTags::Ammo)
+        {
+            return Tag;
+        }
+    }
+    return WeaponData ? WeaponData->AmmoTypeTag : FGameplayTag();
+}
+
+void UAmmoCostExecution::Execute_Implementation(const FGameplayEffectCustomExecutionParameters& ExecutionParams, FGameplayEffectCustomExecutionOutput& OutExecutionOutput) const
+{
+    const FGameplayEffectSpec& Spec = ExecutionParams.GetOwningSpec();
+    const UAbilitySystemComponent* TargetASC = ExecutionParams.GetTargetAbilitySystemComponent();
+    UAmmoComponent* AmmoComponent = TargetASC ? UAmmoComponent::FindAmmoComponent(TargetASC->GetAvatarActor()) : nullptr;
+    if (!AmmoComponent)
+    {
+        return;
+    }
+
+    FGameplayTagContainer AssetTags;
+    Spec.GetAllAssetTags(AssetTags);
+
+    const AStrafeCharacter* Character = Cast<AStrafeCharacter>(Spec.GetContext().GetInstigator());
+    const ABaseWeapon* Weapon = Character ? Character->GetCurrentWeapon() : nullptr;
+    const FGameplayTag AmmoType = ResolveAmmoType(AssetTags, Weapon ? Weapon->GetWeaponData() : nullptr);
+
+    if (!AmmoType.IsValid())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("UAmmoCostExecution: No ammo type for %s; nothing spent."), *GetNameSafe(Spec.Def));
+        return;
+    }
+
+    const int32 Cost = FMath::RoundToInt(Spec.GetSetByCallerMagnitude(StrafeGameplayTags::SetByCaller_AmmoCost, false, 1.0f));
+    AmmoComponent->AddAmmo(AmmoType, -Cost);
+}
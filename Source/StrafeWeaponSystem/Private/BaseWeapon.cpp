@@ -1,7 +1,12 @@
 #include "BaseWeapon.h"
 #include "WeaponInventoryComponent.h" // May not be needed directly anymore
 #include "ProjectileBase.h"
+#include "ProjectilePoolSubsystem.h"
+#include "NetDormancyPolicy.h"
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemBlueprintLibrary.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 #include "GameFramework/Character.h"
 #include "GameFramework/Controller.h"
 #include "Components/SkeletalMeshComponent.h"
@@ -13,6 +18,9 @@
 #include "NiagaraComponent.h"
 #include "NiagaraFunctionLibrary.h"
 #include "WeaponDataAsset.h" // Required
+#if UE_WITH_IRIS
+#include "Net/Iris/ReplicationSystem/ReplicationSystemUtil.h"
+#endif
 
 ABaseWeapon::ABaseWeapon()
 {
@@ -20,6 +28,9 @@ ABaseWeapon::ABaseWeapon()
     bReplicates = true;
     SetReplicateMovement(true);
 
+    // Holstered weapons sleep; Equip wakes the one in hand, which also carries ServerDetonateProjectiles
+    NetDormancy = FNetDormancyPolicy::GetInitialDormancy(DORM_DormantAll);
+
     WeaponMesh = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("WeaponMesh"));
     RootComponent = WeaponMesh;
 
@@ -30,6 +41,14 @@ void ABaseWeapon::BeginPlay()
 {
     Super::BeginPlay();
 
+#if UE_WITH_IRIS
+    // Iris doesn't use the replication graph; the weapon rides along with its owner the same way
+    if (HasAuthority() && GetOwner())
+    {
+        UE::Net::FReplicationSystemUtil::AddDependentActor(GetOwner(), this);
+    }
+#endif
+
     // CurrentAmmo initialization is removed. Handled by AttributeSet.
     if (WeaponData)
     {
@@ -38,6 +57,18 @@ void ABaseWeapon::BeginPlay()
             WeaponMesh->SetSkeletalMesh(WeaponData->WeaponMesh);
         }
         UE_LOG(LogTemp, Warning, TEXT("Weapon %s initialized."), *GetName());
+
+        // Pre-warm the projectile pool so the first shots don't pay for SpawnActor
+        if (HasAuthority())
+        {
+            if (UProjectilePoolSubsystem* ProjectilePool = GetWorld()->GetSubsystem<UProjectilePoolSubsystem>())
+            {
+                const int32 PrewarmCount = WeaponData->WeaponStats.ProjectilePoolPrewarmCount;
+                const bool bReplicated = WeaponData->WeaponStats.ReplicationMode != EProjectileReplicationMode::SpawnRecord;
+                ProjectilePool->PrewarmPool(WeaponData->WeaponStats.PrimaryProjectileClass, PrewarmCount, bReplicated);
+                ProjectilePool->PrewarmPool(WeaponData->WeaponStats.SecondaryProjectileClass, PrewarmCount, bReplicated);
+            }
+        }
     }
     else
     {
@@ -50,12 +81,42 @@ void ABaseWeapon::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifet
     Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
     // DOREPLIFETIME(ABaseWeapon, CurrentAmmo); // Removed
-    DOREPLIFETIME(ABaseWeapon, bIsEquipped);
+    FDoRepLifetimeParams Params;
+    Params.bIsPushBased = true;
+    DOREPLIFETIME_WITH_PARAMS_FAST(ABaseWeapon, bIsEquipped, Params);
     // DOREPLIFETIME(ABaseWeapon, StatModifierValues); // Removed
     // ActiveProjectiles are not typically replicated directly.
     // Their state/existence is usually handled by spawning them on server and replicating the actor itself.
 }
 
+FOnWeaponOwnerChanged ABaseWeapon::OnWeaponOwnerChanged;
+
+void ABaseWeapon::SetOwner(AActor* NewOwner)
+{
+    AActor* OldOwner = GetOwner();
+    Super::SetOwner(NewOwner);
+
+    if (OldOwner != NewOwner)
+    {
+        OnWeaponOwnerChanged.Broadcast(this, OldOwner);
+
+#if UE_WITH_IRIS
+        // Before BeginPlay the weapon isn't replicating yet; BeginPlay adds the dependency instead
+        if (HasAuthority() && HasActorBegunPlay())
+        {
+            if (OldOwner)
+            {
+                UE::Net::FReplicationSystemUtil::RemoveDependentActor(OldOwner, this);
+            }
+            if (NewOwner)
+            {
+                UE::Net::FReplicationSystemUtil::AddDependentActor(NewOwner, this);
+            }
+        }
+#endif
+    }
+}
+
 // StartPrimaryFire, StopPrimaryFire, ServerStartPrimaryFire, ServerStopPrimaryFire, PrimaryFireInternal are REMOVED.
 // MulticastFireEffects is REMOVED (effects handled by Ability or GameplayCue).
 // ConsumeAmmo, AddAmmo, OnRep_CurrentAmmo are REMOVED.
@@ -71,9 +132,12 @@ void ABaseWeapon::Equip(ACharacter* NewOwner)
 
     UE_LOG(LogTemp, Warning, TEXT("Equipping weapon %s to %s"), *GetName(), *NewOwner->GetName());
 
+    FNetDormancyPolicy::Wake(this);
+
     SetOwner(NewOwner);
     SetInstigator(NewOwner);
     bIsEquipped = true;
+    MARK_PROPERTY_DIRTY_FROM_NAME(ABaseWeapon, bIsEquipped, this);
     SetActorHiddenInGame(false);
 
     if (WeaponData && WeaponData->EquipSound)
@@ -103,36 +167,426 @@ void ABaseWeapon::Unequip()
     // If there are any weapon-specific active states (e.g. charging effects not tied to an ability), clear them.
 
     bIsEquipped = false;
+    MARK_PROPERTY_DIRTY_FROM_NAME(ABaseWeapon, bIsEquipped, this);
     SetActorHiddenInGame(true);
+    FNetDormancyPolicy::Sleep(this);
     // SetOwner(nullptr); // Optional: clear owner if needed, but inventory component handles lifetime.
     // SetInstigator(nullptr);
 }
 
 
+void FActiveProjectileRing::Add(AProjectileBase* Projectile)
+{
+    if (Span == Slots.Num())
+    {
+        // Full: grow when mostly live, otherwise squeezing the holes out is enough
+        Repack(Num * 2 >= Slots.Num() ? FMath::Max(8, Slots.Num() * 2) : Slots.Num());
+    }
+
+    const int32 Slot = (Head + Span) & (Slots.Num() - 1);
+    Slots[Slot] = Projectile;
+    Projectile->RegistrySlot = Slot;
+    ++Span;
+    ++Num;
+}
+
+bool FActiveProjectileRing::Remove(AProjectileBase* Projectile)
+{
+    const int32 Slot = Projectile->RegistrySlot;
+    if (!Slots.IsValidIndex(Slot) || Slots[Slot] != Projectile)
+    {
+        return false;
+    }
+
+    Slots[Slot] = nullptr;
+    Projectile->RegistrySlot = INDEX_NONE;
+    --Num;
+
+    const int32 Mask = Slots.Num() - 1;
+    while (Span > 0 && !Slots[Head])
+    {
+        Head = (Head + 1) & Mask;
+        --Span;
+    }
+    while (Span > 0 && !GetAtOffset(Span - 1))
+    {
+        --Span;
+    }
+
+    // Keep iteration O(1) per live entry
+    if (Span > Num * 2 + 4)
+    {
+        Repack(Slots.Num());
+    }
+    return true;
+}
+
+void FActiveProjectileRing::Repack(int32 NewCapacity)
+{
+    TArray<TObjectPtr<AProjectileBase>> NewSlots;
+    NewSlots.SetNumZeroed(FMath::RoundUpToPowerOfTwo(NewCapacity));
+
+    int32 NewNum = 0;
+    for (int32 Offset = 0; Offset < Span; ++Offset)
+    {
+        if (AProjectileBase* Projectile = GetAtOffset(Offset))
+        {
+            Projectile->RegistrySlot = NewNum;
+            NewSlots[NewNum++] = Projectile;
+        }
+    }
+
+    Slots = MoveTemp(NewSlots);
+    Head = 0;
+    Span = NewNum;
+    Num = NewNum;
+}
+
 void ABaseWeapon::RegisterProjectile(AProjectileBase* Projectile)
 {
-    if (Projectile && !ActiveProjectiles.Contains(Projectile))
+    if (!Projectile || Projectile->RegistrySlot != INDEX_NONE)
+    {
+        return;
+    }
+
+    if (HasAuthority())
     {
-        ActiveProjectiles.Add(Projectile);
-        Projectile->OnDestroyed.AddDynamic(this, &ABaseWeapon::OnProjectileDestroyed);
+        EnforceProjectileLimit();
     }
+
+    Projectile->RegistrySequence = NextProjectileSequence++;
+    ProjectileRegistry.FindOrAdd(Projectile->GetClass()).Add(Projectile);
+    ++NumActiveProjectiles;
 }
 
 void ABaseWeapon::UnregisterProjectile(AProjectileBase* Projectile)
 {
-    if (Projectile)
+    if (!Projectile || Projectile->RegistrySlot == INDEX_NONE)
+    {
+        return;
+    }
+
+    FActiveProjectileRing* Ring = ProjectileRegistry.Find(Projectile->GetClass());
+    if (Ring && Ring->Remove(Projectile))
+    {
+        --NumActiveProjectiles;
+    }
+    Projectile->RegistrySlot = INDEX_NONE;
+}
+
+void ABaseWeapon::EnforceProjectileLimit()
+{
+    const FWeaponStats* Stats = WeaponData ? &WeaponData->WeaponStats : nullptr;
+    if (!Stats || Stats->MaxActiveProjectiles <= 0 || Stats->ActiveProjectileLimitPolicy != EProjectileLimitPolicy::EvictOldest)
+    {
+        return;
+    }
+
+    // The oldest projectile fizzles without exploding; releasing it unregisters it
+    TArray<AProjectileBase*> Oldest;
+    while (NumActiveProjectiles >= Stats->MaxActiveProjectiles)
+    {
+        CollectInSpawnOrder(nullptr, 1, true, Oldest);
+        const int32 NumBefore = NumActiveProjectiles;
+        if (Oldest.Num() > 0)
+        {
+            Oldest[0]->SelfDestruct();
+        }
+        if (NumActiveProjectiles == NumBefore)
+        {
+            break;
+        }
+    }
+}
+
+bool ABaseWeapon::CanFireProjectile() const
+{
+    if (!WeaponData)
+    {
+        return true;
+    }
+
+    const FWeaponStats& Stats = WeaponData->WeaponStats;
+    return Stats.MaxActiveProjectiles <= 0
+        || Stats.ActiveProjectileLimitPolicy != EProjectileLimitPolicy::BlockFire
+        || NumActiveProjectiles < Stats.MaxActiveProjectiles;
+}
+
+TArray<AProjectileBase*> ABaseWeapon::GetActiveProjectiles() const
+{
+    TArray<AProjectileBase*> Result;
+    CollectInSpawnOrder(nullptr, -1, true, Result);
+    return Result;
+}
+
+void ABaseWeapon::GetProjectilesToDetonate(TSubclassOf<AProjectileBase> ProjectileClass, int32 Count, bool bOldestFirst, TArray<AProjectileBase*>& OutProjectiles) const
+{
+    OutProjectiles.Reset();
+    if (ProjectileClass)
     {
-        ActiveProjectiles.Remove(Projectile);
-        Projectile->OnDestroyed.RemoveDynamic(this, &ABaseWeapon::OnProjectileDestroyed);
+        CollectInSpawnOrder(ProjectileClass, Count, bOldestFirst, OutProjectiles);
     }
 }
 
-void ABaseWeapon::OnProjectileDestroyed(AActor* DestroyedActor)
+void ABaseWeapon::CollectInSpawnOrder(TSubclassOf<AProjectileBase> ProjectileClass, int32 Count, bool bOldestFirst, TArray<AProjectileBase*>& OutProjectiles) const
 {
-    if (AProjectileBase* Projectile = Cast<AProjectileBase>(DestroyedActor))
+    OutProjectiles.Reset();
+    if (Count == 0)
     {
-        UnregisterProjectile(Projectile);
+        return;
+    }
+
+    // Usually one ring matches (primary and secondary rarely share a base class)
+    struct FCursor
+    {
+        const FActiveProjectileRing* Ring;
+        int32 Offset;
+    };
+    TArray<FCursor, TInlineAllocator<4>> Cursors;
+    for (const TPair<TSubclassOf<AProjectileBase>, FActiveProjectileRing>& Entry : ProjectileRegistry)
+    {
+        if (Entry.Value.Num > 0 && (!ProjectileClass || Entry.Key->IsChildOf(ProjectileClass)))
+        {
+            Cursors.Add({ &Entry.Value, bOldestFirst ? 0 : Entry.Value.Span - 1 });
+        }
+    }
+
+    const int32 Step = bOldestFirst ? 1 : -1;
+    const int32 MaxCount = Count < 0 ? MAX_int32 : Count;
+
+    while (OutProjectiles.Num() < MaxCount)
+    {
+        // Merge on spawn sequence; each cursor first skips holes
+        AProjectileBase* Next = nullptr;
+        FCursor* NextCursor = nullptr;
+        for (FCursor& Cursor : Cursors)
+        {
+            AProjectileBase* Candidate = nullptr;
+            while (Cursor.Offset >= 0 && Cursor.Offset < Cursor.Ring->Span && !(Candidate = Cursor.Ring->GetAtOffset(Cursor.Offset)))
+            {
+                Cursor.Offset += Step;
+            }
+
+            if (Candidate && (!Next || (bOldestFirst
+                ? Candidate->RegistrySequence < Next->RegistrySequence
+                : Candidate->RegistrySequence > Next->RegistrySequence)))
+            {
+                Next = Candidate;
+                NextCursor = &Cursor;
+            }
+        }
+
+        if (!Next)
+        {
+            break;
+        }
+
+        OutProjectiles.Add(Next);
+        NextCursor->Offset += Step;
+    }
+}
+
+int32 ABaseWeapon::DetonateProjectiles(const FProjectileDetonationRequest& Request)
+{
+    if (!HasAuthority())
+    {
+        return 0;
+    }
+
+    if (Request.PredictionKey.IsValidKey())
+    {
+        const TPair<int16, const UClass*> Handled(Request.PredictionKey.Current, Request.ProjectileClass.Get());
+        if (HandledDetonations.Contains(Handled))
+        {
+            return 0;
+        }
+
+        if (HandledDetonations.Num() < HandledDetonationWindow)
+        {
+            HandledDetonations.Add(Handled);
+        }
+        else
+        {
+            HandledDetonations[NextHandledDetonation] = Handled;
+        }
+        NextHandledDetonation = (NextHandledDetonation + 1) % HandledDetonationWindow;
+    }
+
+    // Validate the explicit list: only live projectiles this weapon actually owns
+    TArray<AProjectileBase*> ToDetonate;
+    const int32 NumListed = FMath::Min(Request.Projectiles.Num(), MaxDetonationsPerRequest);
+    for (int32 i = 0; i < NumListed; ++i)
+    {
+        AProjectileBase* Projectile = Request.Projectiles[i];
+        if (IsValid(Projectile) && Projectile->IsPoolActive() && Projectile->OwningWeapon == this && Projectile->RegistrySlot != INDEX_NONE
+            && (!Request.ProjectileClass || Projectile->IsA(Request.ProjectileClass)))
+        {
+            ToDetonate.AddUnique(Projectile);
+        }
+    }
+
+    // Top up from our own registry when the client's list was short (e.g. actors not yet replicated to it)
+    const int32 WantedCount = Request.Count < 0 ? MaxDetonationsPerRequest : FMath::Min<int32>(Request.Count, MaxDetonationsPerRequest);
+    if (Request.ProjectileClass && ToDetonate.Num() < WantedCount)
+    {
+        TArray<AProjectileBase*> Candidates;
+        GetProjectilesToDetonate(Request.ProjectileClass, -1, Request.bOldestFirst, Candidates);
+        for (AProjectileBase* Candidate : Candidates)
+        {
+            if (ToDetonate.Num() >= WantedCount)
+            {
+                break;
+            }
+            ToDetonate.AddUnique(Candidate);
+        }
+    }
+
+    // Detonations land in the same frame and are merged by the explosion queue
+    for (AProjectileBase* Projectile : ToDetonate)
+    {
+        Projectile->Detonate();
+    }
+
+    return ToDetonate.Num();
+}
+
+void ABaseWeapon::ServerDetonateProjectiles_Implementation(const FProjectileDetonationRequest& Request)
+{
+    DetonateProjectiles(Request);
+}
+
+void ABaseWeapon::QueueClientDetonation(AProjectileBase* Projectile)
+{
+    if (!Projectile)
+    {
+        return;
+    }
+
+    // Inside a predicted ability the request carries its key
+    FPredictionKey PredictionKey;
+    const UAbilitySystemComponent* ASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(GetOwner());
+    if (ASC && ASC->ScopedPredictionKey.IsLocalClientKey())
+    {
+        PredictionKey = ASC->ScopedPredictionKey;
+    }
+
+    const TSubclassOf<AProjectileBase> ProjectileClass = Projectile->GetClass();
+    FProjectileDetonationRequest* Pending = PendingClientDetonations.FindByPredicate([&](const FProjectileDetonationRequest& Request)
+    {
+        return Request.ProjectileClass == ProjectileClass && Request.PredictionKey.Current == PredictionKey.Current;
+    });
+
+    if (!Pending)
+    {
+        if (PendingClientDetonations.Num() == 0)
+        {
+            GetWorldTimerManager().SetTimerForNextTick(this, &ABaseWeapon::FlushClientDetonations);
+        }
+
+        Pending = &PendingClientDetonations.AddDefaulted_GetRef();
+        Pending->ProjectileClass = ProjectileClass;
+        Pending->PredictionKey = PredictionKey;
+    }
+
+    if (Pending->Count >= MaxDetonationsPerRequest || Pending->Projectiles.Contains(Projectile))
+    {
+        return;
+    }
+
+    // Count is the total; local spawn-record proxies can't be resolved by the server, which tops up by class instead
+    ++Pending->Count;
+    if (Projectile->GetIsReplicated())
+    {
+        Pending->Projectiles.Add(Projectile);
+    }
+}
+
+AProjectileBase* ABaseWeapon::SpawnPredictedProjectile(TSubclassOf<AProjectileBase> ProjectileClass, const FTransform& SpawnTransform, FPredictionKey PredictionKey)
+{
+    if (HasAuthority() || !PredictionKey.IsValidKey())
+    {
+        return nullptr;
+    }
+
+    AProjectileBase* Projectile = AProjectileBase::SpawnLocalProjectile(GetWorld(), ProjectileClass, SpawnTransform);
+    if (!Projectile)
+    {
+        return nullptr;
+    }
+
+    // Kept out of the registry until it is adopted: counting it next to the server's projectile would block
+    // or evict on this client when the server doesn't
+    Projectile->InitializeProjectile(nullptr, this, WeaponData, false);
+    if (APawn* OwnerPawn = Cast<APawn>(GetOwner()))
+    {
+        Projectile->CollisionComp->IgnoreActorWhenMoving(OwnerPawn, true);
+        Projectile->SetInstigator(OwnerPawn);
+    }
+
+    FPredictedProjectile& Predicted = PredictedProjectiles.FindOrAdd(PredictionKey.Current);
+    if (AProjectileBase* Previous = Predicted.Projectile.Get())
+    {
+        Previous->Destroy();
+    }
+    Predicted.Projectile = Projectile;
+    Predicted.SpawnTime = GetWorld()->GetTimeSeconds();
+
+    PredictionKey.NewRejectedDelegate().BindUObject(this, &ABaseWeapon::OnPredictedProjectileRejected, PredictionKey.Current);
+
+    if (!GetWorldTimerManager().IsTimerActive(PredictedProjectileTimer))
+    {
+        GetWorldTimerManager().SetTimer(PredictedProjectileTimer, this, &ABaseWeapon::ExpirePredictedProjectiles, PredictedProjectileTimeout, true);
+    }
+
+    return Projectile;
+}
+
+AProjectileBase* ABaseWeapon::TakePredictedProjectile(int16 PredictionKeyId)
+{
+    FPredictedProjectile Predicted;
+    return PredictedProjectiles.RemoveAndCopyValue(PredictionKeyId, Predicted) ? Predicted.Projectile.Get() : nullptr;
+}
+
+void ABaseWeapon::OnPredictedProjectileRejected(int16 PredictionKeyId)
+{
+    // The server refused the shot (cost, cooldown, limit): the rocket never existed
+    if (AProjectileBase* Projectile = TakePredictedProjectile(PredictionKeyId))
+    {
+        Projectile->Destroy();
+    }
+}
+
+void ABaseWeapon::ExpirePredictedProjectiles()
+{
+    const double Now = GetWorld()->GetTimeSeconds();
+    for (auto It = PredictedProjectiles.CreateIterator(); It; ++It)
+    {
+        if (!It->Value.Projectile.IsValid() || Now - It->Value.SpawnTime > PredictedProjectileTimeout)
+        {
+            if (AProjectileBase* Projectile = It->Value.Projectile.Get())
+            {
+                Projectile->Destroy();
+            }
+            It.RemoveCurrent();
+        }
+    }
+
+    if (PredictedProjectiles.Num() == 0)
+    {
+        GetWorldTimerManager().ClearTimer(PredictedProjectileTimer);
+    }
+}
+
+void ABaseWeapon::FlushClientDetonations()
+{
+    for (const FProjectileDetonationRequest& Request : PendingClientDetonations)
+    {
+        if (Request.Count > 0)
+        {
+            ServerDetonateProjectiles(Request);
+        }
     }
+    PendingClientDetonations.Reset();
 }
 
 // Modifier-aware stat getters are REMOVED.
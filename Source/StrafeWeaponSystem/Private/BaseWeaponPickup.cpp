@@ -9,6 +9,8 @@
 #include "WeaponDataAsset.h" // For accessing weapon data during pickup
 #include "AbilitySystemComponent.h" // For applying GEs
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "NetDormancyPolicy.h"
 #include "TimerManager.h"
 #include "Engine/Engine.h" 
 
@@ -17,6 +19,9 @@ ABaseWeaponPickup::ABaseWeaponPickup()
     PrimaryActorTick.bCanEverTick = false;
     bReplicates = true;
 
+    // Only bIsActive ever changes; SetPickupActiveState flushes it
+    NetDormancy = FNetDormancyPolicy::GetInitialDormancy(DORM_Initial);
+
     CollisionSphere = CreateDefaultSubobject<USphereComponent>(TEXT("CollisionSphere"));
     RootComponent = CollisionSphere;
     CollisionSphere->SetSphereRadius(100.0f);
@@ -36,7 +41,10 @@ ABaseWeaponPickup::ABaseWeaponPickup()
 void ABaseWeaponPickup::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
     Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-    DOREPLIFETIME(ABaseWeaponPickup, bIsActive);
+
+    FDoRepLifetimeParams Params;
+    Params.bIsPushBased = true;
+    DOREPLIFETIME_WITH_PARAMS_FAST(ABaseWeaponPickup, bIsActive, Params);
 }
 
 void ABaseWeaponPickup::BeginPlay()
@@ -134,6 +142,8 @@ void ABaseWeaponPickup::ProcessPickup(AStrafeCharacter* PickingCharacter)
     }
 
 
+    // Reopen the channel so the effects multicast isn't dropped for a dormant pickup
+    FNetDormancyPolicy::FlushStateChange(this);
     Multicast_OnPickedUpEffects();
 
     if (bDestroyOnPickup)
@@ -165,7 +175,9 @@ void ABaseWeaponPickup::SetPickupActiveState(bool bNewActiveState)
     if (HasAuthority())
     {
         bIsActive = bNewActiveState;
+        MARK_PROPERTY_DIRTY_FROM_NAME(ABaseWeaponPickup, bIsActive, this);
         OnRep_IsActive();
+        FNetDormancyPolicy::FlushStateChange(this);
     }
 }
 
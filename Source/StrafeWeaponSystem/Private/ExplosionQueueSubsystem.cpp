@@ -0,0 +1,244 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ExplosionQueueSubsystem.h"
+#include "Components/PrimitiveComponent.h"
+#include "GameFramework/Controller.h"
+#include "Engine/World.h"
+
+namespace
+{
+    // Damage one instigator dealt to one actor across the batch
+    struct FBatchedDamage
+    {
+        TWeakObjectPtr<AController> InstigatorController;
+        int32 ExplosionIndex = INDEX_NONE; // Causer/damage type/radii of the strongest contribution
+        float Damage = 0.0f;
+        float StrongestDamage = 0.0f;
+        FHitResult Hit;
+    };
+
+    struct FBatchedTarget
+    {
+        AActor* Actor = nullptr;
+        FVector LaunchVelocity = FVector::ZeroVector;
+        TWeakObjectPtr<UPrimitiveComponent> PhysicsComponent;
+        FVector PhysicsImpulse = FVector::ZeroVector;
+        FVector PhysicsImpulseLocation = FVector::ZeroVector;
+        int32 ImpulseExplosionIndex = INDEX_NONE;
+        TArray<FBatchedDamage, TInlineAllocator<2>> Damage;
+    };
+}
+
+bool UExplosionQueueSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UExplosionQueueSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UExplosionQueueSubsystem, STATGROUP_Tickables);
+}
+
+void UExplosionQueueSubsystem::QueueExplosion(const FExplosionInstance& Explosion)
+{
+    PendingExplosions.Add(Explosion);
+}
+
+void UExplosionQueueSubsystem::Tick(float DeltaTime)
+{
+    FlushExplosions();
+}
+
+void UExplosionQueueSubsystem::FlushExplosions()
+{
+    UWorld* World = GetWorld();
+    if (PendingExplosions.Num() == 0 || !World)
+    {
+        return;
+    }
+
+    if (PendingExplosions.Num() == 1)
+    {
+        // Nothing to merge
+        FExplosionResolver::ResolveExplosion(World, PendingExplosions[0]);
+    }
+    else
+    {
+        ResolveBatch(World);
+    }
+
+    PendingExplosions.Reset();
+}
+
+void UExplosionQueueSubsystem::ResolveBatch(UWorld* World)
+{
+    // Explosions whose spheres touch share a broad phase; one box around the whole batch would span
+    // the map as soon as two fights detonate in the same frame
+    const int32 NumExplosions = PendingExplosions.Num();
+    TArray<int32, TInlineAllocator<16>> ClusterParent;
+    ClusterParent.SetNumUninitialized(NumExplosions);
+    for (int32 Index = 0; Index < NumExplosions; ++Index)
+    {
+        ClusterParent[Index] = Index;
+    }
+
+    auto FindCluster = [&ClusterParent](int32 Index)
+    {
+        while (ClusterParent[Index] != Index)
+        {
+            ClusterParent[Index] = ClusterParent[ClusterParent[Index]];
+            Index = ClusterParent[Index];
+        }
+        return Index;
+    };
+
+    for (int32 A = 0; A < NumExplosions; ++A)
+    {
+        for (int32 B = A + 1; B < NumExplosions; ++B)
+        {
+            const float ReachSum = PendingExplosions[A].Params.OuterRadius + PendingExplosions[B].Params.OuterRadius;
+            if (FVector::DistSquared(PendingExplosions[A].Location, PendingExplosions[B].Location) <= FMath::Square(ReachSum))
+            {
+                ClusterParent[FindCluster(B)] = FindCluster(A);
+            }
+        }
+    }
+
+    TArray<TArray<int32, TInlineAllocator<4>>, TInlineAllocator<8>> Clusters;
+    TMap<int32, int32, TInlineSetAllocator<8>> ClusterByRoot;
+    for (int32 Index = 0; Index < NumExplosions; ++Index)
+    {
+        const int32 Root = FindCluster(Index);
+        int32 ClusterIndex;
+        if (const int32* Found = ClusterByRoot.Find(Root))
+        {
+            ClusterIndex = *Found;
+        }
+        else
+        {
+            ClusterIndex = Clusters.AddDefaulted();
+            ClusterByRoot.Add(Root, ClusterIndex);
+        }
+        Clusters[ClusterIndex].Add(Index);
+    }
+
+    TArray<FBatchedTarget> Targets;
+    TMap<AActor*, int32> TargetByActor;
+    TArray<TPair<AActor*, UPrimitiveComponent*>> Candidates;
+
+    for (const TArray<int32, TInlineAllocator<4>>& Cluster : Clusters)
+    {
+        FBox ClusterBounds(ForceInit);
+        for (const int32 ExplosionIndex : Cluster)
+        {
+            ClusterBounds += FBox::BuildAABB(PendingExplosions[ExplosionIndex].Location, FVector(PendingExplosions[ExplosionIndex].Params.OuterRadius));
+        }
+
+        // Nothing is ignored here: an actor one explosion must skip can still be hit by its neighbour
+        const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ExplosionBatchResolve), false);
+        const FCollisionShape Shape = Cluster.Num() == 1
+            ? FCollisionShape::MakeSphere(PendingExplosions[Cluster[0]].Params.OuterRadius)
+            : FCollisionShape::MakeBox(ClusterBounds.GetExtent());
+        const FVector Center = Cluster.Num() == 1 ? PendingExplosions[Cluster[0]].Location : ClusterBounds.GetCenter();
+        FExplosionResolver::GatherTargets(World, Center, Shape, QueryParams, Candidates);
+
+        for (const TPair<AActor*, UPrimitiveComponent*>& Candidate : Candidates)
+        {
+            FBatchedTarget* Target = nullptr;
+
+            for (const int32 ExplosionIndex : Cluster)
+            {
+                const FExplosionInstance& Explosion = PendingExplosions[ExplosionIndex];
+
+                // Narrow phase per explosion: the cluster gather is conservative and ignores nothing
+                if (Candidate.Key == Explosion.DamageCauser.Get())
+                {
+                    continue;
+                }
+                if (Explosion.Params.bIgnoreOwner && Candidate.Key == Explosion.IgnoredActor.Get())
+                {
+                    continue;
+                }
+                if (Candidate.Value->Bounds.GetBox().ComputeSquaredDistanceToPoint(Explosion.Location) > FMath::Square(Explosion.Params.OuterRadius))
+                {
+                    continue;
+                }
+
+                FExplosionActorEffect Effect;
+                if (!FExplosionResolver::EvaluateTarget(World, Explosion, Candidate.Key, Candidate.Value, Effect))
+                {
+                    continue;
+                }
+
+                if (!Target)
+                {
+                    // Big actors can reach into more than one cluster; they still get one combined result
+                    if (const int32* Existing = TargetByActor.Find(Candidate.Key))
+                    {
+                        Target = &Targets[*Existing];
+                    }
+                    else
+                    {
+                        TargetByActor.Add(Candidate.Key, Targets.Num());
+                        Target = &Targets.AddDefaulted_GetRef();
+                        Target->Actor = Candidate.Key;
+                    }
+                }
+
+                Target->LaunchVelocity += Effect.LaunchVelocity;
+
+                if (Effect.PhysicsComponent.IsValid())
+                {
+                    Target->PhysicsComponent = Effect.PhysicsComponent;
+                    Target->PhysicsImpulse += Effect.PhysicsImpulse;
+                    Target->PhysicsImpulseLocation = Effect.PhysicsImpulseLocation;
+                    Target->ImpulseExplosionIndex = ExplosionIndex;
+                }
+
+                if (Effect.Damage > 0.0f)
+                {
+                    AController* InstigatorController = Explosion.InstigatorController.Get();
+                    FBatchedDamage* Damage = Target->Damage.FindByPredicate(
+                        [InstigatorController](const FBatchedDamage& Entry) { return Entry.InstigatorController.Get() == InstigatorController; });
+                    if (!Damage)
+                    {
+                        Damage = &Target->Damage.AddDefaulted_GetRef();
+                        Damage->InstigatorController = InstigatorController;
+                    }
+
+                    Damage->Damage += Effect.Damage;
+                    if (Effect.Damage > Damage->StrongestDamage)
+                    {
+                        Damage->StrongestDamage = Effect.Damage;
+                        Damage->ExplosionIndex = ExplosionIndex;
+                        Damage->Hit = Effect.DamageHit;
+                    }
+                }
+            }
+        }
+    }
+
+    for (const FBatchedTarget& Target : Targets)
+    {
+        // One damage event per instigator, carrying the summed amount
+        for (const FBatchedDamage& Damage : Target.Damage)
+        {
+            FExplosionActorEffect DamageEffect;
+            DamageEffect.Actor = Target.Actor;
+            DamageEffect.Damage = Damage.Damage;
+            DamageEffect.DamageHit = Damage.Hit;
+            FExplosionResolver::ApplyEffect(DamageEffect, PendingExplosions[Damage.ExplosionIndex]);
+        }
+
+        // One launch / impulse with the combined, capped result
+        FExplosionActorEffect ImpulseEffect;
+        ImpulseEffect.Actor = Target.Actor;
+        ImpulseEffect.LaunchVelocity = Target.LaunchVelocity.GetClampedToMaxSize(MaxCombinedLaunchSpeed);
+        ImpulseEffect.PhysicsComponent = Target.PhysicsComponent;
+        ImpulseEffect.PhysicsImpulse = Target.PhysicsImpulse.GetClampedToMaxSize(MaxCombinedPhysicsImpulse);
+        ImpulseEffect.PhysicsImpulseLocation = Target.PhysicsImpulseLocation;
+
+        const int32 ImpulseExplosionIndex = Target.ImpulseExplosionIndex != INDEX_NONE ? Target.ImpulseExplosionIndex : 0;
+        FExplosionResolver::ApplyEffect(ImpulseEffect, PendingExplosions[ImpulseExplosionIndex]);
+    }
+}
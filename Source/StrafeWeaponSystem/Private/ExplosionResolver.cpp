@@ -0,0 +1,180 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ExplosionResolver.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/DamageType.h"
+#include "GameFramework/Controller.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "Engine/OverlapResult.h"
+#include "Engine/DamageEvents.h"
+#include "CollisionQueryParams.h"
+
+void FExplosionResolver::ResolveExplosion(UWorld* World, const FExplosionInstance& Explosion)
+{
+    if (!World)
+    {
+        return;
+    }
+
+    TArray<TPair<AActor*, UPrimitiveComponent*>> Targets;
+    GatherTargets(World, Explosion.Location, FCollisionShape::MakeSphere(Explosion.Params.OuterRadius), MakeQueryParams(Explosion), Targets);
+
+    for (const TPair<AActor*, UPrimitiveComponent*>& Target : Targets)
+    {
+        FExplosionActorEffect Effect;
+        if (EvaluateTarget(World, Explosion, Target.Key, Target.Value, Effect))
+        {
+            ApplyEffect(Effect, Explosion);
+        }
+    }
+}
+
+FCollisionQueryParams FExplosionResolver::MakeQueryParams(const FExplosionInstance& Explosion)
+{
+    FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ExplosionResolve), false, Explosion.DamageCauser.Get());
+    if (Explosion.Params.bIgnoreOwner && Explosion.IgnoredActor.IsValid())
+    {
+        QueryParams.AddIgnoredActor(Explosion.IgnoredActor.Get());
+    }
+    return QueryParams;
+}
+
+void FExplosionResolver::GatherTargets(UWorld* World, const FVector& Center, const FCollisionShape& Shape,
+    const FCollisionQueryParams& QueryParams, TArray<TPair<AActor*, UPrimitiveComponent*>>& OutTargets)
+{
+    OutTargets.Reset();
+
+    TArray<FOverlapResult> Overlaps;
+    World->OverlapMultiByObjectType(
+        Overlaps,
+        Center,
+        FQuat::Identity,
+        FCollisionObjectQueryParams(FCollisionObjectQueryParams::InitType::AllDynamicObjects),
+        Shape,
+        QueryParams
+    );
+
+    for (const FOverlapResult& Overlap : Overlaps)
+    {
+        AActor* Actor = Overlap.GetActor();
+        UPrimitiveComponent* Component = Overlap.GetComponent();
+        if (!Actor || !Component)
+        {
+            continue;
+        }
+
+        TPair<AActor*, UPrimitiveComponent*>* Existing = OutTargets.FindByPredicate(
+            [Actor](const TPair<AActor*, UPrimitiveComponent*>& Target) { return Target.Key == Actor; });
+
+        if (!Existing)
+        {
+            OutTargets.Emplace(Actor, Component);
+        }
+        else if (Component == Actor->GetRootComponent())
+        {
+            // Prefer the root (capsule for characters) for the line-of-sight test
+            Existing->Value = Component;
+        }
+    }
+}
+
+bool FExplosionResolver::EvaluateTarget(UWorld* World, const FExplosionInstance& Explosion, AActor* Actor,
+    UPrimitiveComponent* Component, FExplosionActorEffect& OutEffect)
+{
+    const FExplosionParams& Params = Explosion.Params;
+    const FVector ActorLocation = Actor->GetActorLocation();
+    const float Distance = FVector::Dist(Explosion.Location, ActorLocation);
+    const float RadiusRange = FMath::Max(Params.OuterRadius - Params.InnerRadius, KINDA_SMALL_NUMBER);
+    const bool bIsSelf = Explosion.SelfActor.IsValid() && Actor == Explosion.SelfActor.Get();
+
+    OutEffect.Actor = Actor;
+
+    // Damage: one visibility trace toward the component, same rule as the engine's radial damage
+    FHitResult LineOfSightHit;
+    FCollisionQueryParams TraceParams = MakeQueryParams(Explosion);
+    const FVector TraceEnd = Component->Bounds.Origin;
+    const bool bBlocked = World->LineTraceSingleByChannel(LineOfSightHit, Explosion.Location, TraceEnd, ECC_Visibility, TraceParams)
+        && LineOfSightHit.Component.Get() != Component;
+
+    if (!bBlocked)
+    {
+        if (!LineOfSightHit.bBlockingHit)
+        {
+            // Nothing in the way and the component didn't block visibility either; fake a hit at its center
+            const FVector FakeNormal = (Explosion.Location - TraceEnd).GetSafeNormal();
+            LineOfSightHit = FHitResult(Actor, Component, TraceEnd, FakeNormal);
+        }
+
+        const float HitDistance = FVector::Dist(Explosion.Location, LineOfSightHit.ImpactPoint);
+        const float DamageAlpha = HitDistance <= Params.InnerRadius
+            ? 1.0f
+            : FMath::Pow(FMath::Clamp(1.0f - (HitDistance - Params.InnerRadius) / RadiusRange, 0.0f, 1.0f), Params.DamageFalloff);
+
+        OutEffect.Damage = FMath::Lerp(Params.MinimumDamage, Params.BaseDamage, DamageAlpha) * (bIsSelf ? Params.SelfDamageMultiplier : 1.0f);
+        OutEffect.DamageHit = LineOfSightHit;
+    }
+
+    // Impulse: falloff from the actor origin so rocket jumps don't depend on which component overlapped
+    const float Alpha = FMath::Clamp((Params.OuterRadius - Distance) / RadiusRange, 0.0f, 1.0f);
+    const float FalloffMultiplier = FMath::Pow(Alpha, Params.DamageFalloff);
+
+    if (ACharacter* Character = Cast<ACharacter>(Actor))
+    {
+        if (Character->GetCharacterMovement())
+        {
+            FVector LaunchDirection = (ActorLocation - Explosion.Location).GetSafeNormal();
+            LaunchDirection.Z = FMath::Abs(LaunchDirection.Z) + 0.3f; // Add upward bias for better jumping
+            LaunchDirection.Normalize();
+
+            const float LaunchMultiplier = bIsSelf ? Params.SelfImpulseMultiplier : 1.0f;
+            OutEffect.LaunchVelocity = LaunchDirection * Params.ImpulseStrength * FalloffMultiplier * LaunchMultiplier;
+        }
+    }
+    else if (UPrimitiveComponent* RootPrim = Cast<UPrimitiveComponent>(Actor->GetRootComponent()))
+    {
+        if (RootPrim->IsSimulatingPhysics())
+        {
+            OutEffect.PhysicsComponent = RootPrim;
+            OutEffect.PhysicsImpulse = (ActorLocation - Explosion.Location).GetSafeNormal() * Params.ImpulseStrength * FalloffMultiplier;
+            OutEffect.PhysicsImpulseLocation = Explosion.Location;
+        }
+    }
+
+    return OutEffect.Damage > 0.0f || !OutEffect.LaunchVelocity.IsNearlyZero() || OutEffect.PhysicsComponent.IsValid();
+}
+
+void FExplosionResolver::ApplyEffect(const FExplosionActorEffect& Effect, const FExplosionInstance& Explosion)
+{
+    AActor* Actor = Effect.Actor.Get();
+    if (!Actor)
+    {
+        return;
+    }
+
+    if (Effect.Damage > 0.0f)
+    {
+        // Min == Base so the receiver's radial scaling reproduces exactly the damage computed here
+        FRadialDamageEvent DamageEvent;
+        DamageEvent.DamageTypeClass = Explosion.DamageTypeClass ? Explosion.DamageTypeClass : TSubclassOf<UDamageType>(UDamageType::StaticClass());
+        DamageEvent.Origin = Explosion.Location;
+        DamageEvent.Params = FRadialDamageParams(Effect.Damage, Effect.Damage, Explosion.Params.InnerRadius, Explosion.Params.OuterRadius, Explosion.Params.DamageFalloff);
+        DamageEvent.ComponentHits.Add(Effect.DamageHit);
+
+        Actor->TakeDamage(Effect.Damage, DamageEvent, Explosion.InstigatorController.Get(), Explosion.GetDamageCauser());
+    }
+
+    if (!Effect.LaunchVelocity.IsNearlyZero())
+    {
+        if (ACharacter* Character = Cast<ACharacter>(Actor))
+        {
+            Character->LaunchCharacter(Effect.LaunchVelocity, true, true);
+        }
+    }
+
+    if (UPrimitiveComponent* PhysicsComponent = Effect.PhysicsComponent.Get())
+    {
+        PhysicsComponent->AddImpulseAtLocation(Effect.PhysicsImpulse, Effect.PhysicsImpulseLocation);
+    }
+}
@@ -3,11 +3,14 @@
 #include "BaseWeapon.h"
 #include "ProjectileBase.h"
 #include "WeaponInventoryComponent.h"
+#include "AbilitySystemComponent.h"
+#include "Abilities/GameplayAbilityTargetTypes.h"
 
 UGA_DetonateProjectiles::UGA_DetonateProjectiles()
 {
     InstancingPolicy = EGameplayAbilityInstancingPolicy::InstancedPerActor;
     NetExecutionPolicy = EGameplayAbilityNetExecutionPolicy::LocalPredicted;
+    bRequiresAmmo = false; // Detonating what's already out works on an empty weapon
 }
 
 bool UGA_DetonateProjectiles::CanActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayTagContainer* SourceTags, const FGameplayTagContainer* TargetTags, OUT FGameplayTagContainer* OptionalRelevantTags) const
@@ -18,27 +21,16 @@ bool UGA_DetonateProjectiles::CanActivateAbility(const FGameplayAbilitySpecHandl
     }
 
     ABaseWeapon* Weapon = GetEquippedWeaponFromActorInfo();
-    if (!Weapon || Weapon->GetActiveProjectiles().Num() == 0)
-    {
-        return false;
-    }
-
-    // Check if we have any projectiles of the correct type
     TSubclassOf<AProjectileBase> ProjectileClass = GetProjectileClassToDetonate();
-    if (!ProjectileClass)
+    if (!Weapon || !ProjectileClass)
     {
         return false;
     }
 
-    for (AProjectileBase* Projectile : Weapon->GetActiveProjectiles())
-    {
-        if (Projectile && Projectile->IsA(ProjectileClass))
-        {
-            return true;
-        }
-    }
-
-    return false;
+    // Check if we have any projectiles of the correct type
+    TArray<AProjectileBase*> Candidates;
+    Weapon->GetProjectilesToDetonate(ProjectileClass, 1, bDetonateOldestFirst, Candidates);
+    return Candidates.Num() > 0;
 }
 
 void UGA_DetonateProjectiles::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData)
@@ -65,46 +57,95 @@ void UGA_DetonateProjectiles::ActivateAbility(const FGameplayAbilitySpecHandle H
         return;
     }
 
-    // Get projectiles of the correct type
-    TArray<AProjectileBase*> ProjectilesToProcess;
-    for (AProjectileBase* Projectile : Weapon->GetActiveProjectiles())
+    UAbilitySystemComponent* ASC = ActorInfo->AbilitySystemComponent.Get();
+    if (!ActorInfo->IsLocallyControlled())
     {
-        if (Projectile && Projectile->IsA(ProjectileClass))
-        {
-            ProjectilesToProcess.Add(Projectile);
-        }
+        // A remote client's activation the server accepted; the detonation waits for the client's selection
+        ASC->AbilityTargetDataSetDelegate(Handle, ActivationInfo.GetActivationPredictionKey()).AddUObject(this, &UGA_DetonateProjectiles::OnDetonationTargetData);
+        ASC->CallReplicatedTargetDataDelegatesIfSet(Handle, ActivationInfo.GetActivationPredictionKey());
+        return;
     }
 
-    // Sort by creation time if needed
-    if (bDetonateOldestFirst)
+    int32 NumDetonated = 0;
+    if (ActorInfo->IsNetAuthority())
     {
-        ProjectilesToProcess.Sort([](const AProjectileBase& A, const AProjectileBase& B)
-            {
-                return A.GetGameTimeSinceCreation() > B.GetGameTimeSinceCreation();
-            });
+        NumDetonated = Weapon->DetonateProjectiles(MakeDetonationRequest());
     }
     else
     {
-        ProjectilesToProcess.Sort([](const AProjectileBase& A, const AProjectileBase& B)
+        // The selection rides along with this activation, one reliable RPC on the same channel as the activation itself
+        TArray<AProjectileBase*> Selected;
+        Weapon->GetProjectilesToDetonate(ProjectileClass, ProjectilesToDetonate, bDetonateOldestFirst, Selected);
+
+        FGameplayAbilityTargetData_ActorArray* Selection = new FGameplayAbilityTargetData_ActorArray();
+        for (AProjectileBase* Projectile : Selected)
+        {
+            // Spawn-record proxies are local actors; the server picks those by class and count
+            if (Projectile->GetIsReplicated())
             {
-                return A.GetGameTimeSinceCreation() < B.GetGameTimeSinceCreation();
-            });
+                Selection->TargetActorArray.Add(Projectile);
+            }
+        }
+        NumDetonated = Selected.Num();
+
+        ASC->ServerSetReplicatedTargetData(Handle, ActivationInfo.GetActivationPredictionKey(), FGameplayAbilityTargetDataHandle(Selection), FGameplayTag(), ASC->ScopedPredictionKey);
     }
 
-    // Detonate projectiles
-    int32 NumToDetonate = ProjectilesToDetonate < 0 ? ProjectilesToProcess.Num() : FMath::Min(ProjectilesToDetonate, ProjectilesToProcess.Num());
-    int32 NumDetonated = 0;
+    K2_OnProjectilesDetonated(NumDetonated);
 
-    for (int32 i = 0; i < NumToDetonate; i++)
+    EndAbility(Handle, ActorInfo, ActivationInfo, true, false);
+}
+
+void UGA_DetonateProjectiles::OnDetonationTargetData(const FGameplayAbilityTargetDataHandle& Data, FGameplayTag ApplicationTag)
+{
+    UAbilitySystemComponent* ASC = GetAbilitySystemComponentFromActorInfo();
+    if (!ASC)
     {
-        if (ProjectilesToProcess[i])
+        return;
+    }
+    ASC->ConsumeClientReplicatedTargetData(CurrentSpecHandle, CurrentActivationInfo.GetActivationPredictionKey());
+
+    FProjectileDetonationRequest Request = MakeDetonationRequest();
+    for (int32 Index = 0; Index < Data.Num(); ++Index)
+    {
+        if (const FGameplayAbilityTargetData* Entry = Data.Get(Index))
         {
-            ProjectilesToProcess[i]->Detonate();
-            NumDetonated++;
+            for (const TWeakObjectPtr<AActor>& Actor : Entry->GetActors())
+            {
+                if (AProjectileBase* Projectile = Cast<AProjectileBase>(Actor.Get()))
+                {
+                    Request.Projectiles.Add(Projectile);
+                }
+            }
         }
     }
 
-    K2_OnProjectilesDetonated(NumDetonated);
+    // DetonateProjectiles still checks that every listed projectile is ours, live and of the class
+    ABaseWeapon* Weapon = GetEquippedWeaponFromActorInfo();
+    K2_OnProjectilesDetonated(Weapon ? Weapon->DetonateProjectiles(Request) : 0);
 
-    EndAbility(Handle, ActorInfo, ActivationInfo, true, false);
-}
\ No newline at end of file
+    EndAbility(CurrentSpecHandle, CurrentActorInfo, CurrentActivationInfo, true, false);
+}
+
+void UGA_DetonateProjectiles::EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled)
+{
+    UAbilitySystemComponent* ASC = ActorInfo ? ActorInfo->AbilitySystemComponent.Get() : nullptr;
+    if (ASC && ActorInfo->IsNetAuthority() && !ActorInfo->IsLocallyControlled())
+    {
+        // Ended before the selection arrived (cancelled): nothing may detonate for this activation any more
+        ASC->AbilityTargetDataSetDelegate(Handle, ActivationInfo.GetActivationPredictionKey()).RemoveAll(this);
+        ASC->ConsumeAllReplicatedData(Handle, ActivationInfo.GetActivationPredictionKey());
+    }
+
+    Super::EndAbility(Handle, ActorInfo, ActivationInfo, bReplicateEndAbility, bWasCancelled);
+}
+
+FProjectileDetonationRequest UGA_DetonateProjectiles::MakeDetonationRequest() const
+{
+    FProjectileDetonationRequest Request;
+    Request.ProjectileClass = GetProjectileClassToDetonate();
+    Request.Count = static_cast<int16>(FMath::Clamp(ProjectilesToDetonate, -1, static_cast<int32>(TNumericLimits<int16>::Max())));
+    Request.bOldestFirst = bDetonateOldestFirst;
+    Request.PredictionKey = GetCurrentActivationInfo().GetActivationPredictionKey();
+    return Request;
+}
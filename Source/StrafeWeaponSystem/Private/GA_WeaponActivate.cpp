@@ -1,6 +1,30 @@
 #include "GA_WeaponActivate.h"
 #include "StrafeCharacter.h" // For GetStrafeCharacterFromActorInfo
 #include "BaseWeapon.h"      // For GetEquippedWeaponFromActorInfo
+#include "WeaponDataAsset.h"
+#include "Weapons/PelletSpread.h"
+#include "AmmoComponent.h"
+#include "AmmoCostExecution.h"
+#include "StrafeGameplayTags.h"
+#include "AbilitySystemComponent.h"
+#include "GameplayEffect.h"
+
+namespace
+{
+	// The weapon the spec was granted for, or the equipped one for abilities granted without a source weapon
+	const ABaseWeapon* FindAbilityWeapon(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo)
+	{
+		const UAbilitySystemComponent* ASC = ActorInfo ? ActorInfo->AbilitySystemComponent.Get() : nullptr;
+		const FGameplayAbilitySpec* Spec = ASC ? ASC->FindAbilitySpecFromHandle(Handle) : nullptr;
+		if (const ABaseWeapon* SourceWeapon = Spec ? Cast<ABaseWeapon>(Spec->SourceObject.Get()) : nullptr)
+		{
+			return SourceWeapon;
+		}
+
+		const AStrafeCharacter* Character = ActorInfo ? Cast<AStrafeCharacter>(ActorInfo->AvatarActor.Get()) : nullptr;
+		return Character ? Character->GetCurrentWeapon() : nullptr;
+	}
+}
 
 UGA_WeaponActivate::UGA_WeaponActivate()
 {
@@ -9,6 +33,108 @@ UGA_WeaponActivate::UGA_WeaponActivate()
 	NetExecutionPolicy = EGameplayAbilityNetExecutionPolicy::LocalPredicted; // Good for responsive firing
 }
 
+bool UGA_WeaponActivate::CanActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayTagContainer* SourceTags, const FGameplayTagContainer* TargetTags, OUT FGameplayTagContainer* OptionalRelevantTags) const
+{
+	if (!Super::CanActivateAbility(Handle, ActorInfo, SourceTags, TargetTags, OptionalRelevantTags))
+	{
+		return false;
+	}
+
+	// Weapon abilities are granted with their weapon as source object and stay granted while it's holstered
+	UAbilitySystemComponent* ASC = ActorInfo ? ActorInfo->AbilitySystemComponent.Get() : nullptr;
+	const FGameplayAbilitySpec* Spec = ASC ? ASC->FindAbilitySpecFromHandle(Handle) : nullptr;
+	const ABaseWeapon* SourceWeapon = Spec ? Cast<ABaseWeapon>(Spec->SourceObject.Get()) : nullptr;
+	if (!SourceWeapon)
+	{
+		return true;
+	}
+
+	const UWeaponDataAsset* WeaponData = SourceWeapon->GetWeaponData();
+	if (WeaponData && WeaponData->EquippedTag.IsValid())
+	{
+		if (!ASC->HasMatchingGameplayTag(WeaponData->EquippedTag))
+		{
+			if (OptionalRelevantTags)
+			{
+				OptionalRelevantTags->AddTag(WeaponData->EquippedTag);
+			}
+			return false;
+		}
+		return true;
+	}
+
+	const AStrafeCharacter* Character = Cast<AStrafeCharacter>(ActorInfo->AvatarActor.Get());
+	return Character && Character->GetCurrentWeapon() == SourceWeapon;
+}
+
+bool UGA_WeaponActivate::CheckCost(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, OUT FGameplayTagContainer* OptionalRelevantTags) const
+{
+	if (!Super::CheckCost(Handle, ActorInfo, OptionalRelevantTags))
+	{
+		return false;
+	}
+
+	// Tag-keyed ammo isn't an attribute the cost effect could check, and on the owning client the
+	// server's spends of the last few shots haven't replicated yet; GetAmmo accounts for both
+	const ABaseWeapon* Weapon = bRequiresAmmo ? FindAbilityWeapon(Handle, ActorInfo) : nullptr;
+	const UWeaponDataAsset* WeaponData = Weapon ? Weapon->GetWeaponData() : nullptr;
+	if (!WeaponData || !WeaponData->UsesAmmo())
+	{
+		return true;
+	}
+
+	float CurrentAmmo = 0.0f;
+	float MaxAmmo = 0.0f;
+	if (WeaponData->GetAmmo(ActorInfo->AbilitySystemComponent.Get(), CurrentAmmo, MaxAmmo) && CurrentAmmo < 1.0f)
+	{
+		if (OptionalRelevantTags)
+		{
+			OptionalRelevantTags->AddTag(StrafeGameplayTags::Ability_Feedback_OutOfAmmo);
+		}
+		return false;
+	}
+	return true;
+}
+
+void UGA_WeaponActivate::ApplyCost(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo) const
+{
+	Super::ApplyCost(Handle, ActorInfo, ActivationInfo);
+	PredictAmmoSpend(GetCostGameplayEffect(), Handle, ActorInfo);
+}
+
+void UGA_WeaponActivate::PredictAmmoSpend(const UGameplayEffect* CostEffect, const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo) const
+{
+	UAbilitySystemComponent* ASC = ActorInfo ? ActorInfo->AbilitySystemComponent.Get() : nullptr;
+	if (!ASC || !CostEffect || ActorInfo->IsNetAuthority())
+	{
+		return;
+	}
+
+	// Only a spend inside a prediction window can be reconciled; outside one the server's count is all there is
+	const FPredictionKey PredictionKey = ASC->ScopedPredictionKey;
+	if (!PredictionKey.IsLocalClientKey())
+	{
+		return;
+	}
+
+	const bool bSpendsAmmo = CostEffect->Executions.ContainsByPredicate([](const FGameplayEffectExecutionDefinition& Execution)
+	{
+		return Execution.CalculationClass && Execution.CalculationClass->IsChildOf<UAmmoCostExecution>();
+	});
+	if (!bSpendsAmmo)
+	{
+		return;
+	}
+
+	const ABaseWeapon* Weapon = FindAbilityWeapon(Handle, ActorInfo);
+	const FGameplayTag AmmoType = UAmmoCostExecution::ResolveAmmoType(CostEffect->GetAssetTags(), Weapon ? Weapon->GetWeaponData() : nullptr);
+	if (UAmmoComponent* AmmoComponent = AmmoType.IsValid() ? UAmmoComponent::FindAmmoComponent(ActorInfo->AvatarActor.Get()) : nullptr)
+	{
+		// The execution's default amount; callers that set SetByCaller.AmmoCost aren't predicted
+		AmmoComponent->PredictSpend(AmmoType, 1, PredictionKey);
+	}
+}
+
 ABaseWeapon* UGA_WeaponActivate::GetEquippedWeaponFromActorInfo() const
 {
 	AStrafeCharacter* Character = GetStrafeCharacterFromActorInfo();
@@ -22,4 +148,21 @@ ABaseWeapon* UGA_WeaponActivate::GetEquippedWeaponFromActorInfo() const
 AStrafeCharacter* UGA_WeaponActivate::GetStrafeCharacterFromActorInfo() const
 {
 	return Cast<AStrafeCharacter>(GetAvatarActorFromActorInfo());
-}
\ No newline at end of file
+}
+
+int32 UGA_WeaponActivate::NextSpreadSeed()
+{
+	const FPredictionKey& ActivationKey = GetCurrentActivationInfo().GetActivationPredictionKey();
+	if (!ActivationKey.IsValidKey())
+	{
+		// Nobody predicted this activation, so there's nothing to match
+		return FMath::Rand();
+	}
+
+	if (ActivationKey.Current != SpreadSeedPredictionKey)
+	{
+		SpreadSeedPredictionKey = ActivationKey.Current;
+		SpreadShotIndex = 0;
+	}
+	return FPelletSpread::MakeSeed(ActivationKey.Current, SpreadShotIndex++);
+}
@@ -3,7 +3,9 @@
 #include "BaseWeapon.h"
 #include "WeaponDataAsset.h"
 #include "ProjectileBase.h"
-#include "StrafeAttributeSet.h" // For checking ammo
+#include "ProjectilePoolSubsystem.h"
+#include "WeaponAimSubsystem.h"
+#include "StrafeGameplayTags.h"
 #include "AbilitySystemComponent.h"
 #include "AbilitySystemBlueprintLibrary.h" // For GetAbilitySystemComponent
 #include "Kismet/GameplayStatics.h" // For sound and effect spawning (can be moved to GameplayCues)
@@ -17,10 +19,10 @@ UGA_WeaponFire::UGA_WeaponFire()
 {
 	// This tag will be used to identify this ability (e.g., for input binding)
 	// It's often good practice to assign this in the Blueprint derivative though.
-	// AbilityTags.AddTag(FGameplayTag::RequestGameplayTag(FName("Ability.Weapon.PrimaryFire")));
+	// AbilityTags.AddTag(StrafeGameplayTags::Ability_Weapon_PrimaryFire);
 
-	// ActivationBlockedTags.AddTag(FGameplayTag::RequestGameplayTag(FName("State.Dead")));
-	// ActivationBlockedTags.AddTag(FGameplayTag::RequestGameplayTag(FName("State.Stunned")));
+	// ActivationBlockedTags.AddTag(StrafeGameplayTags::State_Dead);
+	// ActivationBlockedTags.AddTag(StrafeGameplayTags::State_Stunned);
 }
 
 bool UGA_WeaponFire::CanActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayTagContainer* SourceTags, const FGameplayTagContainer* TargetTags, OUT FGameplayTagContainer* OptionalRelevantTags) const
@@ -50,24 +52,26 @@ bool UGA_WeaponFire::CanActivateAbility(const FGameplayAbilitySpecHandle Handle,
 		return false;
 	}
 
-	// Check Ammo Attribute
-	// const UStrafeAttributeSet* Attributes = Character->GetAttributeSet(); // Use getter if AttributeSet is private/protected
-	const UStrafeAttributeSet* Attributes = Character->AttributeSet.Get(); // Direct access if public
+	if (!Weapon->CanFireProjectile())
+	{
+		return false;
+	}
 
-	if (Attributes && WeaponData->AmmoAttribute.IsValid())
+	// Check Ammo (tag-keyed ammo component, or the ammo attribute for older assets)
+	if (WeaponData->UsesAmmo())
 	{
-		// Use ASC to get attribute value
-		float CurrentAmmo = ActorInfo->AbilitySystemComponent->GetNumericAttribute(WeaponData->AmmoAttribute); // <<<<<<< CORRECTED
+		float CurrentAmmo = 0.0f;
+		float MaxAmmo = 0.0f;
+		if (!WeaponData->GetAmmo(ActorInfo->AbilitySystemComponent.Get(), CurrentAmmo, MaxAmmo))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("UGA_WeaponFire::CanActivateAbility: Character %s has nowhere to read ammo from for weapon %s."), *Character->GetName(), *Weapon->GetName());
+			return false;
+		}
 		if (CurrentAmmo <= 0)
 		{
 			return false;
 		}
 	}
-	else if (WeaponData->AmmoAttribute.IsValid())
-	{
-		UE_LOG(LogTemp, Warning, TEXT("UGA_WeaponFire::CanActivateAbility: AttributeSet is null on character %s but weapon %s expects ammo attribute %s."), *Character->GetName(), *Weapon->GetName(), *WeaponData->AmmoAttribute.GetName());
-		return false;
-	}
 	return true;
 }
 
@@ -104,44 +108,26 @@ void UGA_WeaponFire::ActivateAbility(const FGameplayAbilitySpecHandle Handle, co
         MuzzleRotation = WeaponMesh->GetSocketRotation(LocalWeaponData->MuzzleFlashSocketName);
     }
 
-    // Use character's aim direction
-    if (AController* Controller = Character->GetController())
+    // Use character's aim direction; the aim is shared with the HUD and traced at most once per frame
+    UWeaponAimSubsystem* AimSubsystem = GetWorld()->GetSubsystem<UWeaponAimSubsystem>();
+    AController* Controller = Character->GetController();
+    if (AimSubsystem && Controller)
     {
-        MuzzleRotation = Controller->GetControlRotation();
-
-        FVector CameraLocation;
-        FRotator CameraRotation;
-        Controller->GetPlayerViewPoint(CameraLocation, CameraRotation);
+        const FWeaponAimResult Aim = AimSubsystem->GetAim(Controller);
 
-        FVector AimDirection = MuzzleRotation.Vector();
-        FVector TraceStart = CameraLocation;
-        FVector TraceEnd = TraceStart + (AimDirection * 10000.0f);
+        MuzzleRotation = Aim.ViewRotation;
+        MuzzleLocation = Aim.ViewLocation + Aim.AimDirection * 150.0f;
 
-        FHitResult HitResult;
-        FCollisionQueryParams QueryParams;
-        QueryParams.AddIgnoredActor(Weapon);
-        QueryParams.AddIgnoredActor(Character);
-
-        bool bHit = GetWorld()->LineTraceSingleByChannel(
-            HitResult,
-            TraceStart,
-            TraceEnd,
-            ECC_Visibility,
-            QueryParams
-        );
-
-        MuzzleLocation = TraceStart + AimDirection * 150.0f;
-
-        if (bHit && HitResult.GetActor() != Character && HitResult.GetActor() != Weapon)
+        if (Aim.bAimTraceHit)
         {
-            MuzzleRotation = (HitResult.ImpactPoint - MuzzleLocation).Rotation();
+            MuzzleRotation = (Aim.AimPoint - MuzzleLocation).Rotation();
         }
 
 #if WITH_EDITOR
         if (GetWorld()->GetNetMode() != NM_DedicatedServer)
         {
             DrawDebugLine(GetWorld(), MuzzleLocation, MuzzleLocation + MuzzleRotation.Vector() * 1000.0f, FColor::Green, false, 1.0f, 0, 1.0f);
-            if (bHit) DrawDebugSphere(GetWorld(), HitResult.ImpactPoint, 15.f, 12, FColor::Red, false, 1.f, 0, 1.f);
+            if (Aim.bAimTraceHit) DrawDebugSphere(GetWorld(), Aim.AimPoint, 15.f, 12, FColor::Red, false, 1.f, 0, 1.f);
         }
 #endif
     }
@@ -193,25 +179,41 @@ void UGA_WeaponFire::SpawnProjectile_Implementation(ABaseWeapon* Weapon, const F
 	if (!Weapon || !Weapon->GetWeaponData() || !Weapon->GetWeaponData()->WeaponStats.PrimaryProjectileClass) return;
 
 	const UWeaponDataAsset* WeaponData = Weapon->GetWeaponData();
+	const FPredictionKey PredictionKey = GetCurrentActivationInfo().GetActivationPredictionKey();
+
+	// Clients only show a predicted stand-in; the real projectile comes from the server's pool
+	if (!Weapon->HasAuthority())
+	{
+		if (IsLocallyControlled())
+		{
+			Weapon->SpawnPredictedProjectile(WeaponData->WeaponStats.PrimaryProjectileClass, FTransform(SpawnRotation, SpawnLocation), PredictionKey);
+		}
+		return;
+	}
+
 	UWorld* World = GetWorld();
 	if (!World) return;
 
-	FActorSpawnParameters SpawnParams;
-	SpawnParams.Owner = Weapon->GetOwner();
-	SpawnParams.Instigator = Cast<APawn>(Weapon->GetOwner());
-	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	UProjectilePoolSubsystem* ProjectilePool = World->GetSubsystem<UProjectilePoolSubsystem>();
+	if (!ProjectilePool) return;
+
+	AActor* WeaponOwner = Weapon->GetOwner();
+	AController* InstigatorController = WeaponOwner ? WeaponOwner->GetInstigatorController() : nullptr;
 
-	AProjectileBase* Projectile = World->SpawnActor<AProjectileBase>(
+	// Pool acquisition runs the reset/activate path, which replaces SpawnActor + InitializeProjectile
+	AProjectileBase* Projectile = ProjectilePool->AcquireProjectile(
 		WeaponData->WeaponStats.PrimaryProjectileClass,
-		SpawnLocation,
-		SpawnRotation,
-		SpawnParams
+		FTransform(SpawnRotation, SpawnLocation),
+		WeaponOwner,
+		Cast<APawn>(WeaponOwner),
+		InstigatorController,
+		Weapon,
+		WeaponData,
+		PredictionKey.Current
 	);
 
 	if (Projectile)
 	{
-		// Pass WeaponData to projectile
-		Projectile->InitializeProjectile(Cast<AController>(Weapon->GetOwner()->GetInstigatorController()), Weapon, WeaponData);
-		UE_LOG(LogTemp, Log, TEXT("UGA_WeaponFire: Projectile %s spawned by %s"), *Projectile->GetName(), *GetNameSafe(Weapon->GetOwner()));
+		UE_LOG(LogTemp, Log, TEXT("UGA_WeaponFire: Projectile %s spawned by %s"), *Projectile->GetName(), *GetNameSafe(WeaponOwner));
 	}
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "GameModes/ArenaGameState.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 
 AArenaGameState::AArenaGameState()
 {
@@ -15,8 +16,11 @@ void AArenaGameState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutL
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(AArenaGameState, TimeRemaining);
-	DOREPLIFETIME(AArenaGameState, MatchState);
+	// Push model: only SetTimeRemaining and SetMatchState change these
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(AArenaGameState, TimeRemaining, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(AArenaGameState, MatchState, Params);
 }
 
 void AArenaGameState::SetTimeRemaining(int32 NewTime)
@@ -24,6 +28,7 @@ void AArenaGameState::SetTimeRemaining(int32 NewTime)
 	if (HasAuthority())
 	{
 		TimeRemaining = NewTime;
+		MARK_PROPERTY_DIRTY_FROM_NAME(AArenaGameState, TimeRemaining, this);
 		OnRep_TimeRemaining(); // Call on server too for local effects
 		OnTimeRemainingChanged.Broadcast(TimeRemaining); // Also broadcast directly on server
 	}
@@ -34,6 +39,7 @@ void AArenaGameState::SetMatchState(FName NewState)
 	if (HasAuthority())
 	{
 		MatchState = NewState;
+		MARK_PROPERTY_DIRTY_FROM_NAME(AArenaGameState, MatchState, this);
 		OnRep_MatchState(); // Call on server for local effects
 		OnArenaMatchStateChanged.Broadcast(MatchState); // Also broadcast directly on server
 	}
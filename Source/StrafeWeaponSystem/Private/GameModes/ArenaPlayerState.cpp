@@ -2,6 +2,7 @@
 
 #include "GameModes/ArenaPlayerState.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 #include "GameModes/ArenaGamemode.h" // To potentially notify GameMode
 
 AArenaPlayerState::AArenaPlayerState()
@@ -14,8 +15,11 @@ void AArenaPlayerState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& Ou
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(AArenaPlayerState, Frags);
-	DOREPLIFETIME(AArenaPlayerState, Deaths);
+	// Push model: only ScoreFrag and ScoreDeath change these
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(AArenaPlayerState, Frags, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(AArenaPlayerState, Deaths, Params);
 }
 
 void AArenaPlayerState::ScoreFrag(AArenaPlayerState* KillerPlayerState, AArenaPlayerState* VictimPlayerState)
@@ -25,6 +29,7 @@ void AArenaPlayerState::ScoreFrag(AArenaPlayerState* KillerPlayerState, AArenaPl
 	if (this == KillerPlayerState && KillerPlayerState != VictimPlayerState) // Prevent self-kill counting as a frag
 	{
 		Frags++;
+		MARK_PROPERTY_DIRTY_FROM_NAME(AArenaPlayerState, Frags, this);
 		BroadcastScoreUpdate(); // For server-side systems
 
 		// Potentially notify GameMode about the score change if it needs to check for FragLimit
@@ -42,6 +47,7 @@ void AArenaPlayerState::ScoreDeath(AArenaPlayerState* KilledPlayerState, AArenaP
 	if (this == KilledPlayerState)
 	{
 		Deaths++;
+		MARK_PROPERTY_DIRTY_FROM_NAME(AArenaPlayerState, Deaths, this);
 		BroadcastScoreUpdate(); // For server-side systems
 	}
 }
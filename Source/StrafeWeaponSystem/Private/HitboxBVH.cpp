@@ -0,0 +1,322 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "HitboxBVH.h"
+#include "Math/VectorRegister.h"
+#include "Algo/Sort.h"
+
+namespace
+{
+    // Smallest non-negative root of the ray against a sphere, if any
+    bool IntersectSphere(const FVector& Origin, const FVector& Direction, const FVector& Center, float Radius, float& OutDistance)
+    {
+        const FVector ToOrigin = Origin - Center;
+        const double B = FVector::DotProduct(Direction, ToOrigin);
+        const double C = ToOrigin.SizeSquared() - FMath::Square(Radius);
+        const double H = B * B - C;
+        if (H < 0.0)
+        {
+            return false;
+        }
+
+        const double Distance = -B - FMath::Sqrt(H);
+        if (Distance < 0.0)
+        {
+            return false;
+        }
+
+        OutDistance = static_cast<float>(Distance);
+        return true;
+    }
+}
+
+void FHitboxBVH::Build(TConstArrayView<FHitboxCapsule> InCapsules)
+{
+    Capsules.Reset(InCapsules.Num());
+    Capsules.Append(InCapsules.GetData(), InCapsules.Num());
+    Nodes.Reset();
+
+    if (Capsules.Num() == 0)
+    {
+        return;
+    }
+
+    TArray<int32, TInlineAllocator<64>> Indices;
+    Indices.SetNumUninitialized(Capsules.Num());
+    for (int32 i = 0; i < Indices.Num(); ++i)
+    {
+        Indices[i] = i;
+    }
+
+    BuildNode(Indices);
+    Refit(Capsules);
+}
+
+int32 FHitboxBVH::BuildNode(TArrayView<int32> Indices)
+{
+    // Parents are created before their children, so Refit can walk the array backwards
+    const int32 NodeIndex = Nodes.AddDefaulted();
+    for (int32 Slot = 0; Slot < 4; ++Slot)
+    {
+        Nodes[NodeIndex].Children[Slot] = EmptySlot;
+    }
+
+    if (Indices.Num() <= 4)
+    {
+        for (int32 Slot = 0; Slot < Indices.Num(); ++Slot)
+        {
+            Nodes[NodeIndex].Children[Slot] = ~Indices[Slot];
+        }
+        return NodeIndex;
+    }
+
+    // Split into four equal groups along the longest axis of the centroids
+    FBox CentroidBounds(ForceInit);
+    for (const int32 Index : Indices)
+    {
+        CentroidBounds += (Capsules[Index].Start + Capsules[Index].End) * 0.5;
+    }
+    const FVector Extent = CentroidBounds.GetExtent();
+    const int32 Axis = Extent.X >= Extent.Y && Extent.X >= Extent.Z ? 0 : (Extent.Y >= Extent.Z ? 1 : 2);
+
+    Algo::Sort(Indices, [this, Axis](int32 A, int32 B)
+    {
+        return (Capsules[A].Start[Axis] + Capsules[A].End[Axis]) < (Capsules[B].Start[Axis] + Capsules[B].End[Axis]);
+    });
+
+    int32 GroupStart = 0;
+    for (int32 Slot = 0; Slot < 4; ++Slot)
+    {
+        const int32 GroupEnd = (Indices.Num() * (Slot + 1)) / 4;
+        const int32 GroupSize = GroupEnd - GroupStart;
+
+        int32 Child = EmptySlot;
+        if (GroupSize == 1)
+        {
+            Child = ~Indices[GroupStart];
+        }
+        else if (GroupSize > 1)
+        {
+            Child = BuildNode(Indices.Slice(GroupStart, GroupSize));
+        }
+
+        // BuildNode may have grown the array; index again rather than holding a reference
+        Nodes[NodeIndex].Children[Slot] = Child;
+        GroupStart = GroupEnd;
+    }
+
+    return NodeIndex;
+}
+
+void FHitboxBVH::Refit(TConstArrayView<FHitboxCapsule> InCapsules)
+{
+    check(InCapsules.Num() == Capsules.Num());
+    if (InCapsules.GetData() != Capsules.GetData())
+    {
+        FMemory::Memcpy(Capsules.GetData(), InCapsules.GetData(), InCapsules.Num() * sizeof(FHitboxCapsule));
+    }
+
+    for (int32 NodeIndex = Nodes.Num() - 1; NodeIndex >= 0; --NodeIndex)
+    {
+        FNode& Node = Nodes[NodeIndex];
+        for (int32 Slot = 0; Slot < 4; ++Slot)
+        {
+            const int32 Child = Node.Children[Slot];
+            if (Child == EmptySlot)
+            {
+                SetSlotBounds(Node, Slot, FBox(ForceInit));
+            }
+            else if (Child < 0)
+            {
+                SetSlotBounds(Node, Slot, GetCapsuleBounds(Capsules[~Child]));
+            }
+            else
+            {
+                SetSlotBounds(Node, Slot, GetNodeBounds(Nodes[Child]));
+            }
+        }
+    }
+}
+
+void FHitboxBVH::Update(TConstArrayView<FHitboxCapsule> InCapsules)
+{
+    if (InCapsules.Num() == Capsules.Num() && Nodes.Num() > 0)
+    {
+        Refit(InCapsules);
+    }
+    else
+    {
+        Build(InCapsules);
+    }
+}
+
+void FHitboxBVH::SetSlotBounds(FNode& Node, int32 Slot, const FBox& Bounds) const
+{
+    Node.MinX[Slot] = static_cast<float>(Bounds.Min.X);
+    Node.MinY[Slot] = static_cast<float>(Bounds.Min.Y);
+    Node.MinZ[Slot] = static_cast<float>(Bounds.Min.Z);
+    Node.MaxX[Slot] = static_cast<float>(Bounds.Max.X);
+    Node.MaxY[Slot] = static_cast<float>(Bounds.Max.Y);
+    Node.MaxZ[Slot] = static_cast<float>(Bounds.Max.Z);
+}
+
+FBox FHitboxBVH::GetNodeBounds(const FNode& Node) const
+{
+    FBox Bounds(ForceInit);
+    for (int32 Slot = 0; Slot < 4; ++Slot)
+    {
+        if (Node.Children[Slot] != EmptySlot)
+        {
+            Bounds += FBox(FVector(Node.MinX[Slot], Node.MinY[Slot], Node.MinZ[Slot]), FVector(Node.MaxX[Slot], Node.MaxY[Slot], Node.MaxZ[Slot]));
+        }
+    }
+    return Bounds;
+}
+
+FBox FHitboxBVH::GetCapsuleBounds(const FHitboxCapsule& Capsule)
+{
+    const FVector RadiusExtent(Capsule.Radius);
+    return FBox(Capsule.Start.ComponentMin(Capsule.End) - RadiusExtent, Capsule.Start.ComponentMax(Capsule.End) + RadiusExtent);
+}
+
+bool FHitboxBVH::IntersectCapsule(const FVector& Origin, const FVector& Direction, const FHitboxCapsule& Capsule, float& OutDistance)
+{
+    const FVector Axis = Capsule.End - Capsule.Start;
+    const FVector ToOrigin = Origin - Capsule.Start;
+
+    const double AxisLengthSquared = Axis.SizeSquared();
+    const double AxisDotDirection = FVector::DotProduct(Axis, Direction);
+    const double AxisDotOrigin = FVector::DotProduct(Axis, ToOrigin);
+
+    // Cylinder body, unless the ray runs along the axis (then only the caps can be hit first)
+    const double A = AxisLengthSquared - AxisDotDirection * AxisDotDirection;
+    if (A > UE_KINDA_SMALL_NUMBER)
+    {
+        const double B = AxisLengthSquared * FVector::DotProduct(ToOrigin, Direction) - AxisDotOrigin * AxisDotDirection;
+        const double C = AxisLengthSquared * ToOrigin.SizeSquared() - AxisDotOrigin * AxisDotOrigin - FMath::Square(Capsule.Radius) * AxisLengthSquared;
+        const double H = B * B - A * C;
+        if (H < 0.0)
+        {
+            return false;
+        }
+
+        const double Distance = (-B - FMath::Sqrt(H)) / A;
+        const double AlongAxis = AxisDotOrigin + Distance * AxisDotDirection;
+        if (AlongAxis > 0.0 && AlongAxis < AxisLengthSquared)
+        {
+            if (Distance < 0.0)
+            {
+                return false;
+            }
+            OutDistance = static_cast<float>(Distance);
+            return true;
+        }
+    }
+
+    float StartCapDistance = MAX_flt;
+    float EndCapDistance = MAX_flt;
+    const bool bStartCap = IntersectSphere(Origin, Direction, Capsule.Start, Capsule.Radius, StartCapDistance);
+    const bool bEndCap = IntersectSphere(Origin, Direction, Capsule.End, Capsule.Radius, EndCapDistance);
+    if (!bStartCap && !bEndCap)
+    {
+        return false;
+    }
+
+    OutDistance = FMath::Min(StartCapDistance, EndCapDistance);
+    return true;
+}
+
+bool FHitboxBVH::Raycast(const FVector& Start, const FVector& End, ECollisionChannel Channel, TConstArrayView<uint32> IgnoredActorIds, FHitboxRayHit& OutHit) const
+{
+    if (Nodes.Num() == 0)
+    {
+        return false;
+    }
+
+    const FVector Delta = End - Start;
+    const float Length = static_cast<float>(Delta.Size());
+    if (Length <= UE_KINDA_SMALL_NUMBER)
+    {
+        return false;
+    }
+    const FVector Direction = Delta / Length;
+
+    // Zero components get a huge inverse instead of infinity, so 0 * inf never turns into NaN
+    auto SafeInverse = [](double Value) { return static_cast<float>(1.0 / (FMath::Abs(Value) > UE_SMALL_NUMBER ? Value : UE_SMALL_NUMBER)); };
+
+    const VectorRegister4Float OriginX = VectorSetFloat1(static_cast<float>(Start.X));
+    const VectorRegister4Float OriginY = VectorSetFloat1(static_cast<float>(Start.Y));
+    const VectorRegister4Float OriginZ = VectorSetFloat1(static_cast<float>(Start.Z));
+    const VectorRegister4Float InvDirX = VectorSetFloat1(SafeInverse(Direction.X));
+    const VectorRegister4Float InvDirY = VectorSetFloat1(SafeInverse(Direction.Y));
+    const VectorRegister4Float InvDirZ = VectorSetFloat1(SafeInverse(Direction.Z));
+    const VectorRegister4Float Zero = VectorZeroFloat();
+
+    float BestDistance = Length;
+    int32 BestCapsule = INDEX_NONE;
+
+    constexpr int32 MaxStackSize = 64;
+    int32 Stack[MaxStackSize];
+    int32 StackSize = 0;
+    Stack[StackSize++] = 0;
+
+    while (StackSize > 0)
+    {
+        const FNode& Node = Nodes[Stack[--StackSize]];
+
+        // Slab test of the ray against all four child boxes at once
+        const VectorRegister4Float T1X = VectorMultiply(VectorSubtract(VectorLoadAligned(Node.MinX), OriginX), InvDirX);
+        const VectorRegister4Float T2X = VectorMultiply(VectorSubtract(VectorLoadAligned(Node.MaxX), OriginX), InvDirX);
+        const VectorRegister4Float T1Y = VectorMultiply(VectorSubtract(VectorLoadAligned(Node.MinY), OriginY), InvDirY);
+        const VectorRegister4Float T2Y = VectorMultiply(VectorSubtract(VectorLoadAligned(Node.MaxY), OriginY), InvDirY);
+        const VectorRegister4Float T1Z = VectorMultiply(VectorSubtract(VectorLoadAligned(Node.MinZ), OriginZ), InvDirZ);
+        const VectorRegister4Float T2Z = VectorMultiply(VectorSubtract(VectorLoadAligned(Node.MaxZ), OriginZ), InvDirZ);
+
+        const VectorRegister4Float Enter = VectorMax(VectorMax(VectorMin(T1X, T2X), VectorMin(T1Y, T2Y)), VectorMax(VectorMin(T1Z, T2Z), Zero));
+        const VectorRegister4Float Exit = VectorMin(VectorMin(VectorMax(T1X, T2X), VectorMax(T1Y, T2Y)), VectorMin(VectorMax(T1Z, T2Z), VectorSetFloat1(BestDistance)));
+        const uint32 HitMask = VectorMaskBits(VectorCompareLE(Enter, Exit));
+
+        for (int32 Slot = 0; Slot < 4; ++Slot)
+        {
+            const int32 Child = Node.Children[Slot];
+            if (!(HitMask & (1u << Slot)) || Child == EmptySlot)
+            {
+                continue;
+            }
+
+            if (Child >= 0)
+            {
+                if (StackSize < MaxStackSize)
+                {
+                    Stack[StackSize++] = Child;
+                }
+                continue;
+            }
+
+            const int32 CapsuleIndex = ~Child;
+            const FHitboxCapsule& Capsule = Capsules[CapsuleIndex];
+            if (!Capsule.BlocksChannel(Channel) || IgnoredActorIds.Contains(Capsule.ActorId))
+            {
+                continue;
+            }
+
+            float Distance = 0.0f;
+            if (IntersectCapsule(Start, Direction, Capsule, Distance) && Distance < BestDistance)
+            {
+                BestDistance = Distance;
+                BestCapsule = CapsuleIndex;
+            }
+        }
+    }
+
+    if (BestCapsule == INDEX_NONE)
+    {
+        return false;
+    }
+
+    const FHitboxCapsule& Capsule = Capsules[BestCapsule];
+    OutHit.CapsuleIndex = BestCapsule;
+    OutHit.Distance = BestDistance;
+    OutHit.Location = Start + Direction * BestDistance;
+    OutHit.Normal = (OutHit.Location - FMath::ClosestPointOnSegment(OutHit.Location, Capsule.Start, Capsule.End)).GetSafeNormal();
+    return true;
+}
@@ -0,0 +1,400 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "HitscanTraceQueueSubsystem.h"
+#include "GameFramework/Controller.h"
+#include "Engine/World.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_STATS_GROUP(TEXT("StrafeHitscan"), STATGROUP_StrafeHitscan, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Flush Hitscan Queue"), STAT_HitscanQueueFlush, STATGROUP_StrafeHitscan);
+DECLARE_CYCLE_STAT(TEXT("Hitscan Callbacks"), STAT_HitscanQueueCallbacks, STATGROUP_StrafeHitscan);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Queued Hitscan Batches"), STAT_HitscanQueuedBatches, STATGROUP_StrafeHitscan);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Queued Hitscan Traces"), STAT_HitscanQueuedTraces, STATGROUP_StrafeHitscan);
+DECLARE_CYCLE_STAT(TEXT("Refit Hitboxes"), STAT_HitscanRefitHitboxes, STATGROUP_StrafeHitscan);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hitboxes"), STAT_HitscanHitboxes, STATGROUP_StrafeHitscan);
+
+namespace
+{
+    FAutoConsoleCommandWithWorldAndArgs HitboxBenchmarkCommand(
+        TEXT("Strafe.Hitbox.Benchmark"),
+        TEXT("Strafe.Hitbox.Benchmark [NumRays] [Channel] - Compares rays per second of full-scene LineTraceSingleByChannel against world-only traces plus the hitbox BVH. Channel is an ECollisionChannel index, Visibility by default. Server only."),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+        {
+            if (UHitscanTraceQueueSubsystem* Queue = World ? World->GetSubsystem<UHitscanTraceQueueSubsystem>() : nullptr)
+            {
+                const ECollisionChannel Channel = Args.Num() > 1 ? static_cast<ECollisionChannel>(FMath::Clamp(FCString::Atoi(*Args[1]), 0, 31)) : ECC_Visibility;
+                Queue->RunHitboxBenchmark(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 10000, Channel);
+            }
+        }));
+
+    // Characters HitboxBVH answers for on Channel. The scene keeps the rest, e.g. a mesh that ignores it.
+    void GetHitboxActors(TConstArrayView<FHitboxCapsule> Hitboxes, ECollisionChannel Channel, TArray<AActor*>& OutActors)
+    {
+        OutActors.Reset();
+        for (const FHitboxCapsule& Hitbox : Hitboxes)
+        {
+            if (Hitbox.BlocksChannel(Channel) && (OutActors.Num() == 0 || OutActors.Last() != Hitbox.Actor))
+            {
+                OutActors.Add(Hitbox.Actor);
+            }
+        }
+    }
+}
+
+bool UHitscanTraceQueueSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UHitscanTraceQueueSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UHitscanTraceQueueSubsystem, STATGROUP_Tickables);
+}
+
+void UHitscanTraceQueueSubsystem::QueueTraces(FHitscanTraceBatch&& Batch)
+{
+    PendingBatches.Add(MoveTemp(Batch));
+}
+
+void UHitscanTraceQueueSubsystem::Tick(float DeltaTime)
+{
+    // Earlier frames' results first, in queue order. The engine keeps async trace data for one frame,
+    // so a flush still missing results after that won't get them and completes with what it has.
+    while (InFlightFlushes.Num() > 0 && (InFlightFlushes[0]->NumOutstanding == 0 || GFrameCounter > InFlightFlushes[0]->StartFrame + 2))
+    {
+        TUniquePtr<FTraceFlush> Flush = MoveTemp(InFlightFlushes[0]);
+        InFlightFlushes.RemoveAt(0, 1, EAllowShrinking::No);
+        CompleteFlush(*Flush);
+        SpareFlushes.Add(MoveTemp(Flush));
+    }
+
+    if (PendingBatches.Num() == 0 || !GetWorld())
+    {
+        return;
+    }
+
+    // This frame's shots: started now, answered by the engine during the next frame and handed out
+    // from the next Tick
+    TUniquePtr<FTraceFlush> Flush = SpareFlushes.Num() > 0 ? SpareFlushes.Pop(EAllowShrinking::No) : MakeUnique<FTraceFlush>();
+    StartFlush(*Flush, true);
+    InFlightFlushes.Add(MoveTemp(Flush));
+}
+
+void UHitscanTraceQueueSubsystem::FlushTraces()
+{
+    if (PendingBatches.Num() == 0 || !GetWorld() || bFlushing)
+    {
+        return;
+    }
+
+    TUniquePtr<FTraceFlush> Flush = SpareFlushes.Num() > 0 ? SpareFlushes.Pop(EAllowShrinking::No) : MakeUnique<FTraceFlush>();
+    StartFlush(*Flush, false);
+    CompleteFlush(*Flush);
+    SpareFlushes.Add(MoveTemp(Flush));
+}
+
+void UHitscanTraceQueueSubsystem::StartFlush(FTraceFlush& Flush, bool bAsync)
+{
+    UWorld* World = GetWorld();
+
+    SCOPE_CYCLE_COUNTER(STAT_HitscanQueueFlush);
+    TGuardValue<bool> FlushGuard(bFlushing, true);
+
+    // Swapped rather than moved, so both arrays keep their capacity
+    Flush.Batches.Reset();
+    Swap(Flush.Batches, PendingBatches);
+    Flush.Serial = NextFlushSerial++;
+    Flush.StartFrame = GFrameCounter;
+    Flush.NumOutstanding = 0;
+
+    int32 NumTraces = 0;
+    Flush.ResultOffsets.Reset(Flush.Batches.Num());
+    for (const FHitscanTraceBatch& Batch : Flush.Batches)
+    {
+        Flush.ResultOffsets.Add(NumTraces);
+        NumTraces += Batch.Segments.Num();
+    }
+    Flush.Results.Reset(NumTraces);
+    Flush.Results.SetNum(NumTraces);
+
+    SET_DWORD_STAT(STAT_HitscanQueuedBatches, Flush.Batches.Num());
+    SET_DWORD_STAT(STAT_HitscanQueuedTraces, NumTraces);
+
+    // One group per lag-compensated shooter, plus one for everything traced against the present
+    TArray<int32, TInlineAllocator<16>> PresentBatches;
+    TMap<AController*, TArray<int32, TInlineAllocator<4>>> ShooterBatches;
+    for (int32 BatchIndex = 0; BatchIndex < Flush.Batches.Num(); ++BatchIndex)
+    {
+        if (AController* Shooter = Flush.Batches[BatchIndex].LagCompensatedShooter.Get())
+        {
+            ShooterBatches.FindOrAdd(Shooter).Add(BatchIndex);
+        }
+        else
+        {
+            PresentBatches.Add(BatchIndex);
+        }
+    }
+
+    const ULagCompensationSubsystem* LagCompensation = World->GetSubsystem<ULagCompensationSubsystem>();
+    const bool bUseHitboxes = bResolvePawnHitsWithHitboxes && LagCompensation && LagCompensation->GetNumRecordedCharacters() > 0;
+
+    Flush.WorldQueryParams.Reset(bUseHitboxes ? Flush.Batches.Num() : 0);
+    if (bUseHitboxes)
+    {
+        UpdateHitboxes(*LagCompensation, World->GetTimeSeconds());
+
+        // The world half of every trace ignores the characters with hitboxes blocking its channel;
+        // HitboxBVH answers for them instead. Batches almost always share a channel or two.
+        TArray<TPair<ECollisionChannel, TArray<AActor*>>, TInlineAllocator<4>> HitboxActorsByChannel;
+        for (const FHitscanTraceBatch& Batch : Flush.Batches)
+        {
+            TPair<ECollisionChannel, TArray<AActor*>>* HitboxActors = HitboxActorsByChannel.FindByPredicate(
+                [&Batch](const TPair<ECollisionChannel, TArray<AActor*>>& Entry) { return Entry.Key == Batch.Channel; });
+            if (!HitboxActors)
+            {
+                HitboxActors = &HitboxActorsByChannel.Emplace_GetRef(Batch.Channel, TArray<AActor*>());
+                GetHitboxActors(Hitboxes, Batch.Channel, HitboxActors->Value);
+            }
+
+            FCollisionQueryParams& Params = Flush.WorldQueryParams.Add_GetRef(Batch.QueryParams);
+            Params.AddIgnoredActors(HitboxActors->Value);
+        }
+    }
+
+    RunTraces(World, Flush, PresentBatches, bUseHitboxes, bAsync);
+
+    for (const TPair<AController*, TArray<int32, TInlineAllocator<4>>>& Group : ShooterBatches)
+    {
+        if (bUseHitboxes)
+        {
+            // Same capsules, moved to where the shooter saw them; nothing in the world has to move
+            UpdateHitboxes(*LagCompensation, LagCompensation->GetEstimatedViewTime(Group.Key));
+            RunTraces(World, Flush, Group.Value, true, bAsync);
+            continue;
+        }
+
+        // One rewind covers every shot this shooter fired this frame; the cone only narrows it for a single shot
+        const FHitscanTraceBatch& FirstBatch = Flush.Batches[Group.Value[0]];
+        const FLagCompensationQuery* Query = Group.Value.Num() == 1 && FirstBatch.LagCompensationQuery.IsSet() ? &FirstBatch.LagCompensationQuery.GetValue() : nullptr;
+
+        // The rewound world only exists inside this scope, so these traces can't be left to the engine
+        FScopedLagCompensation Rewind(World, Group.Key, Query);
+        RunTraces(World, Flush, Group.Value, false, false);
+    }
+}
+
+void UHitscanTraceQueueSubsystem::CompleteFlush(FTraceFlush& Flush)
+{
+    SCOPE_CYCLE_COUNTER(STAT_HitscanQueueCallbacks);
+
+    // Callbacks may queue follow-up shots; those wait for the next flush
+    TGuardValue<bool> FlushGuard(bFlushing, true);
+    for (int32 BatchIndex = 0; BatchIndex < Flush.Batches.Num(); ++BatchIndex)
+    {
+        const FHitscanTraceBatch& Batch = Flush.Batches[BatchIndex];
+        Batch.OnComplete.ExecuteIfBound(TConstArrayView<FHitscanTraceResult>(Flush.Results.GetData() + Flush.ResultOffsets[BatchIndex], Batch.Segments.Num()));
+    }
+
+    Flush.Batches.Reset();
+    Flush.Serial = 0;
+}
+
+void UHitscanTraceQueueSubsystem::OnWorldTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum, uint32 FlushSerial)
+{
+    TUniquePtr<FTraceFlush>* FlushPtr = InFlightFlushes.FindByPredicate([FlushSerial](const TUniquePtr<FTraceFlush>& Entry) { return Entry->Serial == FlushSerial; });
+    if (!FlushPtr || !(*FlushPtr)->Results.IsValidIndex(Datum.UserData))
+    {
+        return;
+    }
+
+    FTraceFlush& Flush = **FlushPtr;
+    --Flush.NumOutstanding;
+
+    // The pawn hit, if any, was filled in when the trace started; only a world hit in front of it wins
+    FHitscanTraceResult& Result = Flush.Results[Datum.UserData];
+    const FHitResult* WorldHit = Datum.OutHits.FindByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; });
+    if (WorldHit && (!Result.bBlockingHit || WorldHit->Distance < Result.Hit.Distance))
+    {
+        Result.Hit = *WorldHit;
+        Result.bBlockingHit = true;
+    }
+    else if (!Result.bBlockingHit)
+    {
+        Result.Hit.TraceStart = Datum.Start;
+        Result.Hit.TraceEnd = Datum.End;
+    }
+}
+
+void UHitscanTraceQueueSubsystem::UpdateHitboxes(const ULagCompensationSubsystem& LagCompensation, double Time)
+{
+    SCOPE_CYCLE_COUNTER(STAT_HitscanRefitHitboxes);
+
+    Hitboxes.Reset();
+    LagCompensation.GatherHitboxes(Time, Hitboxes);
+    HitboxBVH.Update(Hitboxes);
+
+    SET_DWORD_STAT(STAT_HitscanHitboxes, Hitboxes.Num());
+}
+
+void UHitscanTraceQueueSubsystem::MakePawnHit(const FHitboxCapsule& Capsule, const FHitboxRayHit& RayHit, const FVector& Start, const FVector& End, FHitResult& OutHit)
+{
+    OutHit = FHitResult(Capsule.Actor, Capsule.Component, RayHit.Location, RayHit.Normal);
+    OutHit.bBlockingHit = true;
+    OutHit.TraceStart = Start;
+    OutHit.TraceEnd = End;
+    OutHit.ImpactPoint = RayHit.Location;
+    OutHit.ImpactNormal = RayHit.Normal;
+    OutHit.Distance = RayHit.Distance;
+    OutHit.BoneName = Capsule.BoneName;
+    OutHit.PhysMaterial = Capsule.PhysMaterial;
+    OutHit.Time = RayHit.Distance / FMath::Max(FVector::Dist(Start, End), UE_KINDA_SMALL_NUMBER);
+}
+
+void UHitscanTraceQueueSubsystem::RunTraces(UWorld* World, FTraceFlush& Flush, TConstArrayView<int32> BatchIndices, bool bUseHitboxes, bool bAsync)
+{
+    FlatTraces.Reset();
+    for (const int32 BatchIndex : BatchIndices)
+    {
+        for (int32 SegmentIndex = 0; SegmentIndex < Flush.Batches[BatchIndex].Segments.Num(); ++SegmentIndex)
+        {
+            FlatTraces.Emplace(BatchIndex, SegmentIndex);
+        }
+    }
+
+    if (FlatTraces.Num() == 0)
+    {
+        return;
+    }
+
+    if (bAsync)
+    {
+        // Pawn hits are taken now, while HitboxBVH holds this group's capsules; the world half is left
+        // to the engine's async traces and merged in OnWorldTraceDone
+        const FTraceDelegate OnTraceDone = FTraceDelegate::CreateUObject(this, &UHitscanTraceQueueSubsystem::OnWorldTraceDone, Flush.Serial);
+        for (const TPair<int32, int32>& Trace : FlatTraces)
+        {
+            const FHitscanTraceBatch& Batch = Flush.Batches[Trace.Key];
+            const TPair<FVector, FVector>& Segment = Batch.Segments[Trace.Value];
+            const int32 ResultIndex = Flush.ResultOffsets[Trace.Key] + Trace.Value;
+
+            FHitscanTraceResult& Result = Flush.Results[ResultIndex];
+            FHitboxRayHit PawnHit;
+            if (bUseHitboxes && HitboxBVH.Raycast(Segment.Key, Segment.Value, Batch.Channel, Batch.QueryParams.GetIgnoredActors(), PawnHit))
+            {
+                MakePawnHit(HitboxBVH.GetCapsule(PawnHit.CapsuleIndex), PawnHit, Segment.Key, Segment.Value, Result.Hit);
+                Result.bBlockingHit = true;
+            }
+
+            World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Segment.Key, Segment.Value, Batch.Channel,
+                bUseHitboxes ? Flush.WorldQueryParams[Trace.Key] : Batch.QueryParams, FCollisionResponseParams::DefaultResponseParam, &OnTraceDone, ResultIndex);
+            ++Flush.NumOutstanding;
+        }
+        return;
+    }
+
+    // Nothing writes to the scene while the game thread waits here, so the queries only read
+    ParallelFor(FlatTraces.Num(), [this, World, &Flush, bUseHitboxes](int32 TraceIndex)
+    {
+        const int32 BatchIndex = FlatTraces[TraceIndex].Key;
+        const int32 SegmentIndex = FlatTraces[TraceIndex].Value;
+        const FHitscanTraceBatch& Batch = Flush.Batches[BatchIndex];
+        const TPair<FVector, FVector>& Segment = Batch.Segments[SegmentIndex];
+
+        FHitscanTraceResult& Result = Flush.Results[Flush.ResultOffsets[BatchIndex] + SegmentIndex];
+        if (!bUseHitboxes)
+        {
+            Result.bBlockingHit = World->LineTraceSingleByChannel(Result.Hit, Segment.Key, Segment.Value, Batch.Channel, Batch.QueryParams);
+            return;
+        }
+
+        Result.bBlockingHit = World->LineTraceSingleByChannel(Result.Hit, Segment.Key, Segment.Value, Batch.Channel, Flush.WorldQueryParams[BatchIndex]);
+
+        // Only a pawn in front of the world hit counts
+        FHitboxRayHit PawnHit;
+        const FVector RayEnd = Result.bBlockingHit ? Result.Hit.Location : Segment.Value;
+        if (HitboxBVH.Raycast(Segment.Key, RayEnd, Batch.Channel, Batch.QueryParams.GetIgnoredActors(), PawnHit))
+        {
+            MakePawnHit(HitboxBVH.GetCapsule(PawnHit.CapsuleIndex), PawnHit, Segment.Key, Segment.Value, Result.Hit);
+            Result.bBlockingHit = true;
+        }
+    }, FlatTraces.Num() < MinTracesForParallel ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+}
+
+void UHitscanTraceQueueSubsystem::RunHitboxBenchmark(int32 NumRays, ECollisionChannel Channel)
+{
+    UWorld* World = GetWorld();
+    const ULagCompensationSubsystem* LagCompensation = World ? World->GetSubsystem<ULagCompensationSubsystem>() : nullptr;
+    if (!LagCompensation || LagCompensation->GetNumRecordedCharacters() == 0 || NumRays <= 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("HitboxBenchmark: Needs a server with recorded characters and a positive ray count"));
+        return;
+    }
+
+    const uint32 RefitStart = FPlatformTime::Cycles();
+    UpdateHitboxes(*LagCompensation, World->GetTimeSeconds());
+    const uint32 RefitCycles = FPlatformTime::Cycles() - RefitStart;
+
+    // Rays from a random spot around one character towards a random character, the way a fight looks
+    FRandomStream Stream(NumRays);
+    TArray<TPair<FVector, FVector>> Rays;
+    Rays.Reserve(NumRays);
+    for (int32 i = 0; i < NumRays; ++i)
+    {
+        const FHitboxCapsule& From = Hitboxes[Stream.RandHelper(Hitboxes.Num())];
+        const FHitboxCapsule& To = Hitboxes[Stream.RandHelper(Hitboxes.Num())];
+        const FVector Start = (From.Start + From.End) * 0.5 + Stream.GetUnitVector() * Stream.FRandRange(300.0f, 3000.0f);
+        const FVector Target = (To.Start + To.End) * 0.5 + Stream.GetUnitVector() * Stream.FRandRange(0.0f, 100.0f);
+        Rays.Emplace(Start, Start + (Target - Start).GetSafeNormal() * 10000.0f);
+    }
+
+    TArray<AActor*> HitboxActors;
+    GetHitboxActors(Hitboxes, Channel, HitboxActors);
+
+    const FCollisionQueryParams SceneParams(SCENE_QUERY_STAT(HitboxBenchmarkScene), false);
+    FCollisionQueryParams WorldParams(SCENE_QUERY_STAT(HitboxBenchmarkWorld), false);
+    WorldParams.AddIgnoredActors(HitboxActors);
+
+    // Current path: the whole scene, pawns included
+    int32 ScenePawnHits = 0;
+    const uint32 SceneStart = FPlatformTime::Cycles();
+    for (const TPair<FVector, FVector>& Ray : Rays)
+    {
+        FHitResult Hit;
+        if (World->LineTraceSingleByChannel(Hit, Ray.Key, Ray.Value, Channel, SceneParams) && HitboxActors.Contains(Hit.GetActor()))
+        {
+            ++ScenePawnHits;
+        }
+    }
+    const uint32 SceneCycles = FPlatformTime::Cycles() - SceneStart;
+
+    // Pawn tests alone
+    int32 BVHPawnHits = 0;
+    const uint32 BVHStart = FPlatformTime::Cycles();
+    for (const TPair<FVector, FVector>& Ray : Rays)
+    {
+        FHitboxRayHit PawnHit;
+        BVHPawnHits += HitboxBVH.Raycast(Ray.Key, Ray.Value, Channel, TConstArrayView<uint32>(), PawnHit) ? 1 : 0;
+    }
+    const uint32 BVHCycles = FPlatformTime::Cycles() - BVHStart;
+
+    // Hitbox path: world occlusion from the scene, pawns from the BVH, as RunTraces does it
+    int32 SplitPawnHits = 0;
+    const uint32 SplitStart = FPlatformTime::Cycles();
+    for (const TPair<FVector, FVector>& Ray : Rays)
+    {
+        FHitResult Hit;
+        const bool bWorldHit = World->LineTraceSingleByChannel(Hit, Ray.Key, Ray.Value, Channel, WorldParams);
+
+        FHitboxRayHit PawnHit;
+        SplitPawnHits += HitboxBVH.Raycast(Ray.Key, bWorldHit ? Hit.Location : Ray.Value, Channel, TConstArrayView<uint32>(), PawnHit) ? 1 : 0;
+    }
+    const uint32 SplitCycles = FPlatformTime::Cycles() - SplitStart;
+
+    auto RaysPerSecond = [NumRays](uint32 Cycles) { return NumRays / FMath::Max(FPlatformTime::ToSeconds(Cycles), UE_DOUBLE_SMALL_NUMBER); };
+    UE_LOG(LogTemp, Log, TEXT("HitboxBenchmark: Rays=%d Hitboxes=%d Channel=%d Refit=%.3fms"), NumRays, Hitboxes.Num(), static_cast<int32>(Channel), FPlatformTime::ToMilliseconds(RefitCycles));
+    UE_LOG(LogTemp, Log, TEXT("HitboxBenchmark:   Scene trace       %12.0f rays/s  PawnHits=%d"), RaysPerSecond(SceneCycles), ScenePawnHits);
+    UE_LOG(LogTemp, Log, TEXT("HitboxBenchmark:   BVH only          %12.0f rays/s  PawnHits=%d"), RaysPerSecond(BVHCycles), BVHPawnHits);
+    UE_LOG(LogTemp, Log, TEXT("HitboxBenchmark:   World trace + BVH %12.0f rays/s  PawnHits=%d"), RaysPerSecond(SplitCycles), SplitPawnHits);
+}
@@ -0,0 +1,525 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LagCompensationSubsystem.h"
+#include "HitboxBVH.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/PlayerState.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "PhysicsEngine/PhysicsAsset.h"
+#include "PhysicsEngine/SkeletalBodySetup.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_STATS_GROUP(TEXT("StrafeLagCompensation"), STATGROUP_StrafeLagCompensation, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Record Samples"), STAT_LagCompensationRecord, STATGROUP_StrafeLagCompensation);
+DECLARE_CYCLE_STAT(TEXT("Rewind"), STAT_LagCompensationRewind, STATGROUP_StrafeLagCompensation);
+DECLARE_CYCLE_STAT(TEXT("Restore"), STAT_LagCompensationRestore, STATGROUP_StrafeLagCompensation);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Recorded Characters"), STAT_LagCompensationCharacters, STATGROUP_StrafeLagCompensation);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Rewinds"), STAT_LagCompensationRewinds, STATGROUP_StrafeLagCompensation);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Characters Rewound"), STAT_LagCompensationCharactersMoved, STATGROUP_StrafeLagCompensation);
+
+namespace
+{
+    FAutoConsoleCommandWithWorld DumpLagCompensationCommand(
+        TEXT("Strafe.LagCompensation.Dump"),
+        TEXT("Logs recorded character count and per-rewind cost counters of the lag compensation history."),
+        FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+        {
+            if (const ULagCompensationSubsystem* LagCompensation = World ? World->GetSubsystem<ULagCompensationSubsystem>() : nullptr)
+            {
+                LagCompensation->LogLagCompensationStats();
+            }
+        }));
+
+    // Bit per channel the body blocks, in the form FHitboxCapsule keeps it
+    uint32 GetBlockedChannels(const FBodyInstance& BodyInstance)
+    {
+        const FCollisionResponseContainer& Responses = BodyInstance.GetResponseToChannels();
+        uint32 Blocked = 0;
+        for (int32 Channel = 0; Channel < 32; ++Channel)
+        {
+            if (Responses.GetResponse(static_cast<ECollisionChannel>(Channel)) == ECR_Block)
+            {
+                Blocked |= 1u << Channel;
+            }
+        }
+        return Blocked;
+    }
+
+    bool IsInsideQuery(const FLagCompensationQuery& Query, const FVector& Location, float Radius)
+    {
+        const FVector ToTarget = Location - Query.Origin;
+        const float Along = FVector::DotProduct(ToTarget, Query.Direction);
+        if (Along < -Radius || Along > Query.Range + Radius)
+        {
+            return false;
+        }
+
+        const float AllowedDistance = FMath::Max(Along, 0.0f) * FMath::Tan(Query.HalfAngleRadians) + Radius;
+        return (ToTarget - Query.Direction * Along).SizeSquared() <= FMath::Square(AllowedDistance);
+    }
+}
+
+bool ULagCompensationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId ULagCompensationSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(ULagCompensationSubsystem, STATGROUP_Tickables);
+}
+
+void ULagCompensationSubsystem::RegisterCharacter(ACharacter* Character)
+{
+    if (!Character || !Character->HasAuthority() || Character->GetNetMode() == NM_Standalone)
+    {
+        return;
+    }
+
+    if (Histories.ContainsByPredicate([Character](const FCharacterHistory& History) { return History.Character.Get() == Character; }))
+    {
+        return;
+    }
+
+    FCharacterHistory& History = Histories.AddDefaulted_GetRef();
+    History.Character = Character;
+    History.Samples.SetNum(FMath::Max(HistoryDepth, 2));
+}
+
+void ULagCompensationSubsystem::UnregisterCharacter(ACharacter* Character)
+{
+    Histories.RemoveAllSwap([Character](const FCharacterHistory& History) { return History.Character.Get() == Character; });
+}
+
+void ULagCompensationSubsystem::Tick(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_LagCompensationRecord);
+    SET_DWORD_STAT(STAT_LagCompensationCharacters, Histories.Num());
+
+    UWorld* World = GetWorld();
+    if (!World || Histories.Num() == 0)
+    {
+        return;
+    }
+
+    // Subsystems tick after every actor, so this is the state that goes out to clients this frame
+    const double Now = World->GetTimeSeconds();
+    for (int32 i = Histories.Num() - 1; i >= 0; --i)
+    {
+        FCharacterHistory& History = Histories[i];
+        const ACharacter* Character = History.Character.Get();
+        if (!Character)
+        {
+            Histories.RemoveAtSwap(i);
+            continue;
+        }
+
+        const int32 Capacity = History.Samples.Num();
+        if (History.Num < Capacity)
+        {
+            CaptureSample(Character, Now, History.Samples[(History.Head + History.Num) % Capacity]);
+            ++History.Num;
+        }
+        else
+        {
+            CaptureSample(Character, Now, History.Samples[History.Head]);
+            History.Head = (History.Head + 1) % Capacity;
+        }
+    }
+}
+
+void ULagCompensationSubsystem::CaptureSample(const ACharacter* Character, double Time, FLagCompensationSample& OutSample, bool bWithBodies)
+{
+    OutSample.Time = Time;
+    OutSample.Location = Character->GetActorLocation();
+    OutSample.Rotation = Character->GetActorQuat();
+    OutSample.Bodies.Reset();
+
+    if (const UCapsuleComponent* Capsule = Character->GetCapsuleComponent())
+    {
+        Capsule->GetUnscaledCapsuleSize(OutSample.CapsuleRadius, OutSample.CapsuleHalfHeight);
+    }
+    if (const USkeletalMeshComponent* Mesh = Character->GetMesh())
+    {
+        OutSample.MeshTransform = Mesh->GetComponentTransform();
+        if (bWithBodies)
+        {
+            CaptureBodies(Mesh, OutSample.Bodies);
+        }
+    }
+}
+
+void ULagCompensationSubsystem::CaptureBodies(const USkeletalMeshComponent* Mesh, TArray<FLagCompensationBody>& OutBodies)
+{
+    OutBodies.Reset();
+
+    const UPhysicsAsset* PhysicsAsset = Mesh->GetPhysicsAsset();
+    if (!PhysicsAsset)
+    {
+        return;
+    }
+
+    // Component space, so the ring only has to interpolate the mesh transform for the world placement
+    const TArray<FTransform>& ComponentSpaceTransforms = Mesh->GetComponentSpaceTransforms();
+    for (int32 BodyIndex = 0; BodyIndex < PhysicsAsset->SkeletalBodySetups.Num(); ++BodyIndex)
+    {
+        const USkeletalBodySetup* BodySetup = PhysicsAsset->SkeletalBodySetups[BodyIndex];
+        if (!BodySetup || BodySetup->CollisionReponse == EBodyCollisionResponse::BodyCollision_Disabled)
+        {
+            continue;
+        }
+
+        const int32 BoneIndex = Mesh->GetBoneIndex(BodySetup->BoneName);
+        if (!ComponentSpaceTransforms.IsValidIndex(BoneIndex))
+        {
+            continue;
+        }
+
+        const FTransform& BoneTransform = ComponentSpaceTransforms[BoneIndex];
+        const float BoneScale = BoneTransform.GetMaximumAxisScale();
+        auto AddBody = [&OutBodies, &BoneTransform, BoneScale, BodySetup, BodyIndex](const FVector& LocalStart, const FVector& LocalEnd, float Radius)
+        {
+            FLagCompensationBody& Body = OutBodies.AddDefaulted_GetRef();
+            Body.Start = BoneTransform.TransformPosition(LocalStart);
+            Body.End = BoneTransform.TransformPosition(LocalEnd);
+            Body.Radius = Radius * BoneScale;
+            Body.BoneName = BodySetup->BoneName;
+            Body.BodyIndex = BodyIndex;
+        };
+
+        for (const FKSphylElem& Sphyl : BodySetup->AggGeom.SphylElems)
+        {
+            const FVector HalfSegment = Sphyl.Rotation.RotateVector(FVector(0.0f, 0.0f, Sphyl.Length * 0.5f));
+            AddBody(Sphyl.Center - HalfSegment, Sphyl.Center + HalfSegment, Sphyl.Radius);
+        }
+
+        for (const FKSphereElem& Sphere : BodySetup->AggGeom.SphereElems)
+        {
+            AddBody(Sphere.Center, Sphere.Center, Sphere.Radius);
+        }
+
+        for (const FKBoxElem& Box : BodySetup->AggGeom.BoxElems)
+        {
+            const FVector HalfExtent(Box.X * 0.5f, Box.Y * 0.5f, Box.Z * 0.5f);
+            const int32 LongAxis = HalfExtent.X >= HalfExtent.Y ? (HalfExtent.X >= HalfExtent.Z ? 0 : 2) : (HalfExtent.Y >= HalfExtent.Z ? 1 : 2);
+            const float Radius = static_cast<float>(FMath::Max(HalfExtent[(LongAxis + 1) % 3], HalfExtent[(LongAxis + 2) % 3]));
+
+            FVector Axis = FVector::ZeroVector;
+            Axis[LongAxis] = FMath::Max(HalfExtent[LongAxis] - Radius, 0.0f);
+            const FVector HalfSegment = Box.Rotation.RotateVector(Axis);
+            AddBody(Box.Center - HalfSegment, Box.Center + HalfSegment, Radius);
+        }
+    }
+}
+
+void ULagCompensationSubsystem::ApplySample(ACharacter* Character, const FLagCompensationSample& Sample)
+{
+    // Crouching changes the capsule, so size goes first; no overlap update, no sweep
+    if (UCapsuleComponent* Capsule = Character->GetCapsuleComponent())
+    {
+        Capsule->SetCapsuleSize(Sample.CapsuleRadius, Sample.CapsuleHalfHeight, false);
+    }
+
+    Character->SetActorLocationAndRotation(Sample.Location, Sample.Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+
+    if (USkeletalMeshComponent* Mesh = Character->GetMesh())
+    {
+        Mesh->SetWorldTransform(Sample.MeshTransform, false, nullptr, ETeleportType::TeleportPhysics);
+    }
+}
+
+double ULagCompensationSubsystem::GetEstimatedViewTime(const AController* Shooter) const
+{
+    const UWorld* World = GetWorld();
+    const double Now = World ? World->GetTimeSeconds() : 0.0;
+
+    const APlayerState* PlayerState = Shooter ? Shooter->PlayerState : nullptr;
+    if (!PlayerState || Shooter->IsLocalController())
+    {
+        return Now;
+    }
+
+    const float PingSeconds = PlayerState->GetPingInMilliseconds() * 0.001f;
+    const float Rewind = FMath::Clamp(PingSeconds * PingRewindScale + ExtraRewindTime, 0.0f, MaxRewindTime);
+    return Now - Rewind;
+}
+
+bool ULagCompensationSubsystem::GetSampleAtTime(const ACharacter* Character, double Time, FLagCompensationSample& OutSample) const
+{
+    const FCharacterHistory* History = Histories.FindByPredicate([Character](const FCharacterHistory& Entry) { return Entry.Character.Get() == Character; });
+    return History && SampleHistory(*History, Time, OutSample);
+}
+
+void ULagCompensationSubsystem::GatherHitboxes(double Time, TArray<FHitboxCapsule>& OutHitboxes) const
+{
+    const UWorld* World = GetWorld();
+    const double Now = World ? World->GetTimeSeconds() : 0.0;
+
+    for (const FCharacterHistory& History : Histories)
+    {
+        ACharacter* Character = History.Character.Get();
+        UCapsuleComponent* CapsuleComponent = Character ? Character->GetCapsuleComponent() : nullptr;
+        if (!CapsuleComponent || !Character->GetActorEnableCollision())
+        {
+            continue;
+        }
+
+        FLagCompensationSample Sample;
+        if (Time >= Now)
+        {
+            CaptureSample(Character, Now, Sample);
+        }
+        else if (!SampleHistory(History, Time, Sample))
+        {
+            continue;
+        }
+
+        USkeletalMeshComponent* Mesh = Character->GetMesh();
+        if (Mesh && Sample.Bodies.Num() > 0)
+        {
+            if (!Mesh->IsQueryCollisionEnabled())
+            {
+                continue;
+            }
+
+            // The bodies the scene trace used to hit, placed with the recorded mesh transform.
+            // Collision settings come from the live bodies; a rewind doesn't change what they respond to.
+            const float MeshScale = Sample.MeshTransform.GetMaximumAxisScale();
+            for (const FLagCompensationBody& Body : Sample.Bodies)
+            {
+                const FBodyInstance* BodyInstance = Mesh->Bodies.IsValidIndex(Body.BodyIndex) ? Mesh->Bodies[Body.BodyIndex] : nullptr;
+                if (!BodyInstance || !CollisionEnabledHasQuery(BodyInstance->GetCollisionEnabled()))
+                {
+                    continue;
+                }
+
+                FHitboxCapsule& Hitbox = OutHitboxes.AddDefaulted_GetRef();
+                Hitbox.Start = Sample.MeshTransform.TransformPosition(Body.Start);
+                Hitbox.End = Sample.MeshTransform.TransformPosition(Body.End);
+                Hitbox.Radius = Body.Radius * MeshScale;
+                Hitbox.Actor = Character;
+                Hitbox.Component = Mesh;
+                Hitbox.ActorId = Character->GetUniqueID();
+                Hitbox.BoneName = Body.BoneName;
+                Hitbox.PhysMaterial = BodyInstance->GetSimplePhysicalMaterial();
+                Hitbox.BlockedChannels = GetBlockedChannels(*BodyInstance);
+            }
+            continue;
+        }
+
+        if (!CapsuleComponent->IsQueryCollisionEnabled())
+        {
+            continue;
+        }
+
+        // No physics asset: the movement capsule is the only shape there is.
+        // Samples hold the unscaled size, like SetCapsuleSize expects.
+        const float Scale = CapsuleComponent->GetShapeScale();
+        const float Radius = Sample.CapsuleRadius * Scale;
+        const FVector HalfSegment = Sample.Rotation.GetUpVector() * FMath::Max(Sample.CapsuleHalfHeight * Scale - Radius, 0.0f);
+
+        FHitboxCapsule& Hitbox = OutHitboxes.AddDefaulted_GetRef();
+        Hitbox.Start = Sample.Location - HalfSegment;
+        Hitbox.End = Sample.Location + HalfSegment;
+        Hitbox.Radius = Radius;
+        Hitbox.Actor = Character;
+        Hitbox.Component = CapsuleComponent;
+        Hitbox.ActorId = Character->GetUniqueID();
+        Hitbox.PhysMaterial = CapsuleComponent->BodyInstance.GetSimplePhysicalMaterial();
+        Hitbox.BlockedChannels = GetBlockedChannels(CapsuleComponent->BodyInstance);
+    }
+}
+
+bool ULagCompensationSubsystem::SampleHistory(const FCharacterHistory& History, double Time, FLagCompensationSample& OutSample) const
+{
+    if (History.Num == 0)
+    {
+        return false;
+    }
+
+    const int32 Capacity = History.Samples.Num();
+    const FLagCompensationSample& Oldest = History.Samples[History.Head];
+    const FLagCompensationSample& Newest = History.Samples[(History.Head + History.Num - 1) % Capacity];
+
+    // Older than the buffer holds: the oldest sample is the best we have
+    if (Time <= Oldest.Time)
+    {
+        OutSample = Oldest;
+        return true;
+    }
+    if (Time >= Newest.Time)
+    {
+        OutSample = Newest;
+        return true;
+    }
+
+    // Samples are in time order; walk back from the newest since rewinds are short
+    for (int32 Offset = History.Num - 2; Offset >= 0; --Offset)
+    {
+        const FLagCompensationSample& Before = History.Samples[(History.Head + Offset) % Capacity];
+        if (Before.Time > Time)
+        {
+            continue;
+        }
+
+        const FLagCompensationSample& After = History.Samples[(History.Head + Offset + 1) % Capacity];
+        const float Alpha = static_cast<float>((Time - Before.Time) / FMath::Max(After.Time - Before.Time, UE_DOUBLE_SMALL_NUMBER));
+
+        OutSample.Time = Time;
+        OutSample.Location = FMath::Lerp(Before.Location, After.Location, Alpha);
+        OutSample.Rotation = FQuat::Slerp(Before.Rotation, After.Rotation, Alpha);
+        OutSample.CapsuleRadius = FMath::Lerp(Before.CapsuleRadius, After.CapsuleRadius, Alpha);
+        OutSample.CapsuleHalfHeight = FMath::Lerp(Before.CapsuleHalfHeight, After.CapsuleHalfHeight, Alpha);
+        OutSample.MeshTransform.Blend(Before.MeshTransform, After.MeshTransform, Alpha);
+
+        // Same physics asset on both sides blends body by body; a swapped asset snaps to the nearer sample
+        if (Before.Bodies.Num() == After.Bodies.Num())
+        {
+            OutSample.Bodies.SetNum(Before.Bodies.Num());
+            for (int32 BodyIndex = 0; BodyIndex < Before.Bodies.Num(); ++BodyIndex)
+            {
+                const FLagCompensationBody& BodyBefore = Before.Bodies[BodyIndex];
+                const FLagCompensationBody& BodyAfter = After.Bodies[BodyIndex];
+                FLagCompensationBody& Body = OutSample.Bodies[BodyIndex];
+                Body.Start = FMath::Lerp(BodyBefore.Start, BodyAfter.Start, Alpha);
+                Body.End = FMath::Lerp(BodyBefore.End, BodyAfter.End, Alpha);
+                Body.Radius = FMath::Lerp(BodyBefore.Radius, BodyAfter.Radius, Alpha);
+                Body.BoneName = BodyBefore.BoneName;
+                Body.BodyIndex = BodyBefore.BodyIndex;
+            }
+        }
+        else
+        {
+            OutSample.Bodies = Alpha < 0.5f ? Before.Bodies : After.Bodies;
+        }
+        return true;
+    }
+
+    OutSample = Oldest;
+    return true;
+}
+
+void ULagCompensationSubsystem::LogLagCompensationStats() const
+{
+    UE_LOG(LogTemp, Log, TEXT("LagCompensation: Characters=%d HistoryDepth=%d MaxRewind=%.3fs Rewinds=%llu AvgMoved=%.2f AvgSkipped=%.2f MaxMoved=%d AvgCost=%.3fms MaxCost=%.3fms"),
+        Histories.Num(), HistoryDepth, MaxRewindTime, TotalRewinds,
+        TotalRewinds > 0 ? static_cast<double>(TotalCharactersMoved) / TotalRewinds : 0.0,
+        TotalRewinds > 0 ? static_cast<double>(TotalCharactersSkipped) / TotalRewinds : 0.0,
+        MaxCharactersMoved,
+        TotalRewinds > 0 ? FPlatformTime::ToMilliseconds64(TotalRewindCycles) / TotalRewinds : 0.0,
+        FPlatformTime::ToMilliseconds(MaxRewindCycles));
+}
+
+FScopedLagCompensation::FScopedLagCompensation(UWorld* World, AController* Shooter, const FLagCompensationQuery* Query)
+{
+    if (!World || World->GetNetMode() == NM_Client || World->GetNetMode() == NM_Standalone || !Shooter || Shooter->IsLocalController())
+    {
+        return;
+    }
+
+    ULagCompensationSubsystem* LagCompensation = World->GetSubsystem<ULagCompensationSubsystem>();
+    if (!LagCompensation || LagCompensation->Histories.Num() == 0)
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_LagCompensationRewind);
+    const uint32 StartCycles = FPlatformTime::Cycles();
+
+    const double ViewTime = LagCompensation->GetEstimatedViewTime(Shooter);
+    if (ViewTime >= World->GetTimeSeconds())
+    {
+        return;
+    }
+
+    Subsystem = LagCompensation;
+    const APawn* ShooterPawn = Shooter->GetPawn();
+
+    int32 NumSkipped = 0;
+    for (const ULagCompensationSubsystem::FCharacterHistory& History : LagCompensation->Histories)
+    {
+        ACharacter* Character = History.Character.Get();
+        if (!Character || Character == ShooterPawn || !Character->GetActorEnableCollision())
+        {
+            continue;
+        }
+
+        FLagCompensationSample Sample;
+        if (!LagCompensation->SampleHistory(History, ViewTime, Sample))
+        {
+            continue;
+        }
+
+        if (Query && !IsInsideQuery(*Query, Sample.Location, Sample.CapsuleRadius + Sample.CapsuleHalfHeight))
+        {
+            ++NumSkipped;
+            continue;
+        }
+
+        FRewoundCharacter& Entry = Rewound.AddDefaulted_GetRef();
+        Entry.Character = Character;
+        ULagCompensationSubsystem::CaptureSample(Character, World->GetTimeSeconds(), Entry.Original, false);
+
+        // The rewound pose must never begin or end overlaps (checkpoints, pickups)
+        if (UCapsuleComponent* Capsule = Character->GetCapsuleComponent())
+        {
+            Entry.bCapsuleOverlaps = Capsule->GetGenerateOverlapEvents();
+            Capsule->SetGenerateOverlapEvents(false);
+        }
+        if (USkeletalMeshComponent* Mesh = Character->GetMesh())
+        {
+            Entry.bMeshOverlaps = Mesh->GetGenerateOverlapEvents();
+            Mesh->SetGenerateOverlapEvents(false);
+        }
+
+        ULagCompensationSubsystem::ApplySample(Character, Sample);
+    }
+
+    WorkCycles = FPlatformTime::Cycles() - StartCycles;
+
+    ++LagCompensation->TotalRewinds;
+    LagCompensation->TotalCharactersMoved += Rewound.Num();
+    LagCompensation->TotalCharactersSkipped += NumSkipped;
+    LagCompensation->MaxCharactersMoved = FMath::Max(LagCompensation->MaxCharactersMoved, Rewound.Num());
+    INC_DWORD_STAT(STAT_LagCompensationRewinds);
+    INC_DWORD_STAT_BY(STAT_LagCompensationCharactersMoved, Rewound.Num());
+}
+
+FScopedLagCompensation::~FScopedLagCompensation()
+{
+    ULagCompensationSubsystem* LagCompensation = Subsystem.Get();
+    if (!LagCompensation)
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_LagCompensationRestore);
+    const uint32 StartCycles = FPlatformTime::Cycles();
+
+    for (const FRewoundCharacter& Entry : Rewound)
+    {
+        ACharacter* Character = Entry.Character.Get();
+        if (!Character)
+        {
+            continue;
+        }
+
+        ULagCompensationSubsystem::ApplySample(Character, Entry.Original);
+
+        if (UCapsuleComponent* Capsule = Character->GetCapsuleComponent())
+        {
+            Capsule->SetGenerateOverlapEvents(Entry.bCapsuleOverlaps);
+        }
+        if (USkeletalMeshComponent* Mesh = Character->GetMesh())
+        {
+            Mesh->SetGenerateOverlapEvents(Entry.bMeshOverlaps);
+        }
+    }
+
+    WorkCycles += FPlatformTime::Cycles() - StartCycles;
+    LagCompensation->TotalRewindCycles += WorkCycles;
+    LagCompensation->MaxRewindCycles = FMath::Max(LagCompensation->MaxRewindCycles, WorkCycles);
+}
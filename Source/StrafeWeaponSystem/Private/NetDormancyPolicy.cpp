@@ -0,0 +1,106 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "NetDormancyPolicy.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+#include "Engine/NetDriver.h"
+#include "Engine/NetworkObjectList.h"
+#include "HAL/IConsoleManager.h"
+
+namespace
+{
+    TAutoConsoleVariable<bool> CVarNetDormancy(
+        TEXT("Strafe.Net.Dormancy"),
+        true,
+        TEXT("Lets idle replicated actors (checkpoints, pickups, holstered weapons) go dormant. Applies to actors spawned or changed afterwards."),
+        ECVF_Default);
+
+    FAutoConsoleCommandWithWorld ReplicationReportCommand(
+        TEXT("Strafe.Net.ReplicationReport"),
+        TEXT("Logs how many replicated actors the server considers every net tick, how many are dormant, and the most common active classes."),
+        FConsoleCommandWithWorldDelegate::CreateStatic(&FNetDormancyPolicy::LogReplicationReport));
+
+    bool CanChangeDormancy(const AActor* Actor)
+    {
+        return Actor && Actor->HasAuthority() && Actor->GetIsReplicated() && Actor->GetNetMode() != NM_Standalone;
+    }
+}
+
+ENetDormancy FNetDormancyPolicy::GetInitialDormancy(ENetDormancy Requested)
+{
+    return CVarNetDormancy.GetValueOnGameThread() ? Requested : DORM_Awake;
+}
+
+void FNetDormancyPolicy::FlushStateChange(AActor* Actor)
+{
+    // FlushNetDormancy also turns DORM_Initial into DORM_DormantAll, which is what a changed startup actor needs
+    if (CanChangeDormancy(Actor) && Actor->NetDormancy > DORM_Awake)
+    {
+        Actor->FlushNetDormancy();
+    }
+}
+
+void FNetDormancyPolicy::Wake(AActor* Actor)
+{
+    if (CanChangeDormancy(Actor))
+    {
+        Actor->SetNetDormancy(DORM_Awake);
+    }
+}
+
+void FNetDormancyPolicy::Sleep(AActor* Actor)
+{
+    // The channel finishes sending what changed before it closes
+    if (CanChangeDormancy(Actor) && CVarNetDormancy.GetValueOnGameThread())
+    {
+        Actor->SetNetDormancy(DORM_DormantAll);
+    }
+}
+
+void FNetDormancyPolicy::LogReplicationReport(UWorld* World)
+{
+    UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr;
+    if (!NetDriver || !NetDriver->IsServer())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ReplicationReport: Only available on a server"));
+        return;
+    }
+
+    const FNetworkObjectList& ObjectList = NetDriver->GetNetworkObjectList();
+    const int32 TickRate = FMath::Max(NetDriver->GetNetServerMaxTickRate(), 1);
+
+    // Active objects are walked every net tick; the frequency-weighted figure is how many are due per tick
+    double DuePerTick = 0.0;
+    TMap<const UClass*, int32> ActiveByClass;
+    for (const TSharedPtr<FNetworkObjectInfo>& Info : ObjectList.GetActiveObjects())
+    {
+        const AActor* Actor = Info.IsValid() ? Info->Actor : nullptr;
+        if (!Actor)
+        {
+            continue;
+        }
+
+        DuePerTick += FMath::Min(Actor->GetNetUpdateFrequency() / TickRate, 1.0f);
+        ++ActiveByClass.FindOrAdd(Actor->GetClass());
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("ReplicationReport: Objects=%d Active=%d DormantOnAllConnections=%d DuePerNetTick=%.1f Connections=%d NetTickRate=%d Dormancy=%s"),
+        ObjectList.GetAllObjects().Num(), ObjectList.GetActiveObjects().Num(), ObjectList.GetDormantObjectsOnAllConnections().Num(),
+        DuePerTick, NetDriver->ClientConnections.Num(), TickRate, CVarNetDormancy.GetValueOnGameThread() ? TEXT("On") : TEXT("Off"));
+
+    // Run the same map once with -UseIrisReplication=0 and once with =1 to compare the two paths
+    const TCHAR* ReplicationSystem = NetDriver->IsUsingIrisReplication() ? TEXT("Iris") : NetDriver->GetReplicationDriver() ? TEXT("ReplicationGraph") : TEXT("Legacy");
+    UE_LOG(LogTemp, Log, TEXT("ReplicationReport: Replication=%s OutBytesPerSecond=%u InBytesPerSecond=%u"),
+        ReplicationSystem, NetDriver->OutBytesPerSecond, NetDriver->InBytesPerSecond);
+
+    ActiveByClass.ValueSort(TGreater<int32>());
+    int32 NumLogged = 0;
+    for (const TPair<const UClass*, int32>& Entry : ActiveByClass)
+    {
+        UE_LOG(LogTemp, Log, TEXT("ReplicationReport:   %5d %s"), Entry.Value, *GetNameSafe(Entry.Key));
+        if (++NumLogged == 10)
+        {
+            break;
+        }
+    }
+}
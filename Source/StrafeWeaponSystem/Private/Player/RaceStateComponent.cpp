@@ -1,5 +1,6 @@
 #include "Player/RaceStateComponent.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 #include "TimerManager.h"
 #include "GameFramework/PlayerState.h"
 #include "Kismet/GameplayStatics.h" // For GEngine
@@ -18,11 +19,15 @@ URaceStateComponent::URaceStateComponent()
 void URaceStateComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-	DOREPLIFETIME(URaceStateComponent, CurrentRaceTime);
-	DOREPLIFETIME(URaceStateComponent, CurrentSplitTimes);
-	DOREPLIFETIME(URaceStateComponent, BestRaceTime);
-	DOREPLIFETIME(URaceStateComponent, LastCheckpointReached);
-	DOREPLIFETIME(URaceStateComponent, bIsRaceActiveForPlayer);
+
+	// Push model: every write below marks its property dirty, so the server never compares these
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(URaceStateComponent, CurrentRaceTime, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(URaceStateComponent, CurrentSplitTimes, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(URaceStateComponent, BestRaceTime, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(URaceStateComponent, LastCheckpointReached, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(URaceStateComponent, bIsRaceActiveForPlayer, Params);
 }
 
 void URaceStateComponent::BeginPlay()
@@ -45,6 +50,10 @@ void URaceStateComponent::StartRace()
 		CurrentSplitTimes.Empty();
 		LastCheckpointReached = -1; // Start line is usually index 0, so -1 means not even start is hit.
 		bIsRaceActiveForPlayer = true;
+		MARK_PROPERTY_DIRTY_FROM_NAME(URaceStateComponent, CurrentRaceTime, this);
+		MARK_PROPERTY_DIRTY_FROM_NAME(URaceStateComponent, CurrentSplitTimes, this);
+		MARK_PROPERTY_DIRTY_FROM_NAME(URaceStateComponent, LastCheckpointReached, this);
+		MARK_PROPERTY_DIRTY_FROM_NAME(URaceStateComponent, bIsRaceActiveForPlayer, this);
 
 		GetWorld()->GetTimerManager().SetTimer(RaceTimerHandle, this, &URaceStateComponent::UpdateTimer, 0.01f, true);
 
@@ -69,6 +78,8 @@ void URaceStateComponent::ReachedCheckpoint(int32 CheckpointIndex, int32 TotalCh
 		{
 			LastCheckpointReached = CheckpointIndex;
 			CurrentSplitTimes.Add(CurrentRaceTime);
+			MARK_PROPERTY_DIRTY_FROM_NAME(URaceStateComponent, LastCheckpointReached, this);
+			MARK_PROPERTY_DIRTY_FROM_NAME(URaceStateComponent, CurrentSplitTimes, this);
 			//UE_LOG(LogTemp, Warning, TEXT("Player %s reached checkpoint %d at time %f. Total Splits: %d"), *GetOwner()->GetName(), CheckpointIndex, CurrentRaceTime, CurrentSplitTimes.Num());
 
 			OnRep_LastCheckpointReached(); // For server
@@ -103,6 +114,7 @@ void URaceStateComponent::FinishedRace(int32 FinalCheckpointIndex, int32 TotalCh
 		{
 			UE_LOG(LogTemp, Warning, TEXT("URaceStateComponent::FinishedRace - CONDITIONS MET for %s! Processing finish."), *GetOwner()->GetName());
 			bIsRaceActiveForPlayer = false;
+			MARK_PROPERTY_DIRTY_FROM_NAME(URaceStateComponent, bIsRaceActiveForPlayer, this);
 			GetWorld()->GetTimerManager().ClearTimer(RaceTimerHandle);
 
 			// UE_LOG(LogTemp, Warning, TEXT("Player %s finished race at time %f."), *GetOwner()->GetName(), CurrentRaceTime); // Already logged above effectively
@@ -112,6 +124,7 @@ void URaceStateComponent::FinishedRace(int32 FinalCheckpointIndex, int32 TotalCh
 				UE_LOG(LogTemp, Warning, TEXT("Player %s got a NEW BEST TIME! New: %f, Old was: %f"), *GetOwner()->GetName(), CurrentRaceTime, BestRaceTime.TotalTime);
 				BestRaceTime.TotalTime = CurrentRaceTime;
 				BestRaceTime.SplitTimes = CurrentSplitTimes;
+				MARK_PROPERTY_DIRTY_FROM_NAME(URaceStateComponent, BestRaceTime, this);
 				if (GetOwner() && GetOwner()->HasAuthority()) // Ensure server directly triggers its own OnRep logic if effects are desired immediately
 				{
 					OnRep_BestRaceTime();
@@ -154,6 +167,10 @@ void URaceStateComponent::ResetRaceState()
 		CurrentSplitTimes.Empty();
 		LastCheckpointReached = -1;
 		bIsRaceActiveForPlayer = false;
+		MARK_PROPERTY_DIRTY_FROM_NAME(URaceStateComponent, CurrentRaceTime, this);
+		MARK_PROPERTY_DIRTY_FROM_NAME(URaceStateComponent, CurrentSplitTimes, this);
+		MARK_PROPERTY_DIRTY_FROM_NAME(URaceStateComponent, LastCheckpointReached, this);
+		MARK_PROPERTY_DIRTY_FROM_NAME(URaceStateComponent, bIsRaceActiveForPlayer, this);
 		GetWorld()->GetTimerManager().ClearTimer(RaceTimerHandle);
 
 		OnRep_IsRaceActiveForPlayer();
@@ -169,6 +186,7 @@ void URaceStateComponent::UpdateTimer()
 	if (GetOwner() && GetOwner()->HasAuthority() && bIsRaceActiveForPlayer)
 	{
 		CurrentRaceTime += GetWorld()->GetTimerManager().GetTimerElapsed(RaceTimerHandle);
+		MARK_PROPERTY_DIRTY_FROM_NAME(URaceStateComponent, CurrentRaceTime, this);
 		// No need to call OnRep_CurrentRaceTime here every tick, it's replicated.
 		// Clients will get updated CurrentRaceTime. The HUD will poll this.
 		// If you want more frequent updates for server-side logic based on time, this is fine.
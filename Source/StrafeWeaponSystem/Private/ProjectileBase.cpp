@@ -1,6 +1,12 @@
 #include "ProjectileBase.h"
+#include "ProjectilePoolSubsystem.h"
+#include "ProjectileSimulationSubsystem.h"
+#include "ProjectileSpawnReplicator.h"
+#include "ExplosionResolver.h"
+#include "ExplosionQueueSubsystem.h"
 #include "BaseWeapon.h"
 #include "WeaponDataAsset.h"
+#include "NetDormancyPolicy.h"
 #include "Components/SphereComponent.h"
 #include "GameFramework/ProjectileMovementComponent.h"
 #include "GameFramework/DamageType.h"
@@ -10,6 +16,7 @@
 #include "Kismet/GameplayStatics.h"
 #include "DrawDebugHelpers.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 #include "Engine/World.h"
 #include "Engine/EngineTypes.h"
 #include "TimerManager.h"
@@ -19,7 +26,9 @@
 
 AProjectileBase::AProjectileBase()
 {
-    PrimaryActorTick.bCanEverTick = false;
+    // Only ticks while blending out a predicted-projectile handoff
+    PrimaryActorTick.bCanEverTick = true;
+    PrimaryActorTick.bStartWithTickEnabled = false;
     bReplicates = true;
     SetReplicateMovement(true);
 
@@ -49,36 +58,192 @@ void AProjectileBase::BeginPlay()
 {
     Super::BeginPlay();
 
+    if (!bPoolActive)
+    {
+        // Spawned parked by the pool (or replicated to a client while parked)
+        ApplyPoolActiveState();
+        return;
+    }
+
+    // Pooled projectiles are started by ActivateFromPool instead
+    if (!bManagedByPool)
+    {
+        StartProjectile();
+    }
+}
+
+void AProjectileBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (OwningWeapon)
+    {
+        OwningWeapon->UnregisterProjectile(this);
+    }
+
+    if (IsBatchSimulated())
+    {
+        if (UProjectileSimulationSubsystem* Simulation = GetWorld()->GetSubsystem<UProjectileSimulationSubsystem>())
+        {
+            Simulation->RemoveProjectile(this);
+        }
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void AProjectileBase::Tick(float DeltaSeconds)
+{
+    Super::Tick(DeltaSeconds);
+
+    HandoffBlendRemaining -= DeltaSeconds;
+    if (HandoffBlendRemaining <= 0.0f || !ProjectileMesh)
+    {
+        if (ProjectileMesh)
+        {
+            ProjectileMesh->SetRelativeLocation(HandoffMeshRelativeLocation);
+        }
+        SetActorTickEnabled(false);
+        return;
+    }
+
+    const float Alpha = HandoffBlendRemaining / FMath::Max(HandoffBlendTime, KINDA_SMALL_NUMBER);
+    ProjectileMesh->SetWorldLocation(GetActorTransform().TransformPosition(HandoffMeshRelativeLocation) + HandoffOffset * Alpha);
+}
+
+AProjectileBase* AProjectileBase::SpawnLocalProjectile(UWorld* World, TSubclassOf<AProjectileBase> ProjectileClass, const FTransform& SpawnTransform)
+{
+    if (!World || !ProjectileClass)
+    {
+        return nullptr;
+    }
+
+    AProjectileBase* Projectile = World->SpawnActorDeferred<AProjectileBase>(ProjectileClass, SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+    if (Projectile)
+    {
+        Projectile->SetReplicates(false);
+        Projectile->SetRole(ROLE_SimulatedProxy);
+        Projectile->FinishSpawning(SpawnTransform);
+    }
+    return Projectile;
+}
+
+void AProjectileBase::BeginHandoffBlend(const FVector& VisualLocation, float BlendTime)
+{
+    if (!ProjectileMesh || BlendTime <= 0.0f)
+    {
+        return;
+    }
+
+    if (HandoffBlendRemaining <= 0.0f)
+    {
+        HandoffMeshRelativeLocation = ProjectileMesh->GetRelativeLocation();
+    }
+
+    HandoffOffset = VisualLocation - GetActorTransform().TransformPosition(HandoffMeshRelativeLocation);
+    HandoffBlendTime = BlendTime;
+    HandoffBlendRemaining = BlendTime;
+    ProjectileMesh->SetWorldLocation(VisualLocation);
+    SetActorTickEnabled(true);
+}
+
+void AProjectileBase::FastForward(float Seconds)
+{
+    if (Seconds <= 0.0f || !ProjectileMovement || !ProjectileMovement->UpdatedComponent || ProjectileMovement->Velocity.IsNearlyZero())
+    {
+        return;
+    }
+
+    const FVector Velocity = ProjectileMovement->Velocity;
+    const FVector Gravity(0.0f, 0.0f, ProjectileMovement->GetGravityZ());
+    SetActorLocation(GetActorLocation() + Velocity * Seconds + 0.5f * Gravity * Seconds * Seconds, true);
+    ProjectileMovement->Velocity = Velocity + Gravity * Seconds;
+    ProjectileMovement->UpdateComponentVelocity();
+}
+
+void AProjectileBase::PostNetReceiveLocationAndRotation()
+{
+    Super::PostNetReceiveLocationAndRotation();
+
+    // Every movement update is as old as the first one was; keep running ahead of it by the same lead
+    if (PredictionLeadTime > 0.0f && bPoolActive)
+    {
+        FastForward(PredictionLeadTime);
+    }
+}
+
+void AProjectileBase::OnRep_PredictionKeyId()
+{
+    PredictionLeadTime = 0.0f;
+    if (PredictionKeyId == 0 || !OwningWeapon || !bPoolActive)
+    {
+        return;
+    }
+
+    if (AProjectileBase* Predicted = OwningWeapon->TakePredictedProjectile(PredictionKeyId))
+    {
+        // Our replicated position trails the predicted copy by about half a round trip along the same path.
+        // Fast-forward by that much instead of sliding back in time; the blend only hides what's left over.
+        const FVector Velocity = GetProjectileVelocity();
+        const float Speed = Velocity.Size();
+        if (Speed > KINDA_SMALL_NUMBER)
+        {
+            const float Lead = FVector::DotProduct(Predicted->GetActorLocation() - GetActorLocation(), Velocity / Speed) / Speed;
+            PredictionLeadTime = FMath::Clamp(Lead, 0.0f, OwningWeapon->GetPredictedProjectileTimeout());
+            FastForward(PredictionLeadTime);
+        }
+
+        BeginHandoffBlend(Predicted->ProjectileMesh ? Predicted->ProjectileMesh->GetComponentLocation() : Predicted->GetActorLocation(),
+            OwningWeapon->GetPredictedProjectileBlendTime());
+        Predicted->Destroy();
+    }
+}
+
+void AProjectileBase::StartProjectile()
+{
     OnProjectileSpawned();
 
     if (MaxLifetime > 0.0f)
     {
-        GetWorld()->GetTimerManager().SetTimer(
-            LifetimeTimer,
-            this,
-            &AProjectileBase::SelfDestruct,
-            MaxLifetime,
-            false
-        );
+        ArmLifetimeTimer(MaxLifetime);
     }
 }
 
+void AProjectileBase::ArmLifetimeTimer(float Seconds)
+{
+    GetWorld()->GetTimerManager().SetTimer(
+        LifetimeTimer,
+        this,
+        &AProjectileBase::SelfDestruct,
+        Seconds,
+        false
+    );
+}
+
 void AProjectileBase::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
     Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-    DOREPLIFETIME(AProjectileBase, ProjectileOwner);
-    DOREPLIFETIME(AProjectileBase, OwningWeapon);
+    // All push based: they only change when the pool hands the projectile out or takes it back
+    FDoRepLifetimeParams Params;
+    Params.bIsPushBased = true;
+    DOREPLIFETIME_WITH_PARAMS_FAST(AProjectileBase, OwningWeapon, Params);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AProjectileBase, bPoolActive, Params);
+
+    // Controllers only exist on their owning client; nobody else could resolve the reference
+    Params.Condition = COND_OwnerOnly;
+    DOREPLIFETIME_WITH_PARAMS_FAST(AProjectileBase, ProjectileOwner, Params);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AProjectileBase, PredictionKeyId, Params);
 }
 
-void AProjectileBase::InitializeProjectile(AController* NewOwner, ABaseWeapon* Weapon, const UWeaponDataAsset* InWeaponData)
+void AProjectileBase::InitializeProjectile(AController* NewOwner, ABaseWeapon* Weapon, const UWeaponDataAsset* InWeaponData, bool bRegisterWithWeapon)
 {
     ProjectileOwner = NewOwner;
     OwningWeapon = Weapon;
     OwningWeaponData = InWeaponData;
+    MARK_PROPERTY_DIRTY_FROM_NAME(AProjectileBase, ProjectileOwner, this);
+    MARK_PROPERTY_DIRTY_FROM_NAME(AProjectileBase, OwningWeapon, this);
 
     // Register with weapon
-    if (OwningWeapon)
+    if (OwningWeapon && bRegisterWithWeapon)
     {
         OwningWeapon->RegisterProjectile(this);
     }
@@ -89,6 +254,81 @@ void AProjectileBase::InitializeProjectile(AController* NewOwner, ABaseWeapon* W
         CollisionComp->IgnoreActorWhenMoving(OwnerActor, true);
         CollisionComp->MoveIgnoreActors.Add(OwnerActor);
     }
+
+    // Hand authority-side movement to the batched simulation when the weapon opts in
+    // Spawn-record projectiles don't replicate as actors; clients build their own proxy from the record
+    if (HasAuthority())
+    {
+        const bool bSpawnRecord = OwningWeaponData && OwningWeaponData->WeaponStats.ReplicationMode == EProjectileReplicationMode::SpawnRecord;
+        AProjectileSpawnReplicator* Replicator = bSpawnRecord ? GetSpawnReplicator() : nullptr;
+
+        SpawnRecordId = Replicator ? Replicator->AddRecord(this, ProjectileMovement->Velocity) : INDEX_NONE;
+
+        // Pooled actors were spawned for one mode and keep it; only a fresh actor switches before its first replication
+        const bool bReplicateActor = SpawnRecordId == INDEX_NONE;
+        if (!bManagedByPool && GetIsReplicated() != bReplicateActor)
+        {
+            SetReplicates(bReplicateActor);
+        }
+    }
+
+    const EProjectileSimulationMode SimulationMode = OwningWeaponData ? OwningWeaponData->WeaponStats.SimulationMode : EProjectileSimulationMode::MovementComponent;
+    if (HasAuthority() && SimulationMode != EProjectileSimulationMode::MovementComponent)
+    {
+        if (UProjectileSimulationSubsystem* Simulation = GetWorld()->GetSubsystem<UProjectileSimulationSubsystem>())
+        {
+            Simulation->AddProjectile(this, ProjectileMovement->Velocity, SimulationMode == EProjectileSimulationMode::Analytic);
+        }
+    }
+}
+
+FVector AProjectileBase::GetProjectileVelocity() const
+{
+    if (IsBatchSimulated())
+    {
+        if (const UProjectileSimulationSubsystem* Simulation = GetWorld()->GetSubsystem<UProjectileSimulationSubsystem>())
+        {
+            return Simulation->GetVelocity(this);
+        }
+    }
+    return ProjectileMovement ? ProjectileMovement->Velocity : FVector::ZeroVector;
+}
+
+void AProjectileBase::SetProjectileVelocity(const FVector& NewVelocity)
+{
+    if (IsBatchSimulated())
+    {
+        if (UProjectileSimulationSubsystem* Simulation = GetWorld()->GetSubsystem<UProjectileSimulationSubsystem>())
+        {
+            Simulation->SetVelocity(this, NewVelocity);
+            return;
+        }
+    }
+    if (ProjectileMovement)
+    {
+        ProjectileMovement->Velocity = NewVelocity;
+    }
+}
+
+void AProjectileBase::StopProjectileMovement()
+{
+    if (IsBatchSimulated())
+    {
+        if (UProjectileSimulationSubsystem* Simulation = GetWorld()->GetSubsystem<UProjectileSimulationSubsystem>())
+        {
+            Simulation->RemoveProjectile(this);
+        }
+        CollisionComp->ComponentVelocity = FVector::ZeroVector;
+    }
+    if (ProjectileMovement)
+    {
+        ProjectileMovement->StopMovementImmediately();
+    }
+}
+
+void AProjectileBase::HandleSimulatedHit(const FHitResult& Hit)
+{
+    OnHit(CollisionComp, Hit.GetActor(), Hit.GetComponent(), FVector::ZeroVector, Hit);
 }
 
 void AProjectileBase::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor,
@@ -110,13 +350,25 @@ void AProjectileBase::Detonate()
 {
     if (!HasAuthority())
     {
-        ServerDetonate();
+        if (OwningWeapon)
+        {
+            OwningWeapon->QueueClientDetonation(this);
+        }
         return;
     }
 
     FVector ExplosionLocation = GetActorLocation();
     ApplyExplosionDamageAndImpulse(ExplosionLocation);
 
+    if (SpawnRecordId != INDEX_NONE)
+    {
+        if (AProjectileSpawnReplicator* Replicator = GetSpawnReplicator())
+        {
+            Replicator->MarkDetonated(SpawnRecordId, ExplosionLocation);
+        }
+        SpawnRecordId = INDEX_NONE;
+    }
+
     // Execute explosion gameplay cue instead of multicast
     if (OwningWeaponData && OwningWeaponData->ExplosionEffectCueTag.IsValid())
     {
@@ -133,17 +385,7 @@ void AProjectileBase::Detonate()
         }
     }
 
-    if (OwningWeapon)
-    {
-        OwningWeapon->UnregisterProjectile(this);
-    }
-
-    Destroy();
-}
-
-void AProjectileBase::ServerDetonate_Implementation()
-{
-    Detonate();
+    ReleaseProjectile();
 }
 
 void AProjectileBase::ApplyExplosionDamageAndImpulse(FVector ExplosionLocation)
@@ -157,102 +399,207 @@ void AProjectileBase::ApplyExplosionDamageAndImpulse(FVector ExplosionLocation)
     }
 #endif
 
-    // Apply radial damage - this handles both damage and impulse
-    TArray<AActor*> IgnoredActors;
-    if (ExplosionParams.bIgnoreOwner && GetOwner())
+    FExplosionInstance Explosion;
+    Explosion.Location = ExplosionLocation;
+    Explosion.Params = ExplosionParams;
+    Explosion.DamageCauser = this;
+    Explosion.InstigatorController = ProjectileOwner;
+    Explosion.SelfActor = GetInstigator();
+    Explosion.IgnoredActor = GetOwner();
+    Explosion.DamageTypeClass = UDamageType::StaticClass();
+
+    // Batched with every other detonation this frame; falls back to resolving right away
+    if (UExplosionQueueSubsystem* ExplosionQueue = GetWorld()->GetSubsystem<UExplosionQueueSubsystem>())
+    {
+        ExplosionQueue->QueueExplosion(Explosion);
+    }
+    else
     {
-        IgnoredActors.Add(GetOwner());
+        FExplosionResolver::ResolveExplosion(GetWorld(), Explosion);
     }
+}
 
-    // Apply radial damage with falloff
-    UGameplayStatics::ApplyRadialDamageWithFalloff(
-        GetWorld(),
-        ExplosionParams.BaseDamage,
-        ExplosionParams.MinimumDamage,
-        ExplosionLocation,
-        ExplosionParams.InnerRadius,
-        ExplosionParams.OuterRadius,
-        ExplosionParams.DamageFalloff,
-        UDamageType::StaticClass(),
-        IgnoredActors,
-        this,
-        ProjectileOwner,
-        ECollisionChannel::ECC_Visibility // Damage trace channel
-    );
+void AProjectileBase::MulticastExplosionEffects_Implementation(FVector Location)
+{
+    OnExplosion(Location);
+}
 
-    // Apply additional impulse for better rocket jumping
-    // The radial damage doesn't always provide enough impulse for movement
-    TArray<FHitResult> HitResults;
-    FCollisionShape CollisionShape = FCollisionShape::MakeSphere(ExplosionParams.OuterRadius);
-
-    GetWorld()->SweepMultiByChannel(
-        HitResults,
-        ExplosionLocation,
-        ExplosionLocation,
-        FQuat::Identity,
-        ECollisionChannel::ECC_Pawn,
-        CollisionShape
-    );
+void AProjectileBase::SelfDestruct()
+{
+    if (HasAuthority())
+    {
+        ReleaseProjectile();
+    }
+}
 
-    for (const FHitResult& Hit : HitResults)
+void AProjectileBase::NotifyStuck()
+{
+    if (SpawnRecordId != INDEX_NONE)
     {
-        AActor* HitActor = Hit.GetActor();
-        if (!HitActor || (ExplosionParams.bIgnoreOwner && HitActor == GetOwner()))
-            continue;
+        if (AProjectileSpawnReplicator* Replicator = GetSpawnReplicator())
+        {
+            Replicator->MarkStuck(SpawnRecordId, GetActorLocation());
+        }
+    }
+}
 
-        // Calculate distance and falloff
-        float Distance = FVector::Dist(ExplosionLocation, HitActor->GetActorLocation());
-        float Alpha = FMath::Clamp((ExplosionParams.OuterRadius - Distance) /
-            (ExplosionParams.OuterRadius - ExplosionParams.InnerRadius), 0.0f, 1.0f);
+void AProjectileBase::ReleaseProjectile()
+{
+    StopProjectileMovement();
 
-        // Apply falloff curve
-        float FalloffMultiplier = FMath::Pow(Alpha, ExplosionParams.DamageFalloff);
+    // Fizzled without an event: clients just drop their proxy
+    if (SpawnRecordId != INDEX_NONE)
+    {
+        if (AProjectileSpawnReplicator* Replicator = GetSpawnReplicator())
+        {
+            Replicator->RemoveRecord(SpawnRecordId);
+        }
+        SpawnRecordId = INDEX_NONE;
+    }
 
-        // Check for self damage
-        bool bIsSelfDamage = (HitActor == GetInstigator());
+    if (OwningWeapon)
+    {
+        OwningWeapon->UnregisterProjectile(this);
+    }
 
-        // Apply impulse to characters for rocket jumping
-        if (ACharacter* Character = Cast<ACharacter>(HitActor))
-        {
-            if (UCharacterMovementComponent* MovementComp = Character->GetCharacterMovement())
-            {
-                FVector LaunchDirection = (Character->GetActorLocation() - ExplosionLocation).GetSafeNormal();
-                LaunchDirection.Z = FMath::Abs(LaunchDirection.Z) + 0.3f; // Add upward bias for better jumping
-                LaunchDirection.Normalize();
+    UWorld* World = GetWorld();
+    UProjectilePoolSubsystem* Pool = bManagedByPool && World ? World->GetSubsystem<UProjectilePoolSubsystem>() : nullptr;
+    if (Pool)
+    {
+        Pool->ReleaseProjectile(this);
+    }
+    else
+    {
+        Destroy();
+    }
+}
 
-                float LaunchMultiplier = bIsSelfDamage ? ExplosionParams.SelfImpulseMultiplier : 1.0f;
-                float LaunchMagnitude = ExplosionParams.ImpulseStrength * FalloffMultiplier * LaunchMultiplier;
+AProjectileSpawnReplicator* AProjectileBase::GetSpawnReplicator() const
+{
+    // The pool is gone during world teardown, and absent in worlds that don't support it
+    UWorld* World = GetWorld();
+    UProjectilePoolSubsystem* Pool = World ? World->GetSubsystem<UProjectilePoolSubsystem>() : nullptr;
+    return Pool ? Pool->GetSpawnReplicator() : nullptr;
+}
 
-                Character->LaunchCharacter(LaunchDirection * LaunchMagnitude, true, true);
-            }
-        }
-        // Apply impulse to physics objects
-        else if (UPrimitiveComponent* PrimComp = Cast<UPrimitiveComponent>(HitActor->GetRootComponent()))
-        {
-            if (PrimComp->IsSimulatingPhysics())
-            {
-                FVector ImpulseDirection = (HitActor->GetActorLocation() - ExplosionLocation).GetSafeNormal();
-                float ImpulseMagnitude = ExplosionParams.ImpulseStrength * FalloffMultiplier;
+void AProjectileBase::ActivateFromPool(const FTransform& SpawnTransform, AController* NewOwner, ABaseWeapon* Weapon, const UWeaponDataAsset* InWeaponData)
+{
+    // Reopens the channel that went dormant when we were parked; everything below goes out in its first update
+    FNetDormancyPolicy::Wake(this);
 
-                PrimComp->AddImpulseAtLocation(ImpulseDirection * ImpulseMagnitude, ExplosionLocation);
-            }
-        }
+    ResetProjectileState();
+
+    SetActorLocationAndRotation(SpawnTransform.GetLocation(), SpawnTransform.GetRotation(), false, nullptr, ETeleportType::ResetPhysics);
+
+    bPoolActive = true;
+    MARK_PROPERTY_DIRTY_FROM_NAME(AProjectileBase, bPoolActive, this);
+    // The pool sets the prediction key just before handing the projectile out
+    MARK_PROPERTY_DIRTY_FROM_NAME(AProjectileBase, PredictionKeyId, this);
+    ApplyPoolActiveState();
+
+    if (ProjectileMovement)
+    {
+        // StopSimulating() on a previous impact clears the updated component
+        ProjectileMovement->SetUpdatedComponent(CollisionComp);
+        ProjectileMovement->Velocity = GetActorForwardVector() * ProjectileMovement->InitialSpeed;
+        ProjectileMovement->UpdateComponentVelocity();
     }
+
+    InitializeProjectile(NewOwner, Weapon, InWeaponData);
+    StartProjectile();
+
+    ForceNetUpdate();
 }
 
-void AProjectileBase::MulticastExplosionEffects_Implementation(FVector Location)
+void AProjectileBase::DeactivateToPool()
 {
-    OnExplosion(Location);
+    GetWorldTimerManager().ClearTimer(LifetimeTimer);
+
+    // Sticky projectiles may still be attached to whatever they hit
+    DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+
+    bPoolActive = false;
+    ApplyPoolActiveState();
+
+    ProjectileOwner = nullptr;
+    OwningWeapon = nullptr;
+    PredictionKeyId = 0;
+    MARK_PROPERTY_DIRTY_FROM_NAME(AProjectileBase, bPoolActive, this);
+    MARK_PROPERTY_DIRTY_FROM_NAME(AProjectileBase, ProjectileOwner, this);
+    MARK_PROPERTY_DIRTY_FROM_NAME(AProjectileBase, OwningWeapon, this);
+    MARK_PROPERTY_DIRTY_FROM_NAME(AProjectileBase, PredictionKeyId, this);
+    OwningWeaponData = nullptr;
+    SetOwner(nullptr);
+    SetInstigator(nullptr);
+
+    // Clients get the parked state once, then the actor costs nothing until it is reused
+    ForceNetUpdate();
+    FNetDormancyPolicy::Sleep(this);
 }
 
-void AProjectileBase::SelfDestruct()
+void AProjectileBase::ResetProjectileState()
 {
-    if (HasAuthority())
+    const AProjectileBase* Defaults = GetClass()->GetDefaultObject<AProjectileBase>();
+    bExplodeOnImpact = Defaults->bExplodeOnImpact;
+
+    GetWorldTimerManager().ClearTimer(LifetimeTimer);
+
+    // Drop the previous owner's pawn from the ignore list
+    if (CollisionComp)
     {
-        if (OwningWeapon)
+        CollisionComp->ClearMoveIgnoreActors();
+    }
+}
+
+void AProjectileBase::ApplyPoolActiveState()
+{
+    SetActorHiddenInGame(!bPoolActive);
+    SetActorEnableCollision(bPoolActive);
+
+    if (ProjectileMovement)
+    {
+        if (bPoolActive)
         {
-            OwningWeapon->UnregisterProjectile(this);
+            ProjectileMovement->Activate(true);
         }
-        Destroy();
+        else
+        {
+            ProjectileMovement->StopMovementImmediately();
+            ProjectileMovement->Deactivate();
+        }
+    }
+}
+
+void AProjectileBase::OnRep_OwningWeapon(ABaseWeapon* PreviousWeapon)
+{
+    if (PreviousWeapon)
+    {
+        PreviousWeapon->UnregisterProjectile(this);
+    }
+    if (OwningWeapon)
+    {
+        OwningWeapon->RegisterProjectile(this);
+    }
+}
+
+void AProjectileBase::OnRep_PoolActive()
+{
+    if (!bPoolActive)
+    {
+        PredictionLeadTime = 0.0f;
+    }
+
+    if (bPoolActive && ProjectileMovement)
+    {
+        // Pick up the launch velocity from the same bunch so the simulated proxy doesn't stall
+        ProjectileMovement->SetUpdatedComponent(CollisionComp);
+        ProjectileMovement->Velocity = GetReplicatedMovement().LinearVelocity;
+    }
+
+    ApplyPoolActiveState();
+
+    if (bPoolActive)
+    {
+        OnProjectileSpawned();
     }
 }
\ No newline at end of file
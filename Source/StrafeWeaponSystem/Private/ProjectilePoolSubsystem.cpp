@@ -0,0 +1,208 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ProjectilePoolSubsystem.h"
+#include "ProjectileBase.h"
+#include "ProjectileSpawnReplicator.h"
+#include "BaseWeapon.h"
+#include "WeaponDataAsset.h"
+#include "NetDormancyPolicy.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+namespace
+{
+    FAutoConsoleCommandWithWorld DumpProjectilePoolCommand(
+        TEXT("Strafe.ProjectilePool.Dump"),
+        TEXT("Logs hit/miss/release counters of the projectile pool for the current world."),
+        FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+        {
+            if (const UProjectilePoolSubsystem* Pool = World ? World->GetSubsystem<UProjectilePoolSubsystem>() : nullptr)
+            {
+                Pool->LogPoolStats();
+            }
+        }));
+}
+
+bool UProjectilePoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UProjectilePoolSubsystem::Deinitialize()
+{
+    // Parked actors are owned by the world and go away with it
+    Pools.Empty();
+
+    Super::Deinitialize();
+}
+
+void UProjectilePoolSubsystem::PrewarmPool(TSubclassOf<AProjectileBase> ProjectileClass, int32 Count, bool bReplicated)
+{
+    UWorld* World = GetWorld();
+    if (!ProjectileClass || Count <= 0 || !World || World->GetNetMode() == NM_Client)
+    {
+        return;
+    }
+
+    FProjectilePool& Pool = Pools.FindOrAdd(ProjectileClass);
+    TArray<TObjectPtr<AProjectileBase>>& Available = Pool.GetAvailable(bReplicated);
+    const int32 TargetCount = FMath::Min(Count, MaxPooledPerClass);
+
+    while (Available.Num() < TargetCount)
+    {
+        AProjectileBase* Projectile = SpawnPooledProjectile(ProjectileClass, FTransform::Identity, bReplicated);
+        if (!Projectile)
+        {
+            break;
+        }
+        Available.Add(Projectile);
+    }
+
+    Pool.Stats.Available = Pool.Available.Num() + Pool.AvailableUnreplicated.Num();
+}
+
+AProjectileBase* UProjectilePoolSubsystem::AcquireProjectile(TSubclassOf<AProjectileBase> ProjectileClass, const FTransform& SpawnTransform,
+    AActor* NewOwner, APawn* NewInstigator, AController* ProjectileOwner, ABaseWeapon* Weapon, const UWeaponDataAsset* WeaponData,
+    int16 PredictionKeyId)
+{
+    if (!ProjectileClass)
+    {
+        return nullptr;
+    }
+
+    FProjectilePool& Pool = Pools.FindOrAdd(ProjectileClass);
+
+    // Spawn-record projectiles are shown to clients through their record, never as an actor
+    const bool bReplicated = !WeaponData || WeaponData->WeaponStats.ReplicationMode != EProjectileReplicationMode::SpawnRecord;
+    TArray<TObjectPtr<AProjectileBase>>& Available = Pool.GetAvailable(bReplicated);
+
+    AProjectileBase* Projectile = nullptr;
+    while (!Projectile && Available.Num() > 0)
+    {
+        // Anything destroyed behind our back (level streaming, GC) is simply skipped
+        AProjectileBase* Candidate = Available.Pop(EAllowShrinking::No);
+        if (IsValid(Candidate))
+        {
+            Projectile = Candidate;
+        }
+    }
+
+    if (Projectile)
+    {
+        ++Pool.Stats.Hits;
+    }
+    else
+    {
+        ++Pool.Stats.Misses;
+        Projectile = SpawnPooledProjectile(ProjectileClass, SpawnTransform, bReplicated);
+        if (!Projectile)
+        {
+            return nullptr;
+        }
+    }
+
+    Pool.Stats.Available = Pool.Available.Num() + Pool.AvailableUnreplicated.Num();
+
+    Projectile->SetOwner(NewOwner);
+    Projectile->SetInstigator(NewInstigator);
+    Projectile->PredictionKeyId = PredictionKeyId;
+    Projectile->ActivateFromPool(SpawnTransform, ProjectileOwner, Weapon, WeaponData);
+
+    return Projectile;
+}
+
+void UProjectilePoolSubsystem::ReleaseProjectile(AProjectileBase* Projectile)
+{
+    if (!IsValid(Projectile))
+    {
+        return;
+    }
+
+    FProjectilePool& Pool = Pools.FindOrAdd(Projectile->GetClass());
+    ++Pool.Stats.Releases;
+
+    TArray<TObjectPtr<AProjectileBase>>& Available = Pool.GetAvailable(Projectile->GetIsReplicated());
+    if (Available.Num() >= MaxPooledPerClass)
+    {
+        ++Pool.Stats.Overflows;
+        Projectile->Destroy();
+        return;
+    }
+
+    Projectile->DeactivateToPool();
+    Available.Add(Projectile);
+    Pool.Stats.Available = Pool.Available.Num() + Pool.AvailableUnreplicated.Num();
+}
+
+FProjectilePoolStats UProjectilePoolSubsystem::GetPoolStats(TSubclassOf<AProjectileBase> ProjectileClass) const
+{
+    const FProjectilePool* Pool = Pools.Find(ProjectileClass);
+    return Pool ? Pool->Stats : FProjectilePoolStats();
+}
+
+FProjectilePoolStats UProjectilePoolSubsystem::GetTotalPoolStats() const
+{
+    FProjectilePoolStats Total;
+    for (const TPair<TSubclassOf<AProjectileBase>, FProjectilePool>& Pair : Pools)
+    {
+        Total.Hits += Pair.Value.Stats.Hits;
+        Total.Misses += Pair.Value.Stats.Misses;
+        Total.Releases += Pair.Value.Stats.Releases;
+        Total.Overflows += Pair.Value.Stats.Overflows;
+        Total.Available += Pair.Value.Stats.Available;
+    }
+    return Total;
+}
+
+void UProjectilePoolSubsystem::LogPoolStats() const
+{
+    for (const TPair<TSubclassOf<AProjectileBase>, FProjectilePool>& Pair : Pools)
+    {
+        const FProjectilePoolStats& Stats = Pair.Value.Stats;
+        UE_LOG(LogTemp, Log, TEXT("ProjectilePool [%s]: Hits=%d Misses=%d Releases=%d Overflows=%d Available=%d"),
+            *GetNameSafe(Pair.Key), Stats.Hits, Stats.Misses, Stats.Releases, Stats.Overflows, Stats.Available);
+    }
+}
+
+AProjectileSpawnReplicator* UProjectilePoolSubsystem::GetSpawnReplicator()
+{
+    UWorld* World = GetWorld();
+    if (!IsValid(SpawnReplicator) && World && World->GetNetMode() != NM_Client)
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        SpawnReplicator = World->SpawnActor<AProjectileSpawnReplicator>(SpawnParams);
+    }
+    return SpawnReplicator;
+}
+
+void UProjectilePoolSubsystem::RegisterSpawnReplicator(AProjectileSpawnReplicator* Replicator)
+{
+    SpawnReplicator = Replicator;
+}
+
+AProjectileBase* UProjectilePoolSubsystem::SpawnPooledProjectile(TSubclassOf<AProjectileBase> ProjectileClass, const FTransform& SpawnTransform, bool bReplicated)
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return nullptr;
+    }
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    // Flag the actor before BeginPlay so it starts parked instead of running its lifetime. A replicated
+    // one goes out to clients once, hidden, and then sleeps until it is handed out.
+    SpawnParams.CustomPreSpawnInitalization = [bReplicated](AActor* Actor)
+    {
+        if (AProjectileBase* Projectile = Cast<AProjectileBase>(Actor))
+        {
+            Projectile->bManagedByPool = true;
+            Projectile->bPoolActive = false;
+            Projectile->SetReplicates(bReplicated);
+            Projectile->NetDormancy = FNetDormancyPolicy::GetInitialDormancy(DORM_DormantAll);
+        }
+    };
+
+    return World->SpawnActor<AProjectileBase>(ProjectileClass, SpawnTransform, SpawnParams);
+}
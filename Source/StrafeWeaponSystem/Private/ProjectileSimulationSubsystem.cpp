@@ -0,0 +1,646 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ProjectileSimulationSubsystem.h"
+#include "ProjectileBase.h"
+#include "WeaponDataAsset.h"
+#include "Components/SphereComponent.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+#include "GameFramework/Controller.h"
+#include "Engine/World.h"
+#include "Engine/OverlapResult.h"
+#include "TimerManager.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_STATS_GROUP(TEXT("StrafeProjectiles"), STATGROUP_StrafeProjectiles, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Batched Projectile Simulation"), STAT_ProjectileSimulation, STATGROUP_StrafeProjectiles);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Simulated Projectiles"), STAT_SimulatedProjectiles, STATGROUP_StrafeProjectiles);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Analytic Sweeps Skipped"), STAT_AnalyticSweepsSkipped, STATGROUP_StrafeProjectiles);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Analytic Predictive Sweeps"), STAT_AnalyticPredictiveSweeps, STATGROUP_StrafeProjectiles);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Projectile Sub-steps"), STAT_ProjectileSubSteps, STATGROUP_StrafeProjectiles);
+
+namespace
+{
+    FAutoConsoleCommandWithWorld DumpProjectileSimulationCommand(
+        TEXT("Strafe.ProjectileSimulation.Dump"),
+        TEXT("Logs record count (per weapon) and fixed-step sub-step counters of the batched projectile simulation."),
+        FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+        {
+            if (const UProjectileSimulationSubsystem* Simulation = World ? World->GetSubsystem<UProjectileSimulationSubsystem>() : nullptr)
+            {
+                Simulation->LogSimulationStats();
+            }
+        }));
+
+    // Object types that can move into a predicted path; everything else is treated as static
+    constexpr ECollisionChannel DynamicObjectTypes[] = { ECC_WorldDynamic, ECC_Pawn, ECC_PhysicsBody, ECC_Vehicle, ECC_Destructible };
+}
+
+bool UProjectileSimulationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UProjectileSimulationSubsystem::Deinitialize()
+{
+    for (AProjectileBase* Projectile : Projectiles)
+    {
+        if (Projectile)
+        {
+            Projectile->SimulationIndex = INDEX_NONE;
+        }
+    }
+    Projectiles.Empty();
+
+    Super::Deinitialize();
+}
+
+TStatId UProjectileSimulationSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UProjectileSimulationSubsystem, STATGROUP_Tickables);
+}
+
+void UProjectileSimulationSubsystem::AddProjectile(AProjectileBase* Projectile, const FVector& LaunchVelocity, bool bAnalytic)
+{
+    if (!IsValid(Projectile) || Projectile->SimulationIndex != INDEX_NONE)
+    {
+        return;
+    }
+
+    USphereComponent* Sphere = Projectile->CollisionComp;
+    UProjectileMovementComponent* Movement = Projectile->ProjectileMovement;
+    if (!Sphere || !Movement)
+    {
+        return;
+    }
+
+    const int32 Index = Projectiles.Add(Projectile);
+    Projectile->SimulationIndex = Index;
+
+    WeaponData.Add(Projectile->OwningWeaponData);
+    Owners.Add(Projectile->ProjectileOwner);
+    Positions.Add(Projectile->GetActorLocation());
+    Velocities.Add(LaunchVelocity);
+    GravityScales.Add(Movement->ProjectileGravityScale);
+    MaxSpeeds.Add(Movement->GetMaxSpeed());
+
+    // Lifetime moves from the actor's timer into the record and back again if we stop simulating early
+    FTimerManager& TimerManager = Projectile->GetWorldTimerManager();
+    const float RemainingLifetime = TimerManager.IsTimerActive(Projectile->LifetimeTimer)
+        ? TimerManager.GetTimerRemaining(Projectile->LifetimeTimer)
+        : TNumericLimits<float>::Max();
+    TimerManager.ClearTimer(Projectile->LifetimeTimer);
+    Lifetimes.Add(RemainingLifetime);
+
+    Radii.Add(Sphere->GetScaledSphereRadius());
+
+    Channels.Add(Sphere->GetCollisionObjectType());
+    ResponseParams.Add(FCollisionResponseParams(Sphere->GetCollisionResponseToChannels()));
+
+    FCollisionQueryParams& Params = QueryParams.Emplace_GetRef(SCENE_QUERY_STAT(BatchedProjectileSweep), false, Projectile);
+    Params.AddIgnoredActors(Sphere->MoveIgnoreActors);
+
+    Analytic.Add(bAnalytic);
+    LaunchPositions.Add(Positions[Index]);
+    LaunchVelocities.Add(LaunchVelocity);
+    FlightTimes.Add(0.0f);
+    PredictedImpactTimes.Add(TNumericLimits<float>::Max());
+    PredictedUntilTimes.Add(0.0f);
+
+    HistorySamples.AddZeroed(FMath::Max(HistoryLength, 1));
+    HistoryHeads.Add(0);
+    HistoryCounts.Add(0);
+
+    // The movement component is not used for authority-side movement while we own the projectile
+    Movement->StopMovementImmediately();
+    Movement->Deactivate();
+
+    if (bAnalytic)
+    {
+        if (MaxSpeeds[Index] > 0.0f)
+        {
+            Velocities[Index] = LaunchVelocities[Index] = LaunchVelocity.GetClampedToMaxSize(MaxSpeeds[Index]);
+        }
+        PredictImpact(GetWorld(), Index, 0.0f);
+    }
+}
+
+void UProjectileSimulationSubsystem::RemoveProjectile(AProjectileBase* Projectile)
+{
+    int32 Index;
+    if (IsValidIndex(Projectile, Index))
+    {
+        RemoveAtSwap(Index);
+    }
+}
+
+FVector UProjectileSimulationSubsystem::GetVelocity(const AProjectileBase* Projectile) const
+{
+    int32 Index;
+    return IsValidIndex(Projectile, Index) ? Velocities[Index] : FVector::ZeroVector;
+}
+
+void UProjectileSimulationSubsystem::SetVelocity(AProjectileBase* Projectile, const FVector& NewVelocity)
+{
+    int32 Index;
+    if (IsValidIndex(Projectile, Index))
+    {
+        Velocities[Index] = NewVelocity;
+        if (Analytic[Index])
+        {
+            ResetPath(Index);
+        }
+    }
+}
+
+bool UProjectileSimulationSubsystem::IsValidIndex(const AProjectileBase* Projectile, int32& OutIndex) const
+{
+    OutIndex = Projectile ? Projectile->SimulationIndex : INDEX_NONE;
+    return Projectiles.IsValidIndex(OutIndex) && Projectiles[OutIndex] == Projectile;
+}
+
+void UProjectileSimulationSubsystem::RemoveAtSwap(int32 Index)
+{
+    if (AProjectileBase* Removed = Projectiles[Index])
+    {
+        Removed->SimulationIndex = INDEX_NONE;
+
+        // Stuck or stopped projectiles still need to expire on their own
+        if (Removed->IsPoolActive() && Lifetimes[Index] < TNumericLimits<float>::Max())
+        {
+            Removed->ArmLifetimeTimer(FMath::Max(Lifetimes[Index], KINDA_SMALL_NUMBER));
+        }
+    }
+
+    Projectiles.RemoveAtSwap(Index, EAllowShrinking::No);
+    WeaponData.RemoveAtSwap(Index, EAllowShrinking::No);
+    Owners.RemoveAtSwap(Index, EAllowShrinking::No);
+    Positions.RemoveAtSwap(Index, EAllowShrinking::No);
+    Velocities.RemoveAtSwap(Index, EAllowShrinking::No);
+    GravityScales.RemoveAtSwap(Index, EAllowShrinking::No);
+    MaxSpeeds.RemoveAtSwap(Index, EAllowShrinking::No);
+    Lifetimes.RemoveAtSwap(Index, EAllowShrinking::No);
+    Radii.RemoveAtSwap(Index, EAllowShrinking::No);
+    Channels.RemoveAtSwap(Index, EAllowShrinking::No);
+    ResponseParams.RemoveAtSwap(Index, EAllowShrinking::No);
+    QueryParams.RemoveAtSwap(Index, EAllowShrinking::No);
+    Analytic.RemoveAtSwap(Index, EAllowShrinking::No);
+    LaunchPositions.RemoveAtSwap(Index, EAllowShrinking::No);
+    LaunchVelocities.RemoveAtSwap(Index, EAllowShrinking::No);
+    FlightTimes.RemoveAtSwap(Index, EAllowShrinking::No);
+    PredictedImpactTimes.RemoveAtSwap(Index, EAllowShrinking::No);
+    PredictedUntilTimes.RemoveAtSwap(Index, EAllowShrinking::No);
+    HistoryHeads.RemoveAtSwap(Index, EAllowShrinking::No);
+    HistoryCounts.RemoveAtSwap(Index, EAllowShrinking::No);
+
+    // History is one fixed-size block per record; move the last block into the freed one
+    const int32 Capacity = FMath::Max(HistoryLength, 1);
+    const int32 LastBlock = HistorySamples.Num() - Capacity;
+    if (Index * Capacity != LastBlock)
+    {
+        FMemory::Memcpy(&HistorySamples[Index * Capacity], &HistorySamples[LastBlock], Capacity * sizeof(FProjectileStateSample));
+    }
+    HistorySamples.SetNum(LastBlock, EAllowShrinking::No);
+
+    // The last record moved into the freed slot
+    if (Projectiles.IsValidIndex(Index) && Projectiles[Index])
+    {
+        Projectiles[Index]->SimulationIndex = Index;
+    }
+}
+
+FVector UProjectileSimulationSubsystem::EvaluatePath(int32 Index, float FlightTime) const
+{
+    const float GravityZ = GetWorld()->GetGravityZ() * GravityScales[Index];
+    FVector Position = LaunchPositions[Index] + LaunchVelocities[Index] * FlightTime;
+    Position.Z += 0.5f * GravityZ * FlightTime * FlightTime;
+    return Position;
+}
+
+void UProjectileSimulationSubsystem::ResetPath(int32 Index)
+{
+    LaunchPositions[Index] = Positions[Index];
+    LaunchVelocities[Index] = Velocities[Index];
+    FlightTimes[Index] = 0.0f;
+    PredictImpact(GetWorld(), Index, 0.0f);
+}
+
+void UProjectileSimulationSubsystem::PredictImpact(UWorld* World, int32 Index, float FromTime)
+{
+    PredictedImpactTimes[Index] = TNumericLimits<float>::Max();
+    if (!World)
+    {
+        PredictedUntilTimes[Index] = FromTime;
+        return;
+    }
+
+    // Dynamic objects are handled per frame by the corridor test, so only static responses matter here
+    FCollisionResponseParams StaticResponses = ResponseParams[Index];
+    for (ECollisionChannel DynamicType : DynamicObjectTypes)
+    {
+        StaticResponses.CollisionResponse.SetResponse(DynamicType, ECR_Ignore);
+    }
+
+    const float EndTime = FromTime + FMath::Min(AnalyticPredictionHorizon, FMath::Max(Lifetimes[Index], 0.0f));
+    const bool bStraight = FMath::IsNearlyZero(GravityScales[Index]);
+    const float SegmentTime = bStraight ? EndTime - FromTime : FMath::Max(AnalyticSegmentTime, KINDA_SMALL_NUMBER);
+
+    float SegmentStart = FromTime;
+    FVector Start = EvaluatePath(Index, SegmentStart);
+    while (SegmentStart < EndTime)
+    {
+        const float SegmentEnd = FMath::Min(SegmentStart + SegmentTime, EndTime);
+        const FVector End = EvaluatePath(Index, SegmentEnd);
+        INC_DWORD_STAT(STAT_AnalyticPredictiveSweeps);
+
+        FHitResult Hit;
+        if (World->SweepSingleByChannel(Hit, Start, End, FQuat::Identity, Channels[Index],
+            FCollisionShape::MakeSphere(Radii[Index]), QueryParams[Index], StaticResponses) && Hit.bBlockingHit)
+        {
+            // The chord's hit fraction is close enough to the arc's for segments this short
+            PredictedImpactTimes[Index] = FMath::Lerp(SegmentStart, SegmentEnd, Hit.Time);
+            PredictedUntilTimes[Index] = PredictedImpactTimes[Index];
+            return;
+        }
+
+        SegmentStart = SegmentEnd;
+        Start = End;
+    }
+
+    PredictedUntilTimes[Index] = EndTime;
+}
+
+void UProjectileSimulationSubsystem::GatherDynamicBounds(UWorld* World, float FrameTime)
+{
+    DynamicBounds.Reset();
+
+    // Paths whose spans touch share one corridor; one box around every record would cover the whole
+    // map as soon as two fights fire at once
+    TArray<FBox, TInlineAllocator<16>> Corridors;
+    for (int32 i = 0; i < Projectiles.Num(); ++i)
+    {
+        if (Analytic[i])
+        {
+            // Start, middle and end of this frame's arc bound it closely enough at frame-sized spans
+            FBox Span(ForceInit);
+            Span += Positions[i];
+            Span += EvaluatePath(i, FlightTimes[i] + FrameTime * 0.5f);
+            Span += EvaluatePath(i, FlightTimes[i] + FrameTime);
+            Span = Span.ExpandBy(Radii[i]);
+
+            if (FBox* Corridor = Corridors.FindByPredicate([&Span](const FBox& Candidate) { return Candidate.Intersect(Span); }))
+            {
+                *Corridor += Span;
+            }
+            else
+            {
+                Corridors.Add(Span);
+            }
+        }
+    }
+
+    TArray<FOverlapResult> Overlaps;
+    TSet<const UPrimitiveComponent*> SeenComponents;
+    for (const FBox& Corridor : Corridors)
+    {
+        Overlaps.Reset();
+        World->OverlapMultiByObjectType(
+            Overlaps,
+            Corridor.GetCenter(),
+            FQuat::Identity,
+            FCollisionObjectQueryParams(FCollisionObjectQueryParams::InitType::AllDynamicObjects),
+            FCollisionShape::MakeBox(Corridor.GetExtent()),
+            FCollisionQueryParams(SCENE_QUERY_STAT(AnalyticProjectileCorridor), false)
+        );
+
+        for (const FOverlapResult& Overlap : Overlaps)
+        {
+            // Corridors that grew into each other after merging can report the same component twice
+            UPrimitiveComponent* Component = Overlap.GetComponent();
+            if (!Component)
+            {
+                continue;
+            }
+
+            bool bAlreadySeen = false;
+            SeenComponents.Add(Component, &bAlreadySeen);
+            if (!bAlreadySeen)
+            {
+                DynamicBounds.Emplace(Component->Bounds.GetBox(), Component);
+            }
+        }
+    }
+}
+
+bool UProjectileSimulationSubsystem::IsSegmentObstructed(int32 Index, const FVector& Start, const FVector& End) const
+{
+    if (DynamicBounds.Num() == 0)
+    {
+        return false;
+    }
+
+    FBox Segment(ForceInit);
+    Segment += Start;
+    Segment += End;
+    Segment = Segment.ExpandBy(Radii[Index]);
+
+    const AController* Owner = Owners[Index].Get();
+    const AActor* OwnerPawn = Owner ? Owner->GetPawn() : nullptr;
+
+    for (const TPair<FBox, TWeakObjectPtr<UPrimitiveComponent>>& Entry : DynamicBounds)
+    {
+        const UPrimitiveComponent* Component = Entry.Value.Get();
+        const AActor* ComponentOwner = Component ? Component->GetOwner() : nullptr;
+        if (Component && ComponentOwner != Projectiles[Index] && (!OwnerPawn || ComponentOwner != OwnerPawn) && Segment.Intersect(Entry.Key)
+            && ResponseParams[Index].CollisionResponse.GetResponse(Component->GetCollisionObjectType()) == ECR_Block
+            && Component->GetCollisionResponseToChannel(Channels[Index]) == ECR_Block)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void UProjectileSimulationSubsystem::Tick(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_ProjectileSimulation);
+    SET_DWORD_STAT(STAT_SimulatedProjectiles, Projectiles.Num());
+
+    UWorld* World = GetWorld();
+    if (!World || DeltaTime <= 0.0f)
+    {
+        return;
+    }
+
+    // Fixed steps make results independent of the server tick rate. Time beyond MaxSubStepsPerFrame
+    // is dropped so a hitch slows projectiles down instead of stalling the frame further.
+    const float StepTime = FMath::Max(FixedTimeStep, KINDA_SMALL_NUMBER);
+    TimeAccumulator += DeltaTime;
+    int32 NumSteps = FMath::FloorToInt(TimeAccumulator / StepTime);
+    if (NumSteps > MaxSubStepsPerFrame)
+    {
+        NumSteps = FMath::Max(MaxSubStepsPerFrame, 1);
+        TimeAccumulator = NumSteps * StepTime;
+    }
+    TimeAccumulator -= NumSteps * StepTime;
+
+    LastFrameSubSteps = NumSteps;
+    TotalSubSteps += NumSteps;
+    ++TotalFrames;
+    SET_DWORD_STAT(STAT_ProjectileSubSteps, NumSteps);
+
+    if (Projectiles.Num() == 0 || NumSteps == 0)
+    {
+        return;
+    }
+
+    // Step k ends at FrameStart + (k + 1) * StepTime; the leftover accumulator is not simulated yet
+    const double FrameStartTime = World->GetTimeSeconds() - TimeAccumulator - NumSteps * StepTime;
+
+    if (Analytic.Contains(true))
+    {
+        GatherDynamicBounds(World, NumSteps * StepTime);
+    }
+
+    int32 NumSkippedSweeps = 0;
+    for (int32 Step = 0; Step < NumSteps && Projectiles.Num() > 0; ++Step)
+    {
+        NumSkippedSweeps += StepSimulation(World, StepTime, FrameStartTime + (Step + 1) * StepTime);
+    }
+    SET_DWORD_STAT(STAT_AnalyticSweepsSkipped, NumSkippedSweeps);
+
+    // Push transforms to the actors once per frame so movement replication picks them up
+    for (int32 i = 0; i < Projectiles.Num(); ++i)
+    {
+        WriteTransform(i);
+    }
+}
+
+int32 UProjectileSimulationSubsystem::StepSimulation(UWorld* World, float StepTime, double StepEndTime)
+{
+    const int32 Num = Projectiles.Num();
+    const float GravityZ = World->GetGravityZ();
+
+    // Pass 1: integrate every record. Nothing here touches an actor.
+    SweepEnds.SetNumUninitialized(Num, EAllowShrinking::No);
+    for (int32 i = 0; i < Num; ++i)
+    {
+        Lifetimes[i] -= StepTime;
+
+        if (Analytic[i])
+        {
+            const float FlightTime = FlightTimes[i] + StepTime;
+            SweepEnds[i] = EvaluatePath(i, FlightTime);
+            Velocities[i] = LaunchVelocities[i] + FVector(0.0f, 0.0f, GravityZ * GravityScales[i] * FlightTime);
+            continue;
+        }
+
+        FVector& Velocity = Velocities[i];
+        Velocity.Z += GravityZ * GravityScales[i] * StepTime;
+        if (MaxSpeeds[i] > 0.0f)
+        {
+            Velocity = Velocity.GetClampedToMaxSize(MaxSpeeds[i]);
+        }
+
+        SweepEnds[i] = Positions[i] + Velocity * StepTime;
+    }
+
+    // Pass 2: pick the segments that need a sweep. Analytic records with a clear corridor move right away.
+    PendingHits.Reset();
+    PendingExpired.Reset();
+    SweepIndices.Reset();
+    int32 NumSkippedSweeps = 0;
+    for (int32 i = 0; i < Num; ++i)
+    {
+        if (Lifetimes[i] <= 0.0f)
+        {
+            PendingExpired.Add(Projectiles[i]);
+        }
+
+        if (Analytic[i])
+        {
+            const float FlightTime = FlightTimes[i] + StepTime;
+            FlightTimes[i] = FlightTime;
+
+            if (FlightTime < PredictedImpactTimes[i] && !IsSegmentObstructed(i, Positions[i], SweepEnds[i]))
+            {
+                Positions[i] = SweepEnds[i];
+                RecordHistory(i, StepEndTime);
+                ++NumSkippedSweeps;
+
+                if (FlightTime >= PredictedUntilTimes[i])
+                {
+                    PredictImpact(World, i, FlightTime);
+                }
+                continue;
+            }
+        }
+
+        SweepIndices.Add(i);
+    }
+
+    // Pass 3: sweep the rest as one batch. Nothing writes to the scene while the game thread waits
+    // here, so the queries only read, and each one only writes its own slot.
+    SweepHits.SetNum(SweepIndices.Num(), EAllowShrinking::No);
+    ParallelFor(SweepIndices.Num(), [this, World](int32 SweepIndex)
+    {
+        const int32 i = SweepIndices[SweepIndex];
+        FHitResult& Hit = SweepHits[SweepIndex];
+        Hit = FHitResult();
+        Hit.bBlockingHit = World->SweepSingleByChannel(
+            Hit,
+            Positions[i],
+            SweepEnds[i],
+            FQuat::Identity,
+            Channels[i],
+            FCollisionShape::MakeSphere(Radii[i]),
+            QueryParams[i],
+            ResponseParams[i]
+        ) && Hit.bBlockingHit;
+    }, SweepIndices.Num() < MinSweepsForParallel ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+    for (int32 SweepIndex = 0; SweepIndex < SweepIndices.Num(); ++SweepIndex)
+    {
+        const int32 i = SweepIndices[SweepIndex];
+        const FHitResult& Hit = SweepHits[SweepIndex];
+        if (Hit.bBlockingHit)
+        {
+            Positions[i] = Hit.Location;
+            PendingHits.Emplace(Projectiles[i], Hit);
+        }
+        else
+        {
+            Positions[i] = SweepEnds[i];
+
+            // The predicted surface is gone (or was a chord approximation short of it); look again
+            if (Analytic[i] && FlightTimes[i] >= PredictedImpactTimes[i])
+            {
+                PredictImpact(World, i, FlightTimes[i]);
+            }
+        }
+
+        RecordHistory(i, StepEndTime);
+    }
+
+    // Pass 4: gameplay callbacks. These can add, remove or reorder records, so resolve by actor.
+    for (const TPair<TWeakObjectPtr<AProjectileBase>, FHitResult>& Pending : PendingHits)
+    {
+        AProjectileBase* Projectile = Pending.Key.Get();
+        int32 Index;
+        if (!IsValidIndex(Projectile, Index))
+        {
+            continue;
+        }
+
+        // Handlers read the actor's location, so it has to be at the impact point now
+        WriteTransform(Index);
+
+        const FVector VelocityBeforeHit = Velocities[Index];
+        Projectile->HandleSimulatedHit(Pending.Value);
+
+        // Like UProjectileMovementComponent without bounce: stop unless the handler redirected us
+        if (IsValidIndex(Projectile, Index) && Velocities[Index].Equals(VelocityBeforeHit))
+        {
+            RemoveAtSwap(Index);
+            Projectile->CollisionComp->ComponentVelocity = FVector::ZeroVector;
+        }
+    }
+
+    for (const TWeakObjectPtr<AProjectileBase>& Expired : PendingExpired)
+    {
+        int32 Index;
+        AProjectileBase* Projectile = Expired.Get();
+        if (IsValidIndex(Projectile, Index))
+        {
+            WriteTransform(Index);
+            Projectile->SelfDestruct();
+        }
+    }
+
+    return NumSkippedSweeps;
+}
+
+void UProjectileSimulationSubsystem::WriteTransform(int32 Index)
+{
+    AProjectileBase* Projectile = Projectiles[Index];
+    if (!Projectile)
+    {
+        return;
+    }
+
+    const FVector& Velocity = Velocities[Index];
+    const FRotator Rotation = Velocity.IsNearlyZero() ? Projectile->GetActorRotation() : Velocity.Rotation();
+    Projectile->SetActorLocationAndRotation(Positions[Index], Rotation, false, nullptr, ETeleportType::None);
+    Projectile->CollisionComp->ComponentVelocity = Velocity;
+}
+
+void UProjectileSimulationSubsystem::RecordHistory(int32 Index, double Time)
+{
+    const int32 Capacity = FMath::Max(HistoryLength, 1);
+    const int32 Slot = (HistoryHeads[Index] + HistoryCounts[Index]) % Capacity;
+    HistorySamples[Index * Capacity + Slot] = { Time, Positions[Index], Velocities[Index] };
+
+    if (HistoryCounts[Index] < Capacity)
+    {
+        ++HistoryCounts[Index];
+    }
+    else
+    {
+        HistoryHeads[Index] = (HistoryHeads[Index] + 1) % Capacity;
+    }
+}
+
+bool UProjectileSimulationSubsystem::GetStateAtTime(const AProjectileBase* Projectile, double Time, FVector& OutPosition, FVector& OutVelocity) const
+{
+    int32 Index;
+    if (!IsValidIndex(Projectile, Index) || HistoryCounts[Index] == 0)
+    {
+        return false;
+    }
+
+    const int32 Capacity = FMath::Max(HistoryLength, 1);
+    const FProjectileStateSample* Samples = &HistorySamples[Index * Capacity];
+    auto SampleAt = [&](int32 Age) -> const FProjectileStateSample& // Age 0 = newest
+    {
+        return Samples[(HistoryHeads[Index] + HistoryCounts[Index] - 1 - Age) % Capacity];
+    };
+
+    if (Time > SampleAt(0).Time || Time < SampleAt(HistoryCounts[Index] - 1).Time)
+    {
+        return false;
+    }
+
+    for (int32 Age = 0; Age < HistoryCounts[Index] - 1; ++Age)
+    {
+        const FProjectileStateSample& Newer = SampleAt(Age);
+        const FProjectileStateSample& Older = SampleAt(Age + 1);
+        if (Time >= Older.Time)
+        {
+            const float Alpha = Newer.Time > Older.Time ? static_cast<float>((Time - Older.Time) / (Newer.Time - Older.Time)) : 1.0f;
+            OutPosition = FMath::Lerp(Older.Position, Newer.Position, Alpha);
+            OutVelocity = FMath::Lerp(Older.Velocity, Newer.Velocity, Alpha);
+            return true;
+        }
+    }
+
+    OutPosition = SampleAt(0).Position;
+    OutVelocity = SampleAt(0).Velocity;
+    return true;
+}
+
+void UProjectileSimulationSubsystem::LogSimulationStats() const
+{
+    UE_LOG(LogTemp, Log, TEXT("ProjectileSimulation: Records=%d StepRate=%.1fHz MaxSubSteps=%d LastFrameSubSteps=%d AvgSubSteps=%.2f Frames=%llu"),
+        Projectiles.Num(), 1.0f / FMath::Max(FixedTimeStep, KINDA_SMALL_NUMBER), MaxSubStepsPerFrame, LastFrameSubSteps,
+        TotalFrames > 0 ? static_cast<double>(TotalSubSteps) / TotalFrames : 0.0, TotalFrames);
+
+    TMap<const UWeaponDataAsset*, int32> RecordsByWeapon;
+    for (const UWeaponDataAsset* Data : WeaponData)
+    {
+        ++RecordsByWeapon.FindOrAdd(Data);
+    }
+    for (const TPair<const UWeaponDataAsset*, int32>& Entry : RecordsByWeapon)
+    {
+        UE_LOG(LogTemp, Log, TEXT("ProjectileSimulation:   %5d %s"), Entry.Value, *GetNameSafe(Entry.Key));
+    }
+}
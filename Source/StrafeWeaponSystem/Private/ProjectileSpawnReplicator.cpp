@@ -0,0 +1,333 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ProjectileSpawnReplicator.h"
+#include "ProjectileBase.h"
+#include "ProjectilePoolSubsystem.h"
+#include "BaseWeapon.h"
+#include "Components/SphereComponent.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerState.h"
+#include "GameFramework/Controller.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+
+void FProjectileSpawnRecord::PostReplicatedAdd(const FProjectileSpawnRecordArray& InArraySerializer)
+{
+    if (InArraySerializer.Owner)
+    {
+        InArraySerializer.Owner->OnRecordAdded(*this);
+    }
+}
+
+void FProjectileSpawnRecord::PostReplicatedChange(const FProjectileSpawnRecordArray& InArraySerializer)
+{
+    if (InArraySerializer.Owner)
+    {
+        InArraySerializer.Owner->OnRecordChanged(*this);
+    }
+}
+
+void FProjectileSpawnRecord::PreReplicatedRemove(const FProjectileSpawnRecordArray& InArraySerializer)
+{
+    if (InArraySerializer.Owner)
+    {
+        InArraySerializer.Owner->OnRecordRemoved(*this);
+    }
+}
+
+AProjectileSpawnReplicator::AProjectileSpawnReplicator()
+{
+    PrimaryActorTick.bCanEverTick = false;
+    bReplicates = true;
+    bAlwaysRelevant = true;
+    SetReplicateMovement(false);
+
+    SpawnRecords.Owner = this;
+}
+
+void AProjectileSpawnReplicator::BeginPlay()
+{
+    Super::BeginPlay();
+
+    SpawnRecords.Owner = this;
+
+    // Clients find the replicator through the pool, same as the server
+    if (UProjectilePoolSubsystem* Pool = GetWorld()->GetSubsystem<UProjectilePoolSubsystem>())
+    {
+        Pool->RegisterSpawnReplicator(this);
+    }
+}
+
+void AProjectileSpawnReplicator::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    for (const TPair<int32, TWeakObjectPtr<AProjectileBase>>& Proxy : Proxies)
+    {
+        if (AProjectileBase* Projectile = Proxy.Value.Get())
+        {
+            Projectile->Destroy();
+        }
+    }
+    Proxies.Empty();
+
+    GetWorldTimerManager().ClearTimer(RemovalTimer);
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void AProjectileSpawnReplicator::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+    // The fast array tracks its own changes through MarkItemDirty and only costs a key compare
+    DOREPLIFETIME(AProjectileSpawnReplicator, SpawnRecords);
+
+    FDoRepLifetimeParams Params;
+    Params.bIsPushBased = true;
+    DOREPLIFETIME_WITH_PARAMS_FAST(AProjectileSpawnReplicator, ProjectileClasses, Params);
+}
+
+int32 AProjectileSpawnReplicator::AddRecord(AProjectileBase* Projectile, const FVector& LaunchVelocity)
+{
+    if (!HasAuthority() || !Projectile)
+    {
+        return INDEX_NONE;
+    }
+
+    int32 ClassIndex = ProjectileClasses.IndexOfByKey(Projectile->GetClass());
+    if (ClassIndex == INDEX_NONE)
+    {
+        if (ProjectileClasses.Num() > MAX_uint8)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("AProjectileSpawnReplicator: Too many projectile classes, %s replicates as an actor"), *GetNameSafe(Projectile->GetClass()));
+            return INDEX_NONE;
+        }
+        ClassIndex = ProjectileClasses.Add(Projectile->GetClass());
+        MARK_PROPERTY_DIRTY_FROM_NAME(AProjectileSpawnReplicator, ProjectileClasses, this);
+    }
+
+    FProjectileSpawnRecord& Record = SpawnRecords.Records.AddDefaulted_GetRef();
+    Record.RecordId = NextRecordId++;
+    Record.ClassIndex = static_cast<uint8>(ClassIndex);
+    Record.Origin = Projectile->GetActorLocation();
+    Record.Direction = LaunchVelocity.GetSafeNormal();
+    Record.Speed = static_cast<uint16>(FMath::Clamp(FMath::RoundToInt(LaunchVelocity.Size()), 0, static_cast<int32>(MAX_uint16)));
+    Record.SpawnServerTime = GetWorld()->GetTimeSeconds();
+    Record.Weapon = Projectile->OwningWeapon;
+    Record.PredictionKey = Projectile->PredictionKeyId;
+
+    const AController* OwnerController = Projectile->ProjectileOwner;
+    if (const APlayerState* PlayerState = OwnerController ? OwnerController->PlayerState : nullptr)
+    {
+        Record.OwnerPlayerId = PlayerState->GetPlayerId();
+    }
+
+    SpawnRecords.MarkItemDirty(Record);
+    return Record.RecordId;
+}
+
+void AProjectileSpawnReplicator::MarkStuck(int32 RecordId, const FVector& Location)
+{
+    const int32 Index = FindRecordIndex(RecordId);
+    if (Index != INDEX_NONE)
+    {
+        FProjectileSpawnRecord& Record = SpawnRecords.Records[Index];
+        Record.State = EProjectileRecordState::Stuck;
+        Record.EventLocation = Location;
+        SpawnRecords.MarkItemDirty(Record);
+    }
+}
+
+void AProjectileSpawnReplicator::MarkDetonated(int32 RecordId, const FVector& Location)
+{
+    const int32 Index = FindRecordIndex(RecordId);
+    if (Index == INDEX_NONE)
+    {
+        return;
+    }
+
+    FProjectileSpawnRecord& Record = SpawnRecords.Records[Index];
+    Record.State = EProjectileRecordState::Detonated;
+    Record.EventLocation = Location;
+    SpawnRecords.MarkItemDirty(Record);
+
+    PendingRemovals.Emplace(RecordId, GetWorld()->GetTimeSeconds() + DetonatedRecordLifetime);
+    if (!GetWorldTimerManager().IsTimerActive(RemovalTimer))
+    {
+        GetWorldTimerManager().SetTimer(RemovalTimer, this, &AProjectileSpawnReplicator::RemoveExpiredRecords, DetonatedRecordLifetime, true);
+    }
+}
+
+void AProjectileSpawnReplicator::RemoveRecord(int32 RecordId)
+{
+    const int32 Index = FindRecordIndex(RecordId);
+    if (Index != INDEX_NONE)
+    {
+        SpawnRecords.Records.RemoveAtSwap(Index);
+        SpawnRecords.MarkArrayDirty();
+    }
+}
+
+int32 AProjectileSpawnReplicator::FindRecordIndex(int32 RecordId) const
+{
+    return SpawnRecords.Records.IndexOfByPredicate([RecordId](const FProjectileSpawnRecord& Record) { return Record.RecordId == RecordId; });
+}
+
+void AProjectileSpawnReplicator::RemoveExpiredRecords()
+{
+    const double Now = GetWorld()->GetTimeSeconds();
+    for (int32 i = PendingRemovals.Num() - 1; i >= 0; --i)
+    {
+        if (PendingRemovals[i].Value <= Now)
+        {
+            RemoveRecord(PendingRemovals[i].Key);
+            PendingRemovals.RemoveAtSwap(i);
+        }
+    }
+
+    if (PendingRemovals.Num() == 0)
+    {
+        GetWorldTimerManager().ClearTimer(RemovalTimer);
+    }
+}
+
+void AProjectileSpawnReplicator::OnRecordAdded(const FProjectileSpawnRecord& Record)
+{
+    if (Record.State == EProjectileRecordState::Detonated)
+    {
+        return;
+    }
+
+    if (!ProjectileClasses.IsValidIndex(Record.ClassIndex) || !ProjectileClasses[Record.ClassIndex])
+    {
+        // The class table arrives in the same update but may be applied after the records
+        PendingProxyRecords.AddUnique(Record.RecordId);
+        return;
+    }
+
+    SpawnProxy(Record);
+}
+
+void AProjectileSpawnReplicator::OnRecordChanged(const FProjectileSpawnRecord& Record)
+{
+    AProjectileBase* Proxy = Proxies.FindRef(Record.RecordId).Get();
+    if (!Proxy)
+    {
+        return;
+    }
+
+    if (Record.State == EProjectileRecordState::Stuck)
+    {
+        Proxy->StopProjectileMovement();
+        Proxy->SetActorLocation(Record.EventLocation);
+        Proxy->OnProjectileImpact(FHitResult());
+    }
+    else if (Record.State == EProjectileRecordState::Detonated)
+    {
+        // Explosion visuals come from the gameplay cue; the proxy just goes away where it blew up
+        Proxy->SetActorLocation(Record.EventLocation);
+        Proxies.Remove(Record.RecordId);
+        Proxy->Destroy();
+    }
+}
+
+void AProjectileSpawnReplicator::OnRecordRemoved(const FProjectileSpawnRecord& Record)
+{
+    PendingProxyRecords.Remove(Record.RecordId);
+
+    TWeakObjectPtr<AProjectileBase> Proxy;
+    if (Proxies.RemoveAndCopyValue(Record.RecordId, Proxy) && Proxy.IsValid())
+    {
+        Proxy->Destroy();
+    }
+}
+
+void AProjectileSpawnReplicator::OnRep_ProjectileClasses()
+{
+    TArray<int32> Waiting = MoveTemp(PendingProxyRecords);
+    for (const FProjectileSpawnRecord& Record : SpawnRecords.Records)
+    {
+        if (Waiting.Contains(Record.RecordId))
+        {
+            OnRecordAdded(Record);
+        }
+    }
+}
+
+void AProjectileSpawnReplicator::SpawnProxy(const FProjectileSpawnRecord& Record)
+{
+    UWorld* World = GetWorld();
+    const TSubclassOf<AProjectileBase> ProjectileClass = ProjectileClasses[Record.ClassIndex];
+    if (!World || Proxies.Contains(Record.RecordId))
+    {
+        return;
+    }
+
+    // The shooter already has this projectile in flight locally; it simply becomes the proxy
+    if (Record.PredictionKey != 0 && Record.Weapon)
+    {
+        if (AProjectileBase* Predicted = Record.Weapon->TakePredictedProjectile(Record.PredictionKey))
+        {
+            // Predicted copies stay out of the weapon's registry until now, like every proxy is in it from here on
+            Record.Weapon->RegisterProjectile(Predicted);
+            Proxies.Add(Record.RecordId, Predicted);
+            if (Record.State == EProjectileRecordState::Stuck)
+            {
+                OnRecordChanged(Record);
+            }
+            return;
+        }
+    }
+
+    const FVector LaunchVelocity = FVector(Record.Direction) * Record.Speed;
+    const FTransform SpawnTransform(LaunchVelocity.Rotation(), Record.Origin);
+
+    AProjectileBase* Proxy = AProjectileBase::SpawnLocalProjectile(World, ProjectileClass, SpawnTransform);
+    if (!Proxy)
+    {
+        return;
+    }
+
+    const AGameStateBase* GameState = World->GetGameState();
+    const APlayerState* OwnerPlayerState = nullptr;
+    if (GameState)
+    {
+        for (const APlayerState* PlayerState : GameState->PlayerArray)
+        {
+            if (PlayerState && PlayerState->GetPlayerId() == Record.OwnerPlayerId)
+            {
+                OwnerPlayerState = PlayerState;
+                break;
+            }
+        }
+    }
+
+    // Registers with the weapon so the shooter can still select projectiles to detonate
+    Proxy->InitializeProjectile(nullptr, Record.Weapon, Record.Weapon ? Record.Weapon->GetWeaponData() : nullptr);
+    if (APawn* OwnerPawn = OwnerPlayerState ? OwnerPlayerState->GetPawn() : nullptr)
+    {
+        Proxy->CollisionComp->IgnoreActorWhenMoving(OwnerPawn, true);
+        Proxy->SetInstigator(OwnerPawn);
+    }
+
+    if (Record.State == EProjectileRecordState::Stuck)
+    {
+        Proxy->StopProjectileMovement();
+        Proxy->SetActorLocation(Record.EventLocation);
+    }
+    else
+    {
+        // Catch up on the flight time we missed on the way here; the sweep stops us at anything in between
+        const float Elapsed = GameState ? FMath::Max(0.0f, static_cast<float>(GameState->GetServerWorldTimeSeconds() - Record.SpawnServerTime)) : 0.0f;
+        const float GravityZ = World->GetGravityZ() * Proxy->ProjectileMovement->ProjectileGravityScale;
+        const FVector Gravity(0.0f, 0.0f, GravityZ);
+
+        Proxy->SetActorLocation(FVector(Record.Origin) + LaunchVelocity * Elapsed + 0.5f * Gravity * Elapsed * Elapsed, true);
+        Proxy->SetProjectileVelocity(LaunchVelocity + Gravity * Elapsed);
+        Proxy->ProjectileMovement->UpdateComponentVelocity();
+    }
+
+    Proxies.Add(Record.RecordId, Proxy);
+}
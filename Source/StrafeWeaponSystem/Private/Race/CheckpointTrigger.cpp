@@ -4,6 +4,7 @@
 #include "StrafeCharacter.h" // Assuming your character class is AStrafeCharacter
 #include "Kismet/GameplayStatics.h"
 #include "Player/RaceStateComponent.h" // We will create this next
+#include "NetDormancyPolicy.h"
 
 ACheckpointTrigger::ACheckpointTrigger()
 {
@@ -26,6 +27,9 @@ ACheckpointTrigger::ACheckpointTrigger()
 	TypeOfCheckpoint = ECheckpointType::Checkpoint;
 	bReplicates = true; // Important for server to reliably detect overlaps
 	SetReplicatingMovement(false);
+
+	// Nothing on a checkpoint changes at runtime; clients already have it from the level
+	NetDormancy = FNetDormancyPolicy::GetInitialDormancy(DORM_Initial);
 }
 
 void ACheckpointTrigger::BeginPlay()
@@ -5,6 +5,7 @@
 #include "GameFramework/PlayerState.h"
 #include "StrafeCharacter.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 #include "Kismet/GameplayStatics.h"
 
 ARaceManager::ARaceManager()
@@ -19,8 +20,12 @@ ARaceManager::ARaceManager()
 void ARaceManager::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-	DOREPLIFETIME(ARaceManager, AllCheckpointsInOrder);
-	DOREPLIFETIME(ARaceManager, Scoreboard);
+
+	// Push model: the checkpoint list only changes on refresh and the scoreboard when a player posts a time
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(ARaceManager, AllCheckpointsInOrder, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ARaceManager, Scoreboard, Params);
 }
 
 void ARaceManager::BeginPlay()
@@ -38,6 +43,7 @@ void ARaceManager::RefreshAllCheckpoints()
 	if (!HasAuthority()) return;
 
 	AllCheckpointsInOrder.Empty();
+	MARK_PROPERTY_DIRTY_FROM_NAME(ARaceManager, AllCheckpointsInOrder, this);
 	StartLine = nullptr;
 	FinishLine = nullptr;
 
@@ -63,6 +69,7 @@ void ARaceManager::RegisterCheckpoint(ACheckpointTrigger* Checkpoint)
 		if (!AllCheckpointsInOrder.Contains(Checkpoint))
 		{
 			AllCheckpointsInOrder.Add(Checkpoint);
+			MARK_PROPERTY_DIRTY_FROM_NAME(ARaceManager, AllCheckpointsInOrder, this);
 			Checkpoint->OnCheckpointReached.AddUniqueDynamic(this, &ARaceManager::HandleCheckpointReached);
 			//UE_LOG(LogTemp, Log, TEXT("RaceManager: Registered Checkpoint %d (%s)"), Checkpoint->GetCheckpointOrder(), *Checkpoint->GetName());
 			// No need to sort here immediately, do it once all are potentially registered.
@@ -75,6 +82,7 @@ void ARaceManager::SortCheckpoints()
 	AllCheckpointsInOrder.Sort([](const ACheckpointTrigger& A, const ACheckpointTrigger& B) {
 		return A.GetCheckpointOrder() < B.GetCheckpointOrder();
 		});
+	MARK_PROPERTY_DIRTY_FROM_NAME(ARaceManager, AllCheckpointsInOrder, this);
 
 	//UE_LOG(LogTemp, Log, TEXT("RaceManager: Sorted %d checkpoints."), AllCheckpointsInOrder.Num());
 }
@@ -315,8 +323,7 @@ void ARaceManager::UpdatePlayerInScoreboard(APlayerState* PlayerState)
 		});
 
 	// This will trigger OnRep_Scoreboard for clients
-	// Force a net update if needed, though DOREPLIFETIME should handle it.
-	// GetWorld()->GetNetDriver()->ForcePropertyCompare(this, FindPropertyByName(GET_MEMBER_NAME_CHECKED(ARaceManager, Scoreboard)));
+	MARK_PROPERTY_DIRTY_FROM_NAME(ARaceManager, Scoreboard, this);
 	OnRep_Scoreboard(); // Manually call for server
 }
 
@@ -14,7 +14,10 @@ TArray<AStickyGrenadeProjectile*> AStickyGrenadeLauncher::GetStuckProjectiles()
 {
     TArray<AStickyGrenadeProjectile*> Result;
 
-    for (AProjectileBase* Projectile : ActiveProjectiles)
+    TArray<AProjectileBase*> Stickies;
+    GetProjectilesToDetonate(AStickyGrenadeProjectile::StaticClass(), -1, true, Stickies);
+
+    for (AProjectileBase* Projectile : Stickies)
     {
         if (AStickyGrenadeProjectile* Sticky = Cast<AStickyGrenadeProjectile>(Projectile))
         {
@@ -3,6 +3,7 @@
 
 #include "StickyGrenadeProjectile.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 #include "GameFramework/ProjectileMovementComponent.h"
 #include "WeaponDataAsset.h"
 #include "GameFramework/Character.h"
@@ -22,7 +23,9 @@ void AStickyGrenadeProjectile::GetLifetimeReplicatedProps(TArray<FLifetimeProper
 {
     Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-    DOREPLIFETIME(AStickyGrenadeProjectile, bIsStuck);
+    FDoRepLifetimeParams Params;
+    Params.bIsPushBased = true;
+    DOREPLIFETIME_WITH_PARAMS_FAST(AStickyGrenadeProjectile, bIsStuck, Params);
 }
 
 void AStickyGrenadeProjectile::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor,
@@ -51,7 +54,8 @@ void AStickyGrenadeProjectile::OnHit(UPrimitiveComponent* HitComp, AActor* Other
 
         // Stick to surface
         bIsStuck = true;
-        ProjectileMovement->StopMovementImmediately();
+        MARK_PROPERTY_DIRTY_FROM_NAME(AStickyGrenadeProjectile, bIsStuck, this);
+        StopProjectileMovement();
 
         // Attach with offset if specified
         FVector AttachOffset = FVector::ZeroVector;
@@ -62,16 +66,26 @@ void AStickyGrenadeProjectile::OnHit(UPrimitiveComponent* HitComp, AActor* Other
 
         SetActorLocation(GetActorLocation() + AttachOffset);
         AttachToComponent(OtherComp, FAttachmentTransformRules::KeepWorldTransform, Hit.BoneName);
+        NotifyStuck();
 
         OnRep_IsStuck();
     }
     else
     {
         // Bounce off if we can't stick
-        ProjectileMovement->Velocity = ProjectileMovement->Velocity.MirrorByVector(Hit.ImpactNormal) * 0.6f;
+        SetProjectileVelocity(GetProjectileVelocity().MirrorByVector(Hit.ImpactNormal) * 0.6f);
     }
 }
 
+void AStickyGrenadeProjectile::ResetProjectileState()
+{
+    Super::ResetProjectileState();
+
+    // A pooled grenade comes back unstuck and bouncing again
+    bIsStuck = false;
+    MARK_PROPERTY_DIRTY_FROM_NAME(AStickyGrenadeProjectile, bIsStuck, this);
+}
+
 void AStickyGrenadeProjectile::OnRep_IsStuck()
 {
     if (bIsStuck)
@@ -0,0 +1,21 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StrafeAbilitySystemComponent.h"
+
+void UStrafeAbilitySystemComponent::OnGiveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+    Super::OnGiveAbility(AbilitySpec);
+
+    // Clients get here from OnRep_ActivateAbilities, which notifies once for the whole update
+    if (IsOwnerActorAuthoritative())
+    {
+        OnAbilitySpecsChanged.Broadcast();
+    }
+}
+
+void UStrafeAbilitySystemComponent::OnRep_ActivateAbilities()
+{
+    Super::OnRep_ActivateAbilities();
+
+    OnAbilitySpecsChanged.Broadcast();
+}
@@ -0,0 +1,9 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StrafeAbilitySystemGlobals.h"
+#include "StrafeGameplayEffectContext.h"
+
+FGameplayEffectContext* UStrafeAbilitySystemGlobals::AllocGameplayEffectContext() const
+{
+    return new FStrafeGameplayEffectContext();
+}
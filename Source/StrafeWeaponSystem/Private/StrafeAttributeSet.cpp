@@ -1,5 +1,6 @@
 #include "StrafeAttributeSet.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 #include "GameplayEffectExtension.h" 
 
 UStrafeAttributeSet::UStrafeAttributeSet()
@@ -14,18 +15,89 @@ void UStrafeAttributeSet::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>&
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME_CONDITION_NOTIFY(UStrafeAttributeSet, RocketAmmo, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UStrafeAttributeSet, MaxRocketAmmo, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UStrafeAttributeSet, StickyGrenadeAmmo, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UStrafeAttributeSet, MaxStickyGrenadeAmmo, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UStrafeAttributeSet, ShotgunAmmo, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UStrafeAttributeSet, MaxShotgunAmmo, COND_None, REPNOTIFY_Always);
+	// The replication layout is built once per class, so the switches come from the class defaults
+	const UStrafeAttributeSet* Defaults = GetDefault<UStrafeAttributeSet>();
+	auto MakeAmmoParams = [Defaults](FName AttributeName)
+	{
+		FDoRepLifetimeParams Params;
+		Params.Condition = Defaults->PublicAttributes.Contains(AttributeName) ? COND_None : COND_OwnerOnly;
+		// GAS needs every update, even an unchanged one, to roll back a mispredicted local value
+		Params.RepNotifyCondition = REPNOTIFY_Always;
+		return Params;
+	};
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(UStrafeAttributeSet, RocketAmmo, MakeAmmoParams(GET_MEMBER_NAME_CHECKED(UStrafeAttributeSet, RocketAmmo)));
+	DOREPLIFETIME_WITH_PARAMS_FAST(UStrafeAttributeSet, MaxRocketAmmo, MakeAmmoParams(GET_MEMBER_NAME_CHECKED(UStrafeAttributeSet, MaxRocketAmmo)));
+	DOREPLIFETIME_WITH_PARAMS_FAST(UStrafeAttributeSet, StickyGrenadeAmmo, MakeAmmoParams(GET_MEMBER_NAME_CHECKED(UStrafeAttributeSet, StickyGrenadeAmmo)));
+	DOREPLIFETIME_WITH_PARAMS_FAST(UStrafeAttributeSet, MaxStickyGrenadeAmmo, MakeAmmoParams(GET_MEMBER_NAME_CHECKED(UStrafeAttributeSet, MaxStickyGrenadeAmmo)));
+	DOREPLIFETIME_WITH_PARAMS_FAST(UStrafeAttributeSet, ShotgunAmmo, MakeAmmoParams(GET_MEMBER_NAME_CHECKED(UStrafeAttributeSet, ShotgunAmmo)));
+	DOREPLIFETIME_WITH_PARAMS_FAST(UStrafeAttributeSet, MaxShotgunAmmo, MakeAmmoParams(GET_MEMBER_NAME_CHECKED(UStrafeAttributeSet, MaxShotgunAmmo)));
+
+	// The owner already has the exact values
+	FDoRepLifetimeParams FlagParams;
+	FlagParams.bIsPushBased = true;
+	FlagParams.Condition = Defaults->bReplicateHasAmmoFlags ? COND_SkipOwner : COND_Never;
+	DOREPLIFETIME_WITH_PARAMS_FAST(UStrafeAttributeSet, HasAmmoFlags, FlagParams);
+
 	// DOREPLIFETIME_CONDITION_NOTIFY(UStrafeAttributeSet, WeaponLockout, COND_None, REPNOTIFY_Always);
 	// DOREPLIFETIME_CONDITION_NOTIFY(UStrafeAttributeSet, Health, COND_None, REPNOTIFY_Always);
 	// DOREPLIFETIME_CONDITION_NOTIFY(UStrafeAttributeSet, MaxHealth, COND_None, REPNOTIFY_Always);
 	// DOREPLIFETIME_CONDITION_NOTIFY(UStrafeAttributeSet, MovementSpeed, COND_None, REPNOTIFY_Always);
 }
 
+void UStrafeAttributeSet::PostAttributeChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue)
+{
+	Super::PostAttributeChange(Attribute, OldValue, NewValue);
+
+	const int32 FlagBit = GetHasAmmoFlagBit(Attribute);
+	const AActor* OwningActor = GetOwningActor();
+	if (FlagBit == INDEX_NONE || !OwningActor || !OwningActor->HasAuthority())
+	{
+		return;
+	}
+
+	const uint8 Flag = static_cast<uint8>(1 << FlagBit);
+	const uint8 NewFlags = NewValue > 0.0f ? (HasAmmoFlags | Flag) : (HasAmmoFlags & ~Flag);
+	if (NewFlags != HasAmmoFlags)
+	{
+		HasAmmoFlags = NewFlags;
+		MARK_PROPERTY_DIRTY_FROM_NAME(UStrafeAttributeSet, HasAmmoFlags, this);
+	}
+}
+
+bool UStrafeAttributeSet::HasAmmo(const FGameplayAttribute& AmmoAttribute) const
+{
+	const AActor* OwningActor = GetOwningActor();
+	const FProperty* Property = AmmoAttribute.GetUProperty();
+	const bool bHasExactValue = !OwningActor || OwningActor->HasAuthority() || OwningActor->GetLocalRole() == ROLE_AutonomousProxy
+		|| (Property && PublicAttributes.Contains(Property->GetFName()));
+
+	if (bHasExactValue)
+	{
+		return AmmoAttribute.IsValid() && AmmoAttribute.GetNumericValue(this) > 0.0f;
+	}
+
+	const int32 FlagBit = GetHasAmmoFlagBit(AmmoAttribute);
+	return FlagBit != INDEX_NONE && (HasAmmoFlags & (1 << FlagBit)) != 0;
+}
+
+int32 UStrafeAttributeSet::GetHasAmmoFlagBit(const FGameplayAttribute& Attribute)
+{
+	if (Attribute == GetRocketAmmoAttribute())
+	{
+		return 0;
+	}
+	if (Attribute == GetStickyGrenadeAmmoAttribute())
+	{
+		return 1;
+	}
+	if (Attribute == GetShotgunAmmoAttribute())
+	{
+		return 2;
+	}
+	return INDEX_NONE;
+}
+
 void UStrafeAttributeSet::OnRep_RocketAmmo(const FGameplayAttributeData& OldRocketAmmo)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UStrafeAttributeSet, RocketAmmo, OldRocketAmmo);
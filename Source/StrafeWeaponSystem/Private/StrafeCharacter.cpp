@@ -2,6 +2,7 @@
 
 #include "StrafeCharacter.h"
 #include "WeaponInventoryComponent.h"
+#include "AmmoComponent.h"
 #include "BaseWeapon.h"
 #include "WeaponDataAsset.h" 
 #include "Camera/CameraComponent.h"
@@ -13,11 +14,21 @@
 #include "InputActionValue.h"
 #include "GameFramework/PlayerController.h"
 #include "Engine/LocalPlayer.h"
-#include "AbilitySystemComponent.h" 
+#include "StrafeAbilitySystemComponent.h"
 #include "StrafeAttributeSet.h"   
 #include "GameplayAbilitySpec.h" 
 #include "GameplayEffectTypes.h" 
 #include "GA_WeaponActivate.h" // Required for AbilityCDO
+#include "LagCompensationSubsystem.h"
+
+namespace
+{
+	int32 GetWeaponAbilityInputID(TSubclassOf<UGameplayAbility> AbilityClass)
+	{
+		const UGA_WeaponActivate* AbilityCDO = AbilityClass ? Cast<UGA_WeaponActivate>(AbilityClass->GetDefaultObject()) : nullptr;
+		return AbilityCDO ? AbilityCDO->AbilityInputID : -1;
+	}
+}
 
 
 // Sets default values
@@ -26,8 +37,9 @@ AStrafeCharacter::AStrafeCharacter()
 	PrimaryActorTick.bCanEverTick = true;
 
 	WeaponInventoryComponent = CreateDefaultSubobject<UWeaponInventoryComponent>(TEXT("WeaponInventoryComponent"));
+	AmmoComponent = CreateDefaultSubobject<UAmmoComponent>(TEXT("AmmoComponent"));
 
-	AbilitySystemComponent = CreateDefaultSubobject<UAbilitySystemComponent>(TEXT("AbilitySystemComponent"));
+	AbilitySystemComponent = CreateDefaultSubobject<UStrafeAbilitySystemComponent>(TEXT("AbilitySystemComponent"));
 	AbilitySystemComponent->SetIsReplicated(true);
 	AbilitySystemComponent->SetReplicationMode(EGameplayEffectReplicationMode::Mixed);
 
@@ -51,6 +63,12 @@ void AStrafeCharacter::BeginPlay()
 		WeaponInventoryComponent->OnWeaponEquipped.AddDynamic(this, &AStrafeCharacter::OnWeaponEquipped);
 	}
 
+	if (AbilitySystemComponent)
+	{
+		AbilitySystemComponent->OnAbilitySpecsChanged.AddUObject(this, &AStrafeCharacter::OnAbilitySpecsChanged);
+		BindWeaponAbilityInputIDs(GetCurrentWeapon()); // Anything that replicated in before we were listening
+	}
+
 	if (APlayerController* PlayerController = Cast<APlayerController>(Controller))
 	{
 		if (UEnhancedInputLocalPlayerSubsystem* Subsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PlayerController->GetLocalPlayer()))
@@ -74,9 +92,28 @@ void AStrafeCharacter::BeginPlay()
 				WeaponInventoryComponent->EquipWeapon(StartingWeaponClass);
 			}
 		}
+
+		if (ULagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<ULagCompensationSubsystem>())
+		{
+			LagCompensation->RegisterCharacter(this);
+		}
+
+		WeaponOwnerChangedHandle = ABaseWeapon::OnWeaponOwnerChanged.AddUObject(this, &AStrafeCharacter::HandleWeaponOwnerChanged);
 	}
 }
 
+void AStrafeCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (ULagCompensationSubsystem* LagCompensation = GetWorld() ? GetWorld()->GetSubsystem<ULagCompensationSubsystem>() : nullptr)
+	{
+		LagCompensation->UnregisterCharacter(this);
+	}
+
+	ABaseWeapon::OnWeaponOwnerChanged.Remove(WeaponOwnerChangedHandle);
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void AStrafeCharacter::PossessedBy(AController* NewController)
 {
 	Super::PossessedBy(NewController);
@@ -214,6 +251,14 @@ void AStrafeCharacter::Look(const FInputActionValue& Value)
 	}
 }
 
+void AStrafeCharacter::OnAbilitySpecsChanged()
+{
+	// On the owning client the weapon's specs and their SourceObject replicate independently of
+	// CurrentWeapon, so OnWeaponEquipped may have run before they resolved. Binding again when they
+	// arrive covers every order.
+	BindWeaponAbilityInputIDs(GetCurrentWeapon());
+}
+
 void AStrafeCharacter::Input_PrimaryFire_Pressed()
 {
 	UE_LOG(LogTemp, Warning, TEXT("AStrafeCharacter::Input_PrimaryFire_Pressed - InputID: %d, ASC: %s"),
@@ -270,98 +315,143 @@ void AStrafeCharacter::OnWeaponEquipped(ABaseWeapon* NewWeapon)
 		return;
 	}
 
-	// Clear old abilities only if authoritative, and update input IDs for all
-	if (HasAuthority())
+	// Every carried weapon's abilities stay granted (see GrantWeaponAbilities), so a switch only moves the
+	// equipped tag and the input IDs. The server and the owning client each do this to their own copy.
+	const UWeaponDataAsset* WeaponData = NewWeapon ? NewWeapon->GetWeaponData() : nullptr;
+	const FGameplayTag NewEquippedTag = WeaponData ? WeaponData->EquippedTag : FGameplayTag();
+	if (CurrentEquippedWeaponTag != NewEquippedTag)
 	{
-		UE_LOG(LogTemp, Log, TEXT("AStrafeCharacter::OnWeaponEquipped (Authority) - Clearing %d previous weapon abilities"), CurrentWeaponAbilityHandles.Num());
-		for (FGameplayAbilitySpecHandle Handle : CurrentWeaponAbilityHandles)
+		if (CurrentEquippedWeaponTag.IsValid())
+		{
+			AbilitySystemComponent->SetLooseGameplayTagCount(CurrentEquippedWeaponTag, 0);
+		}
+		if (NewEquippedTag.IsValid())
 		{
-			AbilitySystemComponent->ClearAbility(Handle);
+			AbilitySystemComponent->SetLooseGameplayTagCount(NewEquippedTag, 1);
 		}
-		CurrentWeaponAbilityHandles.Empty();
+		CurrentEquippedWeaponTag = NewEquippedTag;
 	}
 
-	// Reset current input IDs
-	CurrentPrimaryFireInputID = -1;
-	CurrentSecondaryFireInputID = -1;
+	CurrentPrimaryFireInputID = GetWeaponAbilityInputID(WeaponData ? WeaponData->PrimaryFireAbility : nullptr);
+	CurrentSecondaryFireInputID = GetWeaponAbilityInputID(WeaponData ? WeaponData->SecondaryFireAbility : nullptr);
 
-	if (NewWeapon && NewWeapon->GetWeaponData())
-	{
-		UWeaponDataAsset* WeaponData = NewWeapon->GetWeaponData();
-		UE_LOG(LogTemp, Log, TEXT("AStrafeCharacter::OnWeaponEquipped - Processing WeaponData: %s"), *WeaponData->GetName());
+	BindWeaponAbilityInputIDs(NewWeapon);
 
-		// Grant Primary Fire Ability
-		if (WeaponData->PrimaryFireAbility)
+	TArray<FGameplayAbilitySpecHandle> HolsteredActiveHandles;
+	for (const FGameplayAbilitySpec& Spec : AbilitySystemComponent->GetActivatableAbilities())
+	{
+		const ABaseWeapon* SourceWeapon = Cast<ABaseWeapon>(Spec.SourceObject.Get());
+		if (SourceWeapon && SourceWeapon != NewWeapon && Spec.IsActive())
 		{
-			UE_LOG(LogTemp, Log, TEXT("AStrafeCharacter::OnWeaponEquipped - PrimaryFireAbility class: %s"),
-				*WeaponData->PrimaryFireAbility->GetName());
+			HolsteredActiveHandles.Add(Spec.Handle);
+		}
+	}
 
-			if (!WeaponData->PrimaryFireAbility->IsChildOf(UGA_WeaponActivate::StaticClass()))
-			{
-				UE_LOG(LogTemp, Error, TEXT("AStrafeCharacter::OnWeaponEquipped - PrimaryFireAbility %s is not a child of UGA_WeaponActivate!"),
-					*WeaponData->PrimaryFireAbility->GetName());
-			}
-			else
-			{
-				UGA_WeaponActivate* AbilityCDO = WeaponData->PrimaryFireAbility->GetDefaultObject<UGA_WeaponActivate>();
-				if (AbilityCDO)
-				{
-					CurrentPrimaryFireInputID = AbilityCDO->AbilityInputID; // Store InputID
-					if (HasAuthority()) // Grant ability only on server
-					{
-						FGameplayAbilitySpecHandle SpecHandle = AbilitySystemComponent->GiveAbility(
-							FGameplayAbilitySpec(WeaponData->PrimaryFireAbility, 1, AbilityCDO->AbilityInputID, this)
-						);
-						CurrentWeaponAbilityHandles.Add(SpecHandle);
-						UE_LOG(LogTemp, Log, TEXT("AStrafeCharacter::OnWeaponEquipped (Authority) - Granted primary ability with InputID: %d"), AbilityCDO->AbilityInputID);
-					}
-				}
-				else
-				{
-					UE_LOG(LogTemp, Error, TEXT("AStrafeCharacter::OnWeaponEquipped - Failed to get CDO for PrimaryFireAbility"));
-				}
-			}
+	// Clearing the old specs used to end these; a charge in progress mustn't outlive its weapon
+	for (const FGameplayAbilitySpecHandle& Handle : HolsteredActiveHandles)
+	{
+		AbilitySystemComponent->CancelAbilityHandle(Handle);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("AStrafeCharacter::OnWeaponEquipped - Input IDs now %d/%d, equipped tag %s"),
+		CurrentPrimaryFireInputID, CurrentSecondaryFireInputID, *CurrentEquippedWeaponTag.ToString());
+}
+
+void AStrafeCharacter::BindWeaponAbilityInputIDs(const ABaseWeapon* EquippedWeapon)
+{
+	if (!AbilitySystemComponent)
+	{
+		return;
+	}
+
+	// Only the equipped weapon's specs keep an input ID, so a press never tries the holstered ones. The specs
+	// aren't marked dirty; both sides remap identically and nothing needs to be sent.
+	for (FGameplayAbilitySpec& Spec : AbilitySystemComponent->GetActivatableAbilities())
+	{
+		const ABaseWeapon* SourceWeapon = Cast<ABaseWeapon>(Spec.SourceObject.Get());
+		if (!SourceWeapon)
+		{
+			continue;
 		}
 
-		// Grant Secondary Fire Ability
-		if (WeaponData->SecondaryFireAbility)
+		const UGA_WeaponActivate* AbilityCDO = Cast<UGA_WeaponActivate>(Spec.Ability);
+		Spec.InputID = (SourceWeapon == EquippedWeapon && AbilityCDO) ? AbilityCDO->AbilityInputID : INDEX_NONE;
+	}
+}
+
+void AStrafeCharacter::GrantWeaponAbilities(ABaseWeapon* Weapon)
+{
+	if (!AbilitySystemComponent || !HasAuthority() || !Weapon || !Weapon->GetWeaponData() || WeaponAbilityHandles.Contains(Weapon))
+	{
+		return;
+	}
+
+	const UWeaponDataAsset* WeaponData = Weapon->GetWeaponData();
+	if (!WeaponData->EquippedTag.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("AStrafeCharacter::GrantWeaponAbilities - %s has no EquippedTag; its abilities fall back to checking the current weapon."), *WeaponData->GetName());
+	}
+
+	TArray<FGameplayAbilitySpecHandle>& Handles = WeaponAbilityHandles.Add(Weapon);
+	Weapon->OnEndPlay.AddUniqueDynamic(this, &AStrafeCharacter::OnWeaponEndPlay);
+	for (const TSubclassOf<UGameplayAbility>& AbilityClass : { WeaponData->PrimaryFireAbility, WeaponData->SecondaryFireAbility })
+	{
+		if (!AbilityClass)
 		{
-			UE_LOG(LogTemp, Log, TEXT("AStrafeCharacter::OnWeaponEquipped - SecondaryFireAbility class: %s"),
-				*WeaponData->SecondaryFireAbility->GetName());
+			continue;
+		}
 
-			if (!WeaponData->SecondaryFireAbility->IsChildOf(UGA_WeaponActivate::StaticClass()))
-			{
-				UE_LOG(LogTemp, Error, TEXT("AStrafeCharacter::OnWeaponEquipped - SecondaryFireAbility %s is not a child of UGA_WeaponActivate!"),
-					*WeaponData->SecondaryFireAbility->GetName());
-			}
-			else
-			{
-				UGA_WeaponActivate* AbilityCDO = WeaponData->SecondaryFireAbility->GetDefaultObject<UGA_WeaponActivate>();
-				if (AbilityCDO)
-				{
-					CurrentSecondaryFireInputID = AbilityCDO->AbilityInputID; // Store InputID
-					if (HasAuthority()) // Grant ability only on server
-					{
-						FGameplayAbilitySpecHandle SpecHandle = AbilitySystemComponent->GiveAbility(
-							FGameplayAbilitySpec(WeaponData->SecondaryFireAbility, 1, AbilityCDO->AbilityInputID, this)
-						);
-						CurrentWeaponAbilityHandles.Add(SpecHandle);
-						UE_LOG(LogTemp, Log, TEXT("AStrafeCharacter::OnWeaponEquipped (Authority) - Granted secondary ability with InputID: %d"), AbilityCDO->AbilityInputID);
-					}
-				}
-				else
-				{
-					UE_LOG(LogTemp, Error, TEXT("AStrafeCharacter::OnWeaponEquipped - Failed to get CDO for SecondaryFireAbility"));
-				}
-			}
+		if (!AbilityClass->IsChildOf(UGA_WeaponActivate::StaticClass()))
+		{
+			UE_LOG(LogTemp, Error, TEXT("AStrafeCharacter::GrantWeaponAbilities - %s is not a child of UGA_WeaponActivate!"), *AbilityClass->GetName());
+			continue;
 		}
+
+		// Granted unbound with the weapon as source; OnWeaponEquipped hands out the input IDs
+		Handles.Add(AbilitySystemComponent->GiveAbility(FGameplayAbilitySpec(AbilityClass, 1, INDEX_NONE, Weapon)));
+		UE_LOG(LogTemp, Log, TEXT("AStrafeCharacter::GrantWeaponAbilities (Authority) - Granted %s for %s"), *AbilityClass->GetName(), *Weapon->GetName());
+	}
+}
+
+
+void AStrafeCharacter::RevokeWeaponAbilities(ABaseWeapon* Weapon)
+{
+	TArray<FGameplayAbilitySpecHandle> Handles;
+	if (!Weapon || !WeaponAbilityHandles.RemoveAndCopyValue(Weapon, Handles))
+	{
+		return;
+	}
+
+	Weapon->OnEndPlay.RemoveDynamic(this, &AStrafeCharacter::OnWeaponEndPlay);
+	if (!AbilitySystemComponent)
+	{
+		return;
 	}
-	else
+
+	// Active ones end here, like a holstered weapon's do on a switch
+	for (const FGameplayAbilitySpecHandle& Handle : Handles)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("AStrafeCharacter::OnWeaponEquipped - No weapon or weapon data"));
+		AbilitySystemComponent->ClearAbility(Handle);
 	}
+	UE_LOG(LogTemp, Log, TEXT("AStrafeCharacter::RevokeWeaponAbilities (Authority) - Cleared %d abilities for %s"), Handles.Num(), *Weapon->GetName());
 }
 
+void AStrafeCharacter::OnWeaponEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason)
+{
+	// Only a weapon destroyed in play; on level teardown the ability system goes with us
+	if (EndPlayReason == EEndPlayReason::Destroyed && !IsActorBeingDestroyed())
+	{
+		RevokeWeaponAbilities(Cast<ABaseWeapon>(Actor));
+	}
+}
+
+void AStrafeCharacter::HandleWeaponOwnerChanged(ABaseWeapon* Weapon, AActor* OldOwner)
+{
+	if (OldOwner == this && Weapon && Weapon->GetOwner() != this)
+	{
+		RevokeWeaponAbilities(Weapon);
+	}
+}
 
 void AStrafeCharacter::NextWeapon()
 {
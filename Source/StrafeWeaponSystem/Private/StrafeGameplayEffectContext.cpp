@@ -0,0 +1,84 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StrafeGameplayEffectContext.h"
+#include "Engine/NetSerialization.h"
+
+bool FPelletImpactBatch::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+    // Offsets are taken from the rounded origin the receiver will see, so the error doesn't stack
+    FVector QuantizedOrigin(FMath::RoundToDouble(Origin.X), FMath::RoundToDouble(Origin.Y), FMath::RoundToDouble(Origin.Z));
+    bOutSuccess = SerializePackedVector<1, 24>(QuantizedOrigin, Ar);
+
+    uint8 NumImpacts = static_cast<uint8>(FMath::Min(Impacts.Num(), MaxImpacts));
+    Ar << NumImpacts;
+
+    if (Ar.IsLoading())
+    {
+        Origin = QuantizedOrigin;
+        Impacts.SetNum(NumImpacts);
+    }
+
+    for (int32 i = 0; i < NumImpacts; ++i)
+    {
+        FPelletImpact& Impact = Impacts[i];
+
+        FVector Offset = Impact.Location - QuantizedOrigin;
+        bOutSuccess &= SerializePackedVector<1, 20>(Offset, Ar);
+        bOutSuccess &= SerializeFixedVector<1, 8>(Impact.Normal, Ar);
+
+        uint8 SurfaceType = Impact.SurfaceType;
+        Ar.SerializeBits(&SurfaceType, 6);
+
+        if (Ar.IsLoading())
+        {
+            Impact.Location = QuantizedOrigin + Offset;
+            Impact.SurfaceType = static_cast<EPhysicalSurface>(SurfaceType);
+        }
+    }
+
+    return true;
+}
+
+FStrafeGameplayEffectContext* FStrafeGameplayEffectContext::ExtractEffectContext(FGameplayEffectContextHandle Handle)
+{
+    FGameplayEffectContext* BaseContext = Handle.Get();
+    if (BaseContext && BaseContext->GetScriptStruct()->IsChildOf(FStrafeGameplayEffectContext::StaticStruct()))
+    {
+        return static_cast<FStrafeGameplayEffectContext*>(BaseContext);
+    }
+    return nullptr;
+}
+
+FStrafeGameplayEffectContext* FStrafeGameplayEffectContext::Duplicate() const
+{
+    FStrafeGameplayEffectContext* NewContext = new FStrafeGameplayEffectContext();
+    *NewContext = *this;
+    if (GetHitResult())
+    {
+        // Does a deep copy of the hit result
+        NewContext->AddHitResult(*GetHitResult(), true);
+    }
+    return NewContext;
+}
+
+bool FStrafeGameplayEffectContext::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+    FGameplayEffectContext::NetSerialize(Ar, Map, bOutSuccess);
+
+    // One bit when there's no pellet payload, which is every context but a shotgun blast's
+    uint8 bHasPelletImpacts = PelletImpacts.Impacts.Num() > 0 ? 1 : 0;
+    Ar.SerializeBits(&bHasPelletImpacts, 1);
+
+    if (bHasPelletImpacts)
+    {
+        bool bPelletsSuccess = true;
+        PelletImpacts.NetSerialize(Ar, Map, bPelletsSuccess);
+        bOutSuccess &= bPelletsSuccess;
+    }
+    else if (Ar.IsLoading())
+    {
+        PelletImpacts = FPelletImpactBatch();
+    }
+
+    return true;
+}
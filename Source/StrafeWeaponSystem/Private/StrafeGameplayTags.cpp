@@ -0,0 +1,74 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StrafeGameplayTags.h"
+#include "GameplayTagsSettings.h"
+
+namespace StrafeGameplayTags
+{
+    UE_DEFINE_GAMEPLAY_TAG(Ability_Feedback_OutOfAmmo, "Ability.Feedback.OutOfAmmo");
+    UE_DEFINE_GAMEPLAY_TAG(Ability_Weapon_PrimaryFire, "Ability.Weapon.PrimaryFire");
+    UE_DEFINE_GAMEPLAY_TAG(Ability_Weapon_SecondaryFire, "Ability.Weapon.SecondaryFire");
+    UE_DEFINE_GAMEPLAY_TAG(Ability_Weapon_ChargedShotgun_PrimaryFire, "Ability.Weapon.ChargedShotgun.PrimaryFire");
+    UE_DEFINE_GAMEPLAY_TAG(Ability_Weapon_ChargedShotgun_SecondaryFire, "Ability.Weapon.ChargedShotgun.SecondaryFire");
+
+    UE_DEFINE_GAMEPLAY_TAG(Cooldown_Weapon_ChargedShotgun_PrimaryFire, "Cooldown.Weapon.ChargedShotgun.PrimaryFire");
+
+    UE_DEFINE_GAMEPLAY_TAG(State_Dead, "State.Dead");
+    UE_DEFINE_GAMEPLAY_TAG(State_Stunned, "State.Stunned");
+    UE_DEFINE_GAMEPLAY_TAG(State_Weapon_ChargedShotgun_Charging_PrimaryFire, "State.Weapon.ChargedShotgun.Charging.PrimaryFire");
+    UE_DEFINE_GAMEPLAY_TAG(State_Weapon_ChargedShotgun_Charging_SecondaryFire, "State.Weapon.ChargedShotgun.Charging.SecondaryFire");
+    UE_DEFINE_GAMEPLAY_TAG(State_Weapon_ChargedShotgun_Lockout, "State.Weapon.ChargedShotgun.Lockout");
+    UE_DEFINE_GAMEPLAY_TAG(State_Weapon_ChargedShotgun_Overcharged_SecondaryFire, "State.Weapon.ChargedShotgun.Overcharged.SecondaryFire");
+
+    UE_DEFINE_GAMEPLAY_TAG(Ammo, "Ammo");
+    UE_DEFINE_GAMEPLAY_TAG(Weapon_Equipped, "Weapon.Equipped");
+
+    UE_DEFINE_GAMEPLAY_TAG(SetByCaller_AmmoCost, "SetByCaller.AmmoCost");
+    UE_DEFINE_GAMEPLAY_TAG(SetByCaller_AmmoInitial, "SetByCaller.AmmoInitial");
+    UE_DEFINE_GAMEPLAY_TAG(SetByCaller_AmmoMax, "SetByCaller.AmmoMax");
+
+    void ValidateAgainstConfig()
+    {
+        const FNativeGameplayTag* const AllTags[] =
+        {
+            &Ability_Feedback_OutOfAmmo,
+            &Ability_Weapon_PrimaryFire,
+            &Ability_Weapon_SecondaryFire,
+            &Ability_Weapon_ChargedShotgun_PrimaryFire,
+            &Ability_Weapon_ChargedShotgun_SecondaryFire,
+            &Cooldown_Weapon_ChargedShotgun_PrimaryFire,
+            &State_Dead,
+            &State_Stunned,
+            &State_Weapon_ChargedShotgun_Charging_PrimaryFire,
+            &State_Weapon_ChargedShotgun_Charging_SecondaryFire,
+            &State_Weapon_ChargedShotgun_Lockout,
+            &State_Weapon_ChargedShotgun_Overcharged_SecondaryFire,
+            &Ammo,
+            &Weapon_Equipped,
+            &SetByCaller_AmmoCost,
+            &SetByCaller_AmmoInitial,
+            &SetByCaller_AmmoMax,
+        };
+
+        // Native tags register themselves whatever the ini says, so a missing entry wouldn't break anything
+        // at runtime; it would only leave the tag out of the editor's tag list and the project's tag table.
+        TSet<FName> ConfigTags;
+        for (const FGameplayTagTableRow& Row : GetDefault<UGameplayTagsSettings>()->GameplayTagList)
+        {
+            ConfigTags.Add(Row.Tag);
+        }
+
+        int32 NumMissing = 0;
+        for (const FNativeGameplayTag* Tag : AllTags)
+        {
+            const FName TagName = Tag->GetTag().GetTagName();
+            if (!ConfigTags.Contains(TagName))
+            {
+                UE_LOG(LogTemp, Error, TEXT("StrafeGameplayTags: %s is defined natively but missing from DefaultGameplayTags.ini."), *TagName.ToString());
+                ++NumMissing;
+            }
+        }
+
+        UE_LOG(LogTemp, Log, TEXT("StrafeGameplayTags: %d native tags validated, %d missing from config."), UE_ARRAY_COUNT(AllTags), NumMissing);
+    }
+}
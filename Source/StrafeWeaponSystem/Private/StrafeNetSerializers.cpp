@@ -0,0 +1,559 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StrafeNetSerializers.h"
+
+#if UE_WITH_IRIS
+
+#include "StrafeGameplayEffectContext.h"
+#include "Iris/Serialization/NetSerializer.h"
+#include "Iris/Serialization/NetSerializerDelegates.h"
+#include "Iris/Serialization/NetSerializationContext.h"
+#include "Iris/Serialization/InternalNetSerializationContext.h"
+#include "Iris/Serialization/NetBitStreamReader.h"
+#include "Iris/Serialization/NetBitStreamWriter.h"
+#include "Iris/ReplicationState/PropertyNetSerializerInfoRegistry.h"
+#include "Serialization/GameplayEffectContextNetSerializer.h"
+
+namespace UE::Net
+{
+
+UE_NET_DECLARE_SERIALIZER(FPelletImpactBatchNetSerializer, STRAFEWEAPONSYSTEM_API);
+UE_NET_DECLARE_SERIALIZER(FStrafeGameplayEffectContextNetSerializer, STRAFEWEAPONSYSTEM_API);
+
+namespace StrafeNetSerializersPrivate
+{
+    // Zigzag keeps small values of either sign small
+    uint32 ZigZag(int32 Value)
+    {
+        return (static_cast<uint32>(Value) << 1) ^ static_cast<uint32>(Value >> 31);
+    }
+
+    int32 UnZigZag(uint32 Value)
+    {
+        return static_cast<int32>(Value >> 1) ^ -static_cast<int32>(Value & 1);
+    }
+
+    // One bit count shared by the three components, like SerializePackedVector
+    void WritePackedInts(FNetBitStreamWriter& Writer, const int32 (&Values)[3])
+    {
+        const uint32 Encoded[3] = { ZigZag(Values[0]), ZigZag(Values[1]), ZigZag(Values[2]) };
+        const uint32 Combined = Encoded[0] | Encoded[1] | Encoded[2];
+        const uint32 NumBits = Combined ? 32u - FMath::CountLeadingZeros(Combined) : 0u;
+
+        Writer.WriteBits(NumBits, 6);
+        for (uint32 Component : Encoded)
+        {
+            if (NumBits > 0)
+            {
+                Writer.WriteBits(Component, NumBits);
+            }
+        }
+    }
+
+    void ReadPackedInts(FNetBitStreamReader& Reader, int32 (&Values)[3])
+    {
+        const uint32 NumBits = FMath::Min(Reader.ReadBits(6), 32u);
+        for (int32& Value : Values)
+        {
+            Value = NumBits > 0 ? UnZigZag(Reader.ReadBits(NumBits)) : 0;
+        }
+    }
+}
+
+struct FPelletImpactBatchNetSerializer
+{
+    static const uint32 Version = 0;
+    static constexpr bool bHasDynamicState = true;
+
+    struct FQuantizedImpact
+    {
+        int32 Offset[3];    // Whole centimetres from the rounded origin
+        int8 Normal[3];     // Components scaled to [-127, 127]
+        uint8 SurfaceType;  // 6 bits are sent
+    };
+
+    struct FQuantizedType
+    {
+        int32 Origin[3];
+        uint32 NumImpacts;
+        FQuantizedImpact* Impacts;
+    };
+
+    typedef FPelletImpactBatch SourceType;
+    typedef FQuantizedType QuantizedType;
+    typedef FPelletImpactBatchNetSerializerConfig ConfigType;
+
+    static const ConfigType DefaultConfig;
+
+    static void Serialize(FNetSerializationContext& Context, const FNetSerializeArgs& Args);
+    static void Deserialize(FNetSerializationContext& Context, const FNetDeserializeArgs& Args);
+    static void Quantize(FNetSerializationContext& Context, const FNetQuantizeArgs& Args);
+    static void Dequantize(FNetSerializationContext& Context, const FNetDequantizeArgs& Args);
+    static bool IsEqual(FNetSerializationContext& Context, const FNetIsEqualArgs& Args);
+    static bool Validate(FNetSerializationContext& Context, const FNetValidateArgs& Args);
+    static void CloneDynamicState(FNetSerializationContext& Context, const FNetCloneDynamicStateArgs& Args);
+    static void FreeDynamicState(FNetSerializationContext& Context, const FNetFreeDynamicStateArgs& Args);
+
+private:
+    static void SetNumImpacts(FNetSerializationContext& Context, QuantizedType& Value, uint32 NumImpacts);
+};
+UE_NET_IMPLEMENT_SERIALIZER(FPelletImpactBatchNetSerializer);
+
+const FPelletImpactBatchNetSerializer::ConfigType FPelletImpactBatchNetSerializer::DefaultConfig;
+
+void FPelletImpactBatchNetSerializer::Serialize(FNetSerializationContext& Context, const FNetSerializeArgs& Args)
+{
+    using namespace StrafeNetSerializersPrivate;
+
+    const QuantizedType& Value = *reinterpret_cast<const QuantizedType*>(Args.Source);
+    FNetBitStreamWriter& Writer = *Context.GetBitStreamWriter();
+
+    WritePackedInts(Writer, Value.Origin);
+    Writer.WriteBits(Value.NumImpacts, 8);
+    for (uint32 i = 0; i < Value.NumImpacts; ++i)
+    {
+        const FQuantizedImpact& Impact = Value.Impacts[i];
+        WritePackedInts(Writer, Impact.Offset);
+        for (int8 Component : Impact.Normal)
+        {
+            Writer.WriteBits(static_cast<uint8>(Component), 8);
+        }
+        Writer.WriteBits(Impact.SurfaceType, 6);
+    }
+}
+
+void FPelletImpactBatchNetSerializer::Deserialize(FNetSerializationContext& Context, const FNetDeserializeArgs& Args)
+{
+    using namespace StrafeNetSerializersPrivate;
+
+    QuantizedType& Value = *reinterpret_cast<QuantizedType*>(Args.Target);
+    FNetBitStreamReader& Reader = *Context.GetBitStreamReader();
+
+    ReadPackedInts(Reader, Value.Origin);
+    SetNumImpacts(Context, Value, Reader.ReadBits(8));
+    for (uint32 i = 0; i < Value.NumImpacts; ++i)
+    {
+        FQuantizedImpact& Impact = Value.Impacts[i];
+        ReadPackedInts(Reader, Impact.Offset);
+        for (int8& Component : Impact.Normal)
+        {
+            Component = static_cast<int8>(static_cast<uint8>(Reader.ReadBits(8)));
+        }
+        Impact.SurfaceType = static_cast<uint8>(Reader.ReadBits(6));
+    }
+}
+
+void FPelletImpactBatchNetSerializer::Quantize(FNetSerializationContext& Context, const FNetQuantizeArgs& Args)
+{
+    const SourceType& Source = *reinterpret_cast<const SourceType*>(Args.Source);
+    QuantizedType& Target = *reinterpret_cast<QuantizedType*>(Args.Target);
+
+    // Offsets are taken from the rounded origin the receiver will see, so the error doesn't stack
+    for (int32 Axis = 0; Axis < 3; ++Axis)
+    {
+        Target.Origin[Axis] = FMath::RoundToInt32(Source.Origin[Axis]);
+    }
+
+    SetNumImpacts(Context, Target, FMath::Min(Source.Impacts.Num(), FPelletImpactBatch::MaxImpacts));
+    for (uint32 i = 0; i < Target.NumImpacts; ++i)
+    {
+        const FPelletImpact& Impact = Source.Impacts[i];
+        FQuantizedImpact& QuantizedImpact = Target.Impacts[i];
+        for (int32 Axis = 0; Axis < 3; ++Axis)
+        {
+            QuantizedImpact.Offset[Axis] = FMath::RoundToInt32(Impact.Location[Axis] - Target.Origin[Axis]);
+            QuantizedImpact.Normal[Axis] = static_cast<int8>(FMath::RoundToInt32(FMath::Clamp(Impact.Normal[Axis], -1.0, 1.0) * 127.0));
+        }
+        QuantizedImpact.SurfaceType = static_cast<uint8>(Impact.SurfaceType) & 63;
+    }
+}
+
+void FPelletImpactBatchNetSerializer::Dequantize(FNetSerializationContext& Context, const FNetDequantizeArgs& Args)
+{
+    const QuantizedType& Source = *reinterpret_cast<const QuantizedType*>(Args.Source);
+    SourceType& Target = *reinterpret_cast<SourceType*>(Args.Target);
+
+    Target.Origin = FVector(Source.Origin[0], Source.Origin[1], Source.Origin[2]);
+    Target.Impacts.SetNum(Source.NumImpacts);
+    for (uint32 i = 0; i < Source.NumImpacts; ++i)
+    {
+        const FQuantizedImpact& QuantizedImpact = Source.Impacts[i];
+        FPelletImpact& Impact = Target.Impacts[i];
+        Impact.Location = Target.Origin + FVector(QuantizedImpact.Offset[0], QuantizedImpact.Offset[1], QuantizedImpact.Offset[2]);
+        Impact.Normal = FVector(QuantizedImpact.Normal[0], QuantizedImpact.Normal[1], QuantizedImpact.Normal[2]) / 127.0;
+        Impact.SurfaceType = static_cast<EPhysicalSurface>(QuantizedImpact.SurfaceType);
+    }
+}
+
+bool FPelletImpactBatchNetSerializer::IsEqual(FNetSerializationContext& Context, const FNetIsEqualArgs& Args)
+{
+    if (Args.bStateIsQuantized)
+    {
+        const QuantizedType& Value0 = *reinterpret_cast<const QuantizedType*>(Args.Source0);
+        const QuantizedType& Value1 = *reinterpret_cast<const QuantizedType*>(Args.Source1);
+        return FMemory::Memcmp(Value0.Origin, Value1.Origin, sizeof(Value0.Origin)) == 0
+            && Value0.NumImpacts == Value1.NumImpacts
+            && (Value0.NumImpacts == 0 || FMemory::Memcmp(Value0.Impacts, Value1.Impacts, Value0.NumImpacts * sizeof(FQuantizedImpact)) == 0);
+    }
+
+    const SourceType& Value0 = *reinterpret_cast<const SourceType*>(Args.Source0);
+    const SourceType& Value1 = *reinterpret_cast<const SourceType*>(Args.Source1);
+    if (Value0.Origin != Value1.Origin || Value0.Impacts.Num() != Value1.Impacts.Num())
+    {
+        return false;
+    }
+
+    for (int32 i = 0; i < Value0.Impacts.Num(); ++i)
+    {
+        const FPelletImpact& Impact0 = Value0.Impacts[i];
+        const FPelletImpact& Impact1 = Value1.Impacts[i];
+        if (Impact0.Location != Impact1.Location || Impact0.Normal != Impact1.Normal || Impact0.SurfaceType != Impact1.SurfaceType)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool FPelletImpactBatchNetSerializer::Validate(FNetSerializationContext& Context, const FNetValidateArgs& Args)
+{
+    const SourceType& Source = *reinterpret_cast<const SourceType*>(Args.Source);
+    return Source.Impacts.Num() <= FPelletImpactBatch::MaxImpacts;
+}
+
+void FPelletImpactBatchNetSerializer::CloneDynamicState(FNetSerializationContext& Context, const FNetCloneDynamicStateArgs& Args)
+{
+    const QuantizedType& Source = *reinterpret_cast<const QuantizedType*>(Args.Source);
+    QuantizedType& Target = *reinterpret_cast<QuantizedType*>(Args.Target);
+
+    // Target starts as a byte copy of Source, so it still points at Source's impacts
+    Target.Impacts = nullptr;
+    Target.NumImpacts = 0;
+    SetNumImpacts(Context, Target, Source.NumImpacts);
+    if (Source.NumImpacts > 0)
+    {
+        FMemory::Memcpy(Target.Impacts, Source.Impacts, Source.NumImpacts * sizeof(FQuantizedImpact));
+    }
+}
+
+void FPelletImpactBatchNetSerializer::FreeDynamicState(FNetSerializationContext& Context, const FNetFreeDynamicStateArgs& Args)
+{
+    SetNumImpacts(Context, *reinterpret_cast<QuantizedType*>(Args.Source), 0);
+}
+
+void FPelletImpactBatchNetSerializer::SetNumImpacts(FNetSerializationContext& Context, QuantizedType& Value, uint32 NumImpacts)
+{
+    if (Value.NumImpacts == NumImpacts)
+    {
+        return;
+    }
+
+    if (Value.Impacts)
+    {
+        Context.GetInternalContext()->Free(Value.Impacts);
+        Value.Impacts = nullptr;
+    }
+
+    Value.NumImpacts = NumImpacts;
+    if (NumImpacts > 0)
+    {
+        const SIZE_T Size = NumImpacts * sizeof(FQuantizedImpact);
+        Value.Impacts = static_cast<FQuantizedImpact*>(Context.GetInternalContext()->Alloc(Size, alignof(FQuantizedImpact)));
+        FMemory::Memzero(Value.Impacts, Size);
+    }
+}
+
+/**
+ * Runs the engine's FGameplayEffectContextNetSerializer on the base context, whose quantized state
+ * is kept in a separate allocation because its size is only known at runtime, then the pellet batch.
+ */
+struct FStrafeGameplayEffectContextNetSerializer
+{
+    static const uint32 Version = 0;
+    static constexpr bool bHasDynamicState = true;
+    static constexpr bool bHasCustomNetReference = true;
+
+    struct FQuantizedType
+    {
+        void* BaseState;
+        FPelletImpactBatchNetSerializer::QuantizedType PelletImpacts;
+    };
+
+    typedef FStrafeGameplayEffectContext SourceType;
+    typedef FQuantizedType QuantizedType;
+    typedef FStrafeGameplayEffectContextNetSerializerConfig ConfigType;
+
+    static const ConfigType DefaultConfig;
+
+    static void Serialize(FNetSerializationContext& Context, const FNetSerializeArgs& Args);
+    static void Deserialize(FNetSerializationContext& Context, const FNetDeserializeArgs& Args);
+    static void Quantize(FNetSerializationContext& Context, const FNetQuantizeArgs& Args);
+    static void Dequantize(FNetSerializationContext& Context, const FNetDequantizeArgs& Args);
+    static bool IsEqual(FNetSerializationContext& Context, const FNetIsEqualArgs& Args);
+    static bool Validate(FNetSerializationContext& Context, const FNetValidateArgs& Args);
+    static void CloneDynamicState(FNetSerializationContext& Context, const FNetCloneDynamicStateArgs& Args);
+    static void FreeDynamicState(FNetSerializationContext& Context, const FNetFreeDynamicStateArgs& Args);
+    static void CollectNetReferences(FNetSerializationContext& Context, const FNetCollectReferencesArgs& Args);
+
+private:
+    static const FNetSerializer& GetBaseSerializer() { return UE_NET_GET_SERIALIZER(FGameplayEffectContextNetSerializer); }
+    static void AllocateBaseState(FNetSerializationContext& Context, QuantizedType& Value);
+
+    template<typename ArgsType>
+    static ArgsType MakeBaseArgs(const ArgsType& Args)
+    {
+        ArgsType BaseArgs = Args;
+        BaseArgs.Version = GetBaseSerializer().Version;
+        BaseArgs.NetSerializerConfig = NetSerializerConfigParam(GetBaseSerializer().DefaultConfig);
+        return BaseArgs;
+    }
+
+    template<typename ArgsType>
+    static ArgsType MakePelletArgs(const ArgsType& Args)
+    {
+        ArgsType PelletArgs = Args;
+        PelletArgs.Version = FPelletImpactBatchNetSerializer::Version;
+        PelletArgs.NetSerializerConfig = NetSerializerConfigParam(&FPelletImpactBatchNetSerializer::DefaultConfig);
+        return PelletArgs;
+    }
+};
+UE_NET_IMPLEMENT_SERIALIZER(FStrafeGameplayEffectContextNetSerializer);
+
+const FStrafeGameplayEffectContextNetSerializer::ConfigType FStrafeGameplayEffectContextNetSerializer::DefaultConfig;
+
+void FStrafeGameplayEffectContextNetSerializer::Serialize(FNetSerializationContext& Context, const FNetSerializeArgs& Args)
+{
+    const QuantizedType& Value = *reinterpret_cast<const QuantizedType*>(Args.Source);
+
+    FNetSerializeArgs BaseArgs = MakeBaseArgs(Args);
+    BaseArgs.Source = NetSerializerValuePointer(Value.BaseState);
+    GetBaseSerializer().Serialize(Context, BaseArgs);
+
+    // One bit when there's no pellet payload, which is every context but a shotgun blast's
+    if (Context.GetBitStreamWriter()->WriteBool(Value.PelletImpacts.NumImpacts > 0))
+    {
+        FNetSerializeArgs PelletArgs = MakePelletArgs(Args);
+        PelletArgs.Source = NetSerializerValuePointer(&Value.PelletImpacts);
+        FPelletImpactBatchNetSerializer::Serialize(Context, PelletArgs);
+    }
+}
+
+void FStrafeGameplayEffectContextNetSerializer::Deserialize(FNetSerializationContext& Context, const FNetDeserializeArgs& Args)
+{
+    QuantizedType& Value = *reinterpret_cast<QuantizedType*>(Args.Target);
+    AllocateBaseState(Context, Value);
+
+    FNetDeserializeArgs BaseArgs = MakeBaseArgs(Args);
+    BaseArgs.Target = NetSerializerValuePointer(Value.BaseState);
+    GetBaseSerializer().Deserialize(Context, BaseArgs);
+
+    if (Context.GetBitStreamReader()->ReadBool())
+    {
+        FNetDeserializeArgs PelletArgs = MakePelletArgs(Args);
+        PelletArgs.Target = NetSerializerValuePointer(&Value.PelletImpacts);
+        FPelletImpactBatchNetSerializer::Deserialize(Context, PelletArgs);
+    }
+    else
+    {
+        FNetFreeDynamicStateArgs PelletArgs = MakePelletArgs(FNetFreeDynamicStateArgs());
+        PelletArgs.Source = NetSerializerValuePointer(&Value.PelletImpacts);
+        FPelletImpactBatchNetSerializer::FreeDynamicState(Context, PelletArgs);
+        FMemory::Memzero(Value.PelletImpacts);
+    }
+}
+
+void FStrafeGameplayEffectContextNetSerializer::Quantize(FNetSerializationContext& Context, const FNetQuantizeArgs& Args)
+{
+    const SourceType& Source = *reinterpret_cast<const SourceType*>(Args.Source);
+    QuantizedType& Target = *reinterpret_cast<QuantizedType*>(Args.Target);
+    AllocateBaseState(Context, Target);
+
+    FNetQuantizeArgs BaseArgs = MakeBaseArgs(Args);
+    BaseArgs.Source = NetSerializerValuePointer(static_cast<const FGameplayEffectContext*>(&Source));
+    BaseArgs.Target = NetSerializerValuePointer(Target.BaseState);
+    GetBaseSerializer().Quantize(Context, BaseArgs);
+
+    FNetQuantizeArgs PelletArgs = MakePelletArgs(Args);
+    PelletArgs.Source = NetSerializerValuePointer(&Source.PelletImpacts);
+    PelletArgs.Target = NetSerializerValuePointer(&Target.PelletImpacts);
+    FPelletImpactBatchNetSerializer::Quantize(Context, PelletArgs);
+}
+
+void FStrafeGameplayEffectContextNetSerializer::Dequantize(FNetSerializationContext& Context, const FNetDequantizeArgs& Args)
+{
+    const QuantizedType& Source = *reinterpret_cast<const QuantizedType*>(Args.Source);
+    SourceType& Target = *reinterpret_cast<SourceType*>(Args.Target);
+
+    if (Source.BaseState)
+    {
+        FNetDequantizeArgs BaseArgs = MakeBaseArgs(Args);
+        BaseArgs.Source = NetSerializerValuePointer(Source.BaseState);
+        BaseArgs.Target = NetSerializerValuePointer(static_cast<FGameplayEffectContext*>(&Target));
+        GetBaseSerializer().Dequantize(Context, BaseArgs);
+    }
+
+    FNetDequantizeArgs PelletArgs = MakePelletArgs(Args);
+    PelletArgs.Source = NetSerializerValuePointer(&Source.PelletImpacts);
+    PelletArgs.Target = NetSerializerValuePointer(&Target.PelletImpacts);
+    FPelletImpactBatchNetSerializer::Dequantize(Context, PelletArgs);
+}
+
+bool FStrafeGameplayEffectContextNetSerializer::IsEqual(FNetSerializationContext& Context, const FNetIsEqualArgs& Args)
+{
+    FNetIsEqualArgs BaseArgs = MakeBaseArgs(Args);
+    FNetIsEqualArgs PelletArgs = MakePelletArgs(Args);
+    if (Args.bStateIsQuantized)
+    {
+        const QuantizedType& Value0 = *reinterpret_cast<const QuantizedType*>(Args.Source0);
+        const QuantizedType& Value1 = *reinterpret_cast<const QuantizedType*>(Args.Source1);
+        if (!Value0.BaseState || !Value1.BaseState)
+        {
+            if (Value0.BaseState != Value1.BaseState)
+            {
+                return false;
+            }
+        }
+        else
+        {
+            BaseArgs.Source0 = NetSerializerValuePointer(Value0.BaseState);
+            BaseArgs.Source1 = NetSerializerValuePointer(Value1.BaseState);
+            if (!GetBaseSerializer().IsEqual(Context, BaseArgs))
+            {
+                return false;
+            }
+        }
+
+        PelletArgs.Source0 = NetSerializerValuePointer(&Value0.PelletImpacts);
+        PelletArgs.Source1 = NetSerializerValuePointer(&Value1.PelletImpacts);
+        return FPelletImpactBatchNetSerializer::IsEqual(Context, PelletArgs);
+    }
+
+    const SourceType& Value0 = *reinterpret_cast<const SourceType*>(Args.Source0);
+    const SourceType& Value1 = *reinterpret_cast<const SourceType*>(Args.Source1);
+    BaseArgs.Source0 = NetSerializerValuePointer(static_cast<const FGameplayEffectContext*>(&Value0));
+    BaseArgs.Source1 = NetSerializerValuePointer(static_cast<const FGameplayEffectContext*>(&Value1));
+    PelletArgs.Source0 = NetSerializerValuePointer(&Value0.PelletImpacts);
+    PelletArgs.Source1 = NetSerializerValuePointer(&Value1.PelletImpacts);
+    return GetBaseSerializer().IsEqual(Context, BaseArgs) && FPelletImpactBatchNetSerializer::IsEqual(Context, PelletArgs);
+}
+
+bool FStrafeGameplayEffectContextNetSerializer::Validate(FNetSerializationContext& Context, const FNetValidateArgs& Args)
+{
+    const SourceType& Source = *reinterpret_cast<const SourceType*>(Args.Source);
+
+    FNetValidateArgs BaseArgs = MakeBaseArgs(Args);
+    BaseArgs.Source = NetSerializerValuePointer(static_cast<const FGameplayEffectContext*>(&Source));
+
+    FNetValidateArgs PelletArgs = MakePelletArgs(Args);
+    PelletArgs.Source = NetSerializerValuePointer(&Source.PelletImpacts);
+
+    return GetBaseSerializer().Validate(Context, BaseArgs) && FPelletImpactBatchNetSerializer::Validate(Context, PelletArgs);
+}
+
+void FStrafeGameplayEffectContextNetSerializer::CloneDynamicState(FNetSerializationContext& Context, const FNetCloneDynamicStateArgs& Args)
+{
+    const QuantizedType& Source = *reinterpret_cast<const QuantizedType*>(Args.Source);
+    QuantizedType& Target = *reinterpret_cast<QuantizedType*>(Args.Target);
+    const FNetSerializer& BaseSerializer = GetBaseSerializer();
+
+    // Target starts as a byte copy of Source, so it still points at Source's allocations
+    Target.BaseState = nullptr;
+    if (Source.BaseState)
+    {
+        AllocateBaseState(Context, Target);
+        FMemory::Memcpy(Target.BaseState, Source.BaseState, BaseSerializer.QuantizedTypeSize);
+        if (EnumHasAnyFlags(BaseSerializer.Traits, ENetSerializerTraits::HasDynamicState))
+        {
+            FNetCloneDynamicStateArgs BaseArgs = MakeBaseArgs(Args);
+            BaseArgs.Source = NetSerializerValuePointer(Source.BaseState);
+            BaseArgs.Target = NetSerializerValuePointer(Target.BaseState);
+            BaseSerializer.CloneDynamicState(Context, BaseArgs);
+        }
+    }
+
+    FNetCloneDynamicStateArgs PelletArgs = MakePelletArgs(Args);
+    PelletArgs.Source = NetSerializerValuePointer(&Source.PelletImpacts);
+    PelletArgs.Target = NetSerializerValuePointer(&Target.PelletImpacts);
+    FPelletImpactBatchNetSerializer::CloneDynamicState(Context, PelletArgs);
+}
+
+void FStrafeGameplayEffectContextNetSerializer::FreeDynamicState(FNetSerializationContext& Context, const FNetFreeDynamicStateArgs& Args)
+{
+    QuantizedType& Value = *reinterpret_cast<QuantizedType*>(Args.Source);
+    const FNetSerializer& BaseSerializer = GetBaseSerializer();
+
+    if (Value.BaseState)
+    {
+        if (EnumHasAnyFlags(BaseSerializer.Traits, ENetSerializerTraits::HasDynamicState))
+        {
+            FNetFreeDynamicStateArgs BaseArgs = MakeBaseArgs(Args);
+            BaseArgs.Source = NetSerializerValuePointer(Value.BaseState);
+            BaseSerializer.FreeDynamicState(Context, BaseArgs);
+        }
+        Context.GetInternalContext()->Free(Value.BaseState);
+        Value.BaseState = nullptr;
+    }
+
+    FNetFreeDynamicStateArgs PelletArgs = MakePelletArgs(Args);
+    PelletArgs.Source = NetSerializerValuePointer(&Value.PelletImpacts);
+    FPelletImpactBatchNetSerializer::FreeDynamicState(Context, PelletArgs);
+}
+
+void FStrafeGameplayEffectContextNetSerializer::CollectNetReferences(FNetSerializationContext& Context, const FNetCollectReferencesArgs& Args)
+{
+    // Instigator, causer and source object all live in the base state; the pellets hold no references
+    const QuantizedType& Value = *reinterpret_cast<const QuantizedType*>(Args.Source);
+    const FNetSerializer& BaseSerializer = GetBaseSerializer();
+    if (Value.BaseState && EnumHasAnyFlags(BaseSerializer.Traits, ENetSerializerTraits::HasCustomNetReference))
+    {
+        FNetCollectReferencesArgs BaseArgs = MakeBaseArgs(Args);
+        BaseArgs.Source = NetSerializerValuePointer(Value.BaseState);
+        BaseSerializer.CollectNetReferences(Context, BaseArgs);
+    }
+}
+
+void FStrafeGameplayEffectContextNetSerializer::AllocateBaseState(FNetSerializationContext& Context, QuantizedType& Value)
+{
+    if (!Value.BaseState)
+    {
+        const FNetSerializer& BaseSerializer = GetBaseSerializer();
+        Value.BaseState = Context.GetInternalContext()->Alloc(BaseSerializer.QuantizedTypeSize, BaseSerializer.QuantizedTypeAlignment);
+        FMemory::Memzero(Value.BaseState, BaseSerializer.QuantizedTypeSize);
+    }
+}
+
+// Registered by struct name, so Iris uses them in place of the structs' NetSerialize
+static const FName PropertyNetSerializerRegistry_NAME_PelletImpactBatch("PelletImpactBatch");
+UE_NET_IMPLEMENT_NAMED_STRUCT_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_PelletImpactBatch, FPelletImpactBatchNetSerializer);
+
+static const FName PropertyNetSerializerRegistry_NAME_StrafeGameplayEffectContext("StrafeGameplayEffectContext");
+UE_NET_IMPLEMENT_NAMED_STRUCT_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_StrafeGameplayEffectContext, FStrafeGameplayEffectContextNetSerializer);
+
+class FStrafeNetSerializerRegistryDelegates final : private FNetSerializerRegistryDelegates
+{
+public:
+    virtual ~FStrafeNetSerializerRegistryDelegates();
+
+private:
+    virtual void OnPreFreezeNetSerializerRegistry() override;
+
+    static FStrafeNetSerializerRegistryDelegates Instance;
+};
+
+FStrafeNetSerializerRegistryDelegates FStrafeNetSerializerRegistryDelegates::Instance;
+
+FStrafeNetSerializerRegistryDelegates::~FStrafeNetSerializerRegistryDelegates()
+{
+    UE_NET_UNREGISTER_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_PelletImpactBatch);
+    UE_NET_UNREGISTER_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_StrafeGameplayEffectContext);
+}
+
+void FStrafeNetSerializerRegistryDelegates::OnPreFreezeNetSerializerRegistry()
+{
+    UE_NET_REGISTER_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_PelletImpactBatch);
+    UE_NET_REGISTER_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_StrafeGameplayEffectContext);
+}
+
+}
+
+#endif // UE_WITH_IRIS
@@ -0,0 +1,368 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StrafeReplicationGraph.h"
+#include "BaseWeapon.h"
+#include "BaseWeaponPickup.h"
+#include "ProjectileBase.h"
+#include "ProjectileSpawnReplicator.h"
+#include "StrafeCharacter.h"
+#include "Race/RaceManager.h"
+#include "Race/CheckpointTrigger.h"
+#include "GameModes/RaceGameMode.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerState.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+#include "Engine/NetConnection.h"
+#include "UObject/UObjectIterator.h"
+#include "Net/Core/PushModel/PushModel.h"
+
+DECLARE_STATS_GROUP(TEXT("StrafeNet"), STATGROUP_StrafeNet, STATCAT_Advanced);
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Replicated Objects"), STAT_StrafeNetReplicatedObjects, STATGROUP_StrafeNet);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Polled Property Compares"), STAT_StrafeNetPolledPropertyCompares, STATGROUP_StrafeNet);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Push Model Properties"), STAT_StrafeNetPushModelProperties, STATGROUP_StrafeNet);
+
+void UStrafeReplicationGraph::InitGlobalActorClassSettings()
+{
+    Super::InitGlobalActorClassSettings();
+
+    // Pooled projectiles sleep while parked; the dormancy path keeps awake ones in the dynamic list
+    ClassRepPolicies.Set(AProjectileBase::StaticClass(), EStrafeClassRepPolicy::Spatialize_Dormancy);
+    ClassRepPolicies.Set(AStrafeCharacter::StaticClass(), EStrafeClassRepPolicy::Spatialize_Dynamic);
+    ClassRepPolicies.Set(ABaseWeaponPickup::StaticClass(), EStrafeClassRepPolicy::Spatialize_Dormancy);
+    ClassRepPolicies.Set(ACheckpointTrigger::StaticClass(), EStrafeClassRepPolicy::Spatialize_Dormancy);
+    ClassRepPolicies.Set(ABaseWeapon::StaticClass(), EStrafeClassRepPolicy::NotRouted);
+    ClassRepPolicies.Set(ARaceManager::StaticClass(), EStrafeClassRepPolicy::RelevantAllConnections);
+    ClassRepPolicies.Set(AGameStateBase::StaticClass(), EStrafeClassRepPolicy::RelevantAllConnections);
+    ClassRepPolicies.Set(APlayerState::StaticClass(), EStrafeClassRepPolicy::RelevantAllConnections);
+    ClassRepPolicies.Set(AProjectileSpawnReplicator::StaticClass(), EStrafeClassRepPolicy::RelevantAllConnections);
+    ClassRepPolicies.Set(APlayerController::StaticClass(), EStrafeClassRepPolicy::RelevantOwnerOnly);
+
+    for (TObjectIterator<UClass> It; It; ++It)
+    {
+        UClass* Class = *It;
+        const AActor* ActorCDO = Cast<AActor>(Class->GetDefaultObject(false));
+        if (!ActorCDO || !ActorCDO->GetIsReplicated() || Class->HasAnyClassFlags(CLASS_Abstract | CLASS_NewerVersionExists)
+            || Class->GetName().StartsWith(TEXT("SKEL_")) || Class->GetName().StartsWith(TEXT("REINST_")))
+        {
+            continue;
+        }
+
+        const EStrafeClassRepPolicy Policy = GetClassPolicy(Class, ActorCDO);
+        const bool bSpatialized = Policy == EStrafeClassRepPolicy::Spatialize_Dynamic || Policy == EStrafeClassRepPolicy::Spatialize_Dormancy;
+
+        FClassReplicationInfo ClassInfo;
+        ClassInfo.SetCullDistanceSquared(bSpatialized ? ActorCDO->GetNetCullDistanceSquared() : 0.0f);
+        ClassInfo.ReplicationPeriodFrame = GetReplicationPeriodFrameForFrequency(FMath::Max(ActorCDO->GetNetUpdateFrequency(), 1.0f));
+        GlobalActorReplicationInfoMap.SetClassInfo(Class, ClassInfo);
+    }
+}
+
+void UStrafeReplicationGraph::InitGlobalGraphNodes()
+{
+    PreAllocateRepList(3, 12);
+    PreAllocateRepList(6, 12);
+    PreAllocateRepList(128, 64);
+
+    GridNode = CreateNewNode<UReplicationGraphNode_GridSpatialization2D>();
+    GridNode->CellSize = GridCellSize;
+    GridNode->SpatialBias = SpatialBias;
+    AddGlobalGraphNode(GridNode);
+
+    AlwaysRelevantNode = CreateNewNode<UReplicationGraphNode_ActorList>();
+    AddGlobalGraphNode(AlwaysRelevantNode);
+
+    RaceRivalsNode = CreateNewNode<UReplicationGraphNode_ActorListFrequencyBuckets>();
+    RaceRivalsNode->Settings = MakeShared<UReplicationGraphNode_ActorListFrequencyBuckets::FSettings>();
+    RaceRivalsNode->Settings->NumBuckets = FMath::Max(RaceRivalBuckets, 1);
+    RaceRivalsNode->SetNonStreamingCollectionSize(RaceRivalsNode->Settings->NumBuckets);
+    AddGlobalGraphNode(RaceRivalsNode);
+
+    WeaponOwnerChangedHandle = ABaseWeapon::OnWeaponOwnerChanged.AddUObject(this, &UStrafeReplicationGraph::HandleWeaponOwnerChanged);
+}
+
+void UStrafeReplicationGraph::BeginDestroy()
+{
+    ABaseWeapon::OnWeaponOwnerChanged.Remove(WeaponOwnerChangedHandle);
+    Super::BeginDestroy();
+}
+
+void UStrafeReplicationGraph::InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection)
+{
+    Super::InitConnectionGraphNodes(RepGraphConnection);
+
+    // Also picks up the connection's view target every frame, so the own pawn is never bucketed
+    UReplicationGraphNode_AlwaysRelevant_ForConnection* Node = CreateNewNode<UReplicationGraphNode_AlwaysRelevant_ForConnection>();
+    AddConnectionGraphNode(Node, RepGraphConnection);
+
+    FStrafeConnectionAlwaysRelevantNode& Entry = AlwaysRelevantForConnection.AddDefaulted_GetRef();
+    Entry.NetConnection = RepGraphConnection->NetConnection;
+    Entry.Node = Node;
+}
+
+void UStrafeReplicationGraph::OnRemoveConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection)
+{
+    AlwaysRelevantForConnection.RemoveAllSwap([RepGraphConnection](const FStrafeConnectionAlwaysRelevantNode& Entry)
+    {
+        return Entry.NetConnection == RepGraphConnection->NetConnection;
+    });
+}
+
+UReplicationGraphNode_AlwaysRelevant_ForConnection* UStrafeReplicationGraph::GetAlwaysRelevantNodeForConnection(const UNetConnection* Connection) const
+{
+    const FStrafeConnectionAlwaysRelevantNode* Entry = AlwaysRelevantForConnection.FindByPredicate([Connection](const FStrafeConnectionAlwaysRelevantNode& Candidate)
+    {
+        return Candidate.NetConnection == Connection;
+    });
+    return Entry ? Entry->Node.Get() : nullptr;
+}
+
+bool UStrafeReplicationGraph::IsRaceMode() const
+{
+    const UWorld* World = GetWorld();
+    return World && World->GetAuthGameMode<ARaceGameMode>() != nullptr;
+}
+
+EStrafeClassRepPolicy UStrafeReplicationGraph::GetClassPolicy(const UClass* Class, const AActor* ActorCDO) const
+{
+    if (const EStrafeClassRepPolicy* Policy = ClassRepPolicies.Get(Class))
+    {
+        return *Policy;
+    }
+
+    // Anything we don't know about keeps the meaning of its relevancy flags
+    if (ActorCDO->bAlwaysRelevant)
+    {
+        return EStrafeClassRepPolicy::RelevantAllConnections;
+    }
+    if (ActorCDO->bOnlyRelevantToOwner)
+    {
+        return EStrafeClassRepPolicy::RelevantOwnerOnly;
+    }
+    return ActorCDO->IsReplicatingMovement() ? EStrafeClassRepPolicy::Spatialize_Dynamic : EStrafeClassRepPolicy::Spatialize_Dormancy;
+}
+
+EStrafeClassRepPolicy UStrafeReplicationGraph::GetPolicy(const AActor* Actor) const
+{
+    const EStrafeClassRepPolicy Policy = GetClassPolicy(Actor->GetClass(), Actor);
+    if (Policy == EStrafeClassRepPolicy::Spatialize_Dynamic && Actor->IsA<AStrafeCharacter>() && IsRaceMode())
+    {
+        return EStrafeClassRepPolicy::RaceRival;
+    }
+    return Policy;
+}
+
+void UStrafeReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
+{
+    AActor* Actor = ActorInfo.Actor;
+    switch (GetPolicy(Actor))
+    {
+    case EStrafeClassRepPolicy::NotRouted:
+        if (ABaseWeapon* Weapon = Cast<ABaseWeapon>(Actor))
+        {
+            AddWeapon(Weapon, GlobalInfo);
+        }
+        break;
+
+    case EStrafeClassRepPolicy::RelevantAllConnections:
+        AlwaysRelevantNode->NotifyAddNetworkActor(ActorInfo);
+        break;
+
+    case EStrafeClassRepPolicy::RelevantOwnerOnly:
+        // The owning connection is usually only known a frame later; ServerReplicateActors finishes the routing
+        ActorsWithoutNetConnection.Add(Actor);
+        break;
+
+    case EStrafeClassRepPolicy::Spatialize_Dynamic:
+        GridNode->AddActor_Dynamic(ActorInfo, GlobalInfo);
+        break;
+
+    case EStrafeClassRepPolicy::Spatialize_Dormancy:
+        GridNode->AddActor_Dormancy(ActorInfo, GlobalInfo);
+        break;
+
+    case EStrafeClassRepPolicy::RaceRival:
+        // The class info carries the character CDO's cull distance; rivals must stay relevant at any range
+        GlobalInfo.Settings.SetCullDistanceSquared(0.0f);
+        RaceRivalsNode->NotifyAddNetworkActor(ActorInfo);
+        break;
+    }
+}
+
+void UStrafeReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+    AActor* Actor = ActorInfo.Actor;
+    switch (GetPolicy(Actor))
+    {
+    case EStrafeClassRepPolicy::NotRouted:
+        if (ABaseWeapon* Weapon = Cast<ABaseWeapon>(Actor))
+        {
+            RemoveWeapon(Weapon, Weapon->GetOwner());
+        }
+        break;
+
+    case EStrafeClassRepPolicy::RelevantAllConnections:
+        AlwaysRelevantNode->NotifyRemoveNetworkActor(ActorInfo);
+        SetActorDestructionInfoToIgnoreDistanceCulling(Actor);
+        break;
+
+    case EStrafeClassRepPolicy::RelevantOwnerOnly:
+        if (UReplicationGraphNode_AlwaysRelevant_ForConnection* Node = GetAlwaysRelevantNodeForConnection(Actor->GetNetConnection()))
+        {
+            Node->NotifyRemoveNetworkActor(ActorInfo);
+        }
+        ActorsWithoutNetConnection.RemoveSwap(Actor);
+        break;
+
+    case EStrafeClassRepPolicy::Spatialize_Dynamic:
+    case EStrafeClassRepPolicy::RaceRival:
+        // The game mode may already be gone at teardown, so find racers by where they are rather than by mode
+        if (!Actor->IsA<AStrafeCharacter>() || !RaceRivalsNode->NotifyRemoveNetworkActor(ActorInfo, false))
+        {
+            GridNode->RemoveActor_Dynamic(ActorInfo);
+        }
+        break;
+
+    case EStrafeClassRepPolicy::Spatialize_Dormancy:
+        GridNode->RemoveActor_Dormancy(ActorInfo);
+        break;
+    }
+}
+
+void UStrafeReplicationGraph::AddWeapon(ABaseWeapon* Weapon, FGlobalActorReplicationInfo& GlobalInfo)
+{
+    if (AActor* Owner = Weapon->GetOwner())
+    {
+        GlobalActorReplicationInfoMap.AddDependentActor(Owner, Weapon);
+    }
+    else
+    {
+        GridNode->AddActor_Dormancy(FNewReplicatedActorInfo(Weapon), GlobalInfo);
+    }
+}
+
+void UStrafeReplicationGraph::RemoveWeapon(ABaseWeapon* Weapon, AActor* Owner)
+{
+    if (Owner)
+    {
+        GlobalActorReplicationInfoMap.RemoveDependentActor(Owner, Weapon);
+    }
+    else
+    {
+        GridNode->RemoveActor_Dormancy(FNewReplicatedActorInfo(Weapon));
+    }
+}
+
+void UStrafeReplicationGraph::HandleWeaponOwnerChanged(ABaseWeapon* Weapon, AActor* OldOwner)
+{
+    // Weapons that aren't in this graph yet get routed with their current owner when they are added
+    if (!Weapon || Weapon->GetWorld() != GetWorld() || !GlobalActorReplicationInfoMap.Find(Weapon))
+    {
+        return;
+    }
+
+    RemoveWeapon(Weapon, OldOwner);
+    AddWeapon(Weapon, GlobalActorReplicationInfoMap.Get(Weapon));
+}
+
+int32 UStrafeReplicationGraph::ServerReplicateActors(float DeltaSeconds)
+{
+    for (int32 i = ActorsWithoutNetConnection.Num() - 1; i >= 0; --i)
+    {
+        AActor* Actor = ActorsWithoutNetConnection[i];
+        UNetConnection* Connection = Actor ? Actor->GetNetConnection() : nullptr;
+        if (Actor && !Connection)
+        {
+            continue;
+        }
+
+        if (UReplicationGraphNode_AlwaysRelevant_ForConnection* Node = Actor ? GetAlwaysRelevantNodeForConnection(Connection) : nullptr)
+        {
+            Node->NotifyAddNetworkActor(FNewReplicatedActorInfo(Actor));
+        }
+        ActorsWithoutNetConnection.RemoveAtSwap(i);
+    }
+
+    const uint32 FrameNum = GetReplicationGraphFrame();
+    const int32 NumReplicated = Super::ServerReplicateActors(DeltaSeconds);
+
+#if STATS
+    if (FThreadStats::IsCollectingData())
+    {
+        UpdatePropertyCompareStats(FrameNum);
+    }
+#endif
+
+    return NumReplicated;
+}
+
+void UStrafeReplicationGraph::UpdatePropertyCompareStats(uint32 FrameNum)
+{
+    // An actor's properties are compared once per frame however many connections it goes to, and
+    // PreReplication runs right before that first compare, so its frame stamp tells us who was compared
+    int32 NumObjects = 0;
+    int32 NumPolled = 0;
+    int32 NumPush = 0;
+    for (auto It = GlobalActorReplicationInfoMap.CreateActorMapIterator(); It; ++It)
+    {
+        const AActor* Actor = It.Key();
+        if (!Actor || It.Value()->LastPreReplicationFrame != FrameNum)
+        {
+            continue;
+        }
+
+        const FReplicatedPropertyCounts& ActorCounts = GetReplicatedPropertyCounts(Actor->GetClass());
+        NumPolled += ActorCounts.Polled;
+        NumPush += ActorCounts.Push;
+        ++NumObjects;
+
+        for (const UActorComponent* Component : Actor->GetReplicatedComponents())
+        {
+            if (Component)
+            {
+                const FReplicatedPropertyCounts& ComponentCounts = GetReplicatedPropertyCounts(Component->GetClass());
+                NumPolled += ComponentCounts.Polled;
+                NumPush += ComponentCounts.Push;
+                ++NumObjects;
+            }
+        }
+    }
+
+    SET_DWORD_STAT(STAT_StrafeNetReplicatedObjects, NumObjects);
+    SET_DWORD_STAT(STAT_StrafeNetPolledPropertyCompares, NumPolled);
+    SET_DWORD_STAT(STAT_StrafeNetPushModelProperties, NumPush);
+}
+
+const UStrafeReplicationGraph::FReplicatedPropertyCounts& UStrafeReplicationGraph::GetReplicatedPropertyCounts(const UClass* Class)
+{
+    if (const FReplicatedPropertyCounts* Cached = ReplicatedPropertyCounts.Find(Class))
+    {
+        return *Cached;
+    }
+
+    TArray<FLifetimeProperty> LifetimeProps;
+    Class->GetDefaultObject()->GetLifetimeReplicatedProps(LifetimeProps);
+
+    // Push-based properties are polled like any other while net.IsPushModelEnabled is off
+    const bool bPushModelEnabled = IS_PUSH_MODEL_ENABLED();
+    FReplicatedPropertyCounts Counts;
+    for (const FLifetimeProperty& Property : LifetimeProps)
+    {
+        if (Property.Condition == COND_Never)
+        {
+            continue;
+        }
+
+        if (Property.bIsPushBased && bPushModelEnabled)
+        {
+            ++Counts.Push;
+        }
+        else
+        {
+            ++Counts.Polled;
+        }
+    }
+
+    return ReplicatedPropertyCounts.Add(Class, Counts);
+}
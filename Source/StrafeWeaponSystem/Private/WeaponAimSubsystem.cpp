@@ -0,0 +1,112 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WeaponAimSubsystem.h"
+#include "HitscanTraceQueueSubsystem.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Weapon Aim Trace"), STAT_WeaponAimTrace, STATGROUP_Game);
+
+bool UWeaponAimSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+FWeaponAimResult UWeaponAimSubsystem::GetAim(AController* Controller, bool bTraceAimPoint)
+{
+    if (!Controller)
+    {
+        return FWeaponAimResult();
+    }
+
+    FWeaponAimResult* Aim = Aims.Find(Controller);
+    if (!Aim)
+    {
+        if (LastPruneFrame != GFrameCounter)
+        {
+            LastPruneFrame = GFrameCounter;
+            for (auto It = Aims.CreateIterator(); It; ++It)
+            {
+                if (!It.Key().IsValid())
+                {
+                    It.RemoveCurrent();
+                }
+            }
+        }
+        Aim = &Aims.Add(Controller);
+    }
+
+    if (!Aim->HasCurrentView())
+    {
+        UpdateView(Controller, *Aim);
+    }
+    if (bTraceAimPoint)
+    {
+        UpdateTrace(Controller, *Aim);
+    }
+    return *Aim;
+}
+
+void UWeaponAimSubsystem::UpdateView(AController* Controller, FWeaponAimResult& Aim) const
+{
+    FRotator ViewPointRotation;
+    Controller->GetPlayerViewPoint(Aim.ViewLocation, ViewPointRotation);
+
+    Aim.ViewRotation = Controller->GetControlRotation();
+    Aim.AimDirection = Aim.ViewRotation.Vector();
+    Aim.ViewFrame = GFrameCounter;
+}
+
+void UWeaponAimSubsystem::UpdateTrace(AController* Controller, FWeaponAimResult& Aim)
+{
+    if (Aim.TraceRequestFrame != GFrameCounter)
+    {
+        SCOPE_CYCLE_COUNTER(STAT_WeaponAimTrace);
+
+        UHitscanTraceQueueSubsystem* TraceQueue = GetWorld() ? GetWorld()->GetSubsystem<UHitscanTraceQueueSubsystem>() : nullptr;
+        if (TraceQueue)
+        {
+            FHitscanTraceBatch Batch;
+            Batch.Segments.Emplace(Aim.ViewLocation, Aim.ViewLocation + Aim.AimDirection * AimTraceRange);
+            Batch.Channel = AimTraceChannel;
+            Batch.QueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(WeaponAimTrace), false);
+            if (APawn* Pawn = Controller->GetPawn())
+            {
+                Batch.QueryParams.AddIgnoredActor(Pawn);
+
+                TArray<AActor*> AttachedActors;
+                Pawn->GetAttachedActors(AttachedActors);
+                Batch.QueryParams.AddIgnoredActors(AttachedActors);
+            }
+
+            Batch.OnComplete.BindUObject(this, &UWeaponAimSubsystem::OnAimTraceComplete, TWeakObjectPtr<AController>(Controller));
+            TraceQueue->QueueTraces(MoveTemp(Batch));
+        }
+        Aim.TraceRequestFrame = GFrameCounter;
+    }
+
+    // The view moves on while the trace is out; its depth carries over far better than its impact point
+    const bool bRecent = Aim.HasRecentTrace();
+    Aim.AimPoint = Aim.ViewLocation + Aim.AimDirection * (bRecent && Aim.bAimTraceHit ? Aim.AimTraceDistance : AimTraceRange);
+    if (!bRecent)
+    {
+        Aim.bAimTraceHit = false;
+        Aim.AimActor = nullptr;
+    }
+}
+
+void UWeaponAimSubsystem::OnAimTraceComplete(TConstArrayView<FHitscanTraceResult> Results, TWeakObjectPtr<AController> Controller)
+{
+    FWeaponAimResult* Aim = Aims.Find(Controller);
+    if (!Aim || Results.Num() == 0)
+    {
+        return;
+    }
+
+    const FHitscanTraceResult& Result = Results[0];
+    Aim->bAimTraceHit = Result.bBlockingHit;
+    Aim->AimTraceDistance = Result.bBlockingHit ? Result.Hit.Distance : AimTraceRange;
+    Aim->AimActor = Result.bBlockingHit ? Result.Hit.GetActor() : nullptr;
+    Aim->TraceFrame = GFrameCounter;
+}
@@ -2,4 +2,107 @@
 
 
 #include "WeaponDataAsset.h"
+#include "AmmoComponent.h"
+#include "AbilitySystemComponent.h"
+#include "GameplayEffect.h"
+#include "StrafeGameplayTags.h"
 
+namespace
+{
+    void AddSetByCallerOverride(UGameplayEffect* Effect, const FGameplayAttribute& Attribute, const FGameplayTag& DataTag)
+    {
+        FSetByCallerFloat SetByCaller;
+        SetByCaller.DataTag = DataTag;
+
+        FGameplayModifierInfo& Modifier = Effect->Modifiers.AddDefaulted_GetRef();
+        Modifier.Attribute = Attribute;
+        Modifier.ModifierOp = EGameplayModOp::Override;
+        Modifier.ModifierMagnitude = FGameplayEffectModifierMagnitude(SetByCaller);
+    }
+}
+
+bool UWeaponDataAsset::GetAmmo(const UAbilitySystemComponent* ASC, float& OutCurrent, float& OutMax) const
+{
+    OutCurrent = 0.0f;
+    OutMax = 0.0f;
+    if (!ASC)
+    {
+        return false;
+    }
+
+    if (AmmoTypeTag.IsValid())
+    {
+        const UAmmoComponent* AmmoComponent = UAmmoComponent::FindAmmoComponent(ASC->GetAvatarActor());
+        const FAmmoEntry* Entry = AmmoComponent ? AmmoComponent->FindEntry(AmmoTypeTag) : nullptr;
+        if (!Entry)
+        {
+            // Not carried (or not replicated yet), which reads as empty
+            return AmmoComponent != nullptr;
+        }
+        // Includes the owning client's predicted spends
+        OutCurrent = AmmoComponent->GetAmmo(AmmoTypeTag);
+        OutMax = Entry->Max;
+        return true;
+    }
+
+    if (AmmoAttribute.IsValid() && ASC->HasAttributeSetForAttribute(AmmoAttribute))
+    {
+        OutCurrent = ASC->GetNumericAttribute(AmmoAttribute);
+        OutMax = MaxAmmoAttribute.IsValid() ? ASC->GetNumericAttribute(MaxAmmoAttribute) : 0.0f;
+        return true;
+    }
+    return false;
+}
+
+void UWeaponDataAsset::PostLoad()
+{
+    Super::PostLoad();
+
+    // Build the ammo init effect with the asset rather than on its first grant, which is usually a round-start respawn
+    if (IsInGameThread() && !HasAnyFlags(RF_ClassDefaultObject))
+    {
+        GetAmmoInitEffect();
+    }
+}
+
+const UGameplayEffect* UWeaponDataAsset::GetAmmoInitEffect() const
+{
+    if (!AmmoInitEffect && AmmoAttribute.IsValid() && MaxAmmoAttribute.IsValid())
+    {
+        // Magnitudes come in through SetByCaller, so one effect per asset covers every grant
+        UWeaponDataAsset* MutableThis = const_cast<UWeaponDataAsset*>(this);
+        UGameplayEffect* Effect = NewObject<UGameplayEffect>(MutableThis, MakeUniqueObjectName(MutableThis, UGameplayEffect::StaticClass(), TEXT("AmmoInitEffect")), RF_Transient);
+        Effect->DurationPolicy = EGameplayEffectDurationType::Instant;
+        AddSetByCallerOverride(Effect, AmmoAttribute, StrafeGameplayTags::SetByCaller_AmmoInitial);
+        AddSetByCallerOverride(Effect, MaxAmmoAttribute, StrafeGameplayTags::SetByCaller_AmmoMax);
+        AmmoInitEffect = Effect;
+    }
+    return AmmoInitEffect;
+}
+
+FGameplayEffectSpecHandle UWeaponDataAsset::MakeAmmoInitSpec(const UAbilitySystemComponent* ASC, UObject* SourceObject) const
+{
+    const UGameplayEffect* Effect = GetAmmoInitEffect();
+    if (!ASC || !Effect)
+    {
+        return FGameplayEffectSpecHandle();
+    }
+
+    FGameplayEffectContextHandle ContextHandle = ASC->MakeEffectContext();
+    ContextHandle.AddSourceObject(SourceObject);
+
+    FGameplayEffectSpecHandle SpecHandle(new FGameplayEffectSpec(Effect, ContextHandle, 1.0f));
+    SpecHandle.Data->SetSetByCallerMagnitude(StrafeGameplayTags::SetByCaller_AmmoInitial, InitialAmmoCount);
+    SpecHandle.Data->SetSetByCallerMagnitude(StrafeGameplayTags::SetByCaller_AmmoMax, DefaultMaxAmmo);
+    return SpecHandle;
+}
+
+#if WITH_EDITOR
+void UWeaponDataAsset::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+
+    // The cached effect bakes in the attributes
+    AmmoInitEffect = nullptr;
+}
+#endif
@@ -1,10 +1,12 @@
 #include "WeaponInventoryComponent.h"
 #include "BaseWeapon.h"
 #include "WeaponDataAsset.h" // For accessing WeaponData on AddWeapon
+#include "AmmoComponent.h"
 #include "StrafeCharacter.h" // To get AbilitySystemComponent
 #include "AbilitySystemComponent.h" // For applying GEs
 #include "GameplayEffectTypes.h" // For FGameplayEffectContextHandle
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 #include "Engine/ActorChannel.h"
 #include "Engine/Engine.h" 
 
@@ -26,8 +28,11 @@ void UWeaponInventoryComponent::GetLifetimeReplicatedProps(TArray<FLifetimePrope
 {
     Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-    DOREPLIFETIME(UWeaponInventoryComponent, WeaponInventory);
-    DOREPLIFETIME(UWeaponInventoryComponent, CurrentWeapon);
+    // Push model: AddWeapon, EquipWeapon and FinishWeaponSwitch mark what they change
+    FDoRepLifetimeParams Params;
+    Params.bIsPushBased = true;
+    DOREPLIFETIME_WITH_PARAMS_FAST(UWeaponInventoryComponent, WeaponInventory, Params);
+    DOREPLIFETIME_WITH_PARAMS_FAST(UWeaponInventoryComponent, CurrentWeapon, Params);
     // DOREPLIFETIME(UWeaponInventoryComponent, AmmoReserves); // Removed
 }
 
@@ -94,6 +99,7 @@ bool UWeaponInventoryComponent::AddWeapon(TSubclassOf<ABaseWeapon> WeaponClass)
     {
         UE_LOG(LogTemp, Warning, TEXT("Successfully spawned weapon: %s"), *NewWeapon->GetName());
         WeaponInventory.Add(NewWeapon);
+        MARK_PROPERTY_DIRTY_FROM_NAME(UWeaponInventoryComponent, WeaponInventory, this);
         NewWeapon->SetOwner(OwnerActor);
         NewWeapon->AttachToComponent(OwnerActor->GetRootComponent(), FAttachmentTransformRules::SnapToTargetNotIncludingScale);
         NewWeapon->SetActorHiddenInGame(true); // Hide until equipped
@@ -106,33 +112,26 @@ bool UWeaponInventoryComponent::AddWeapon(TSubclassOf<ABaseWeapon> WeaponClass)
         UWeaponDataAsset* WeaponData = NewWeapon->GetWeaponData();
         UAbilitySystemComponent* ASC = Character ? Character->GetAbilitySystemComponent() : nullptr;
 
-        if (ASC && WeaponData && WeaponData->AmmoAttribute.IsValid() && WeaponData->MaxAmmoAttribute.IsValid())
+        UAmmoComponent* AmmoComponent = Character ? Character->GetAmmoComponent() : nullptr;
+
+        if (AmmoComponent && WeaponData && WeaponData->AmmoTypeTag.IsValid())
         {
-            // Create a dynamic GameplayEffect to set initial and max ammo
-            UGameplayEffect* AmmoInitEffect = NewObject<UGameplayEffect>(GetTransientPackage(), FName(TEXT("AmmoInitEffect")));
-            AmmoInitEffect->DurationPolicy = EGameplayEffectDurationType::Instant;
-
-            // Modifier for Initial Ammo
-            int32 InitialAmmoModIndex = AmmoInitEffect->Modifiers.Num();
-            AmmoInitEffect->Modifiers.SetNum(InitialAmmoModIndex + 1);
-            FGameplayModifierInfo& ModInitialAmmo = AmmoInitEffect->Modifiers[InitialAmmoModIndex];
-            ModInitialAmmo.Attribute = WeaponData->AmmoAttribute;
-            ModInitialAmmo.ModifierOp = EGameplayModOp::Override; // Or Add if you want to add to existing
-            ModInitialAmmo.ModifierMagnitude = FScalableFloat(WeaponData->InitialAmmoCount);
-
-            // Modifier for Max Ammo
-            int32 MaxAmmoModIndex = AmmoInitEffect->Modifiers.Num();
-            AmmoInitEffect->Modifiers.SetNum(MaxAmmoModIndex + 1);
-            FGameplayModifierInfo& ModMaxAmmo = AmmoInitEffect->Modifiers[MaxAmmoModIndex];
-            ModMaxAmmo.Attribute = WeaponData->MaxAmmoAttribute;
-            ModMaxAmmo.ModifierOp = EGameplayModOp::Override;
-            ModMaxAmmo.ModifierMagnitude = FScalableFloat(WeaponData->DefaultMaxAmmo);
-
-            FGameplayEffectContextHandle ContextHandle = ASC->MakeEffectContext();
-            ContextHandle.AddSourceObject(NewWeapon); // Source is the weapon itself
-            ASC->ApplyGameplayEffectToSelf(AmmoInitEffect, 1.0f, ContextHandle);
-
-            UE_LOG(LogTemp, Log, TEXT("Applied initial ammo (%f) and max ammo (%f) for %s via dynamic GE."), WeaponData->InitialAmmoCount, WeaponData->DefaultMaxAmmo, *WeaponData->AmmoAttribute.GetName());
+            // Weapons can share an ammo type; picking up a second one never takes ammo away
+            const int32 InitialAmmo = FMath::Max(AmmoComponent->GetAmmo(WeaponData->AmmoTypeTag), FMath::RoundToInt(WeaponData->InitialAmmoCount));
+            AmmoComponent->SetAmmo(WeaponData->AmmoTypeTag, InitialAmmo, FMath::RoundToInt(WeaponData->DefaultMaxAmmo));
+
+            UE_LOG(LogTemp, Log, TEXT("Initialized %s ammo (%d/%d) for %s."), *WeaponData->AmmoTypeTag.ToString(), AmmoComponent->GetAmmo(WeaponData->AmmoTypeTag), AmmoComponent->GetMaxAmmo(WeaponData->AmmoTypeTag), *WeaponClass->GetName());
+        }
+        else if (ASC && WeaponData && WeaponData->AmmoAttribute.IsValid() && WeaponData->MaxAmmoAttribute.IsValid())
+        {
+            // The data asset's cached effect; only the spec is new per grant
+            const FGameplayEffectSpecHandle AmmoInitSpec = WeaponData->MakeAmmoInitSpec(ASC, NewWeapon); // Source is the weapon itself
+            if (AmmoInitSpec.IsValid())
+            {
+                ASC->ApplyGameplayEffectSpecToSelf(*AmmoInitSpec.Data.Get());
+            }
+
+            UE_LOG(LogTemp, Log, TEXT("Applied initial ammo (%f) and max ammo (%f) for %s via cached ammo init effect."), WeaponData->InitialAmmoCount, WeaponData->DefaultMaxAmmo, *WeaponData->AmmoAttribute.GetName());
         }
         else
         {
@@ -149,6 +148,12 @@ bool UWeaponInventoryComponent::AddWeapon(TSubclassOf<ABaseWeapon> WeaponClass)
                 UE_LOG(LogTemp, Log, TEXT("AddWeapon: %s does not use standard ammo attributes or they are not set in its WeaponDataAsset."), *WeaponClass->GetName());
             }
         }
+
+        // Granted once for as long as the weapon is carried; equipping only flips the equipped tag
+        if (Character)
+        {
+            Character->GrantWeaponAbilities(NewWeapon);
+        }
         return true;
     }
     UE_LOG(LogTemp, Error, TEXT("Failed to spawn weapon actor for %s"), *WeaponClass->GetName());
@@ -180,6 +185,7 @@ void UWeaponInventoryComponent::EquipWeapon(TSubclassOf<ABaseWeapon> WeaponClass
             CurrentWeapon->Unequip();
         }
         CurrentWeapon = nullptr;
+        MARK_PROPERTY_DIRTY_FROM_NAME(UWeaponInventoryComponent, CurrentWeapon, this);
         OnRep_CurrentWeapon(); // Notify clients
         OnWeaponEquipped.Broadcast(nullptr); // Notify local systems on server + character
         return;
@@ -249,6 +255,7 @@ void UWeaponInventoryComponent::FinishWeaponSwitch()
         }
         CurrentWeapon = PendingWeapon;
         PendingWeapon = nullptr;
+        MARK_PROPERTY_DIRTY_FROM_NAME(UWeaponInventoryComponent, CurrentWeapon, this);
 
         ACharacter* OwnerCharacter = Cast<ACharacter>(GetOwner());
         if (OwnerCharacter && CurrentWeapon)
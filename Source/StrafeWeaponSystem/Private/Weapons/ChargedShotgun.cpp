@@ -9,6 +9,11 @@
 #include "NiagaraComponent.h"
 #include "GameFramework/DamageType.h"
 #include "AbilitySystemComponent.h"
+#include "LagCompensationSubsystem.h"
+#include "HitscanTraceQueueSubsystem.h"
+#include "Weapons/PelletSpread.h"
+#include "StrafeGameplayEffectContext.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
 
 AChargedShotgun::AChargedShotgun()
 {
@@ -31,7 +36,10 @@ void AChargedShotgun::PerformHitscanShot(
     TSubclassOf<class UDamageType> DamageTypeClass,
     APawn* InstigatorPawn,
     AController* InstigatorController,
-    FGameplayTag OptionalImpactCueTag)
+    FGameplayTag OptionalImpactCueTag,
+    int32 SpreadSeed,
+    const TArray<FVector2D>& SpreadPattern,
+    bool bRotateSpreadPattern)
 {
     UE_LOG(LogTemp, Log, TEXT("AChargedShotgun::PerformHitscanShot - PelletCount: %d, Spread: %f, Range: %f"),
         PelletCount, SpreadAngle, HitscanRange);
@@ -49,67 +57,116 @@ void AChargedShotgun::PerformHitscanShot(
         return;
     }
 
+    UHitscanTraceQueueSubsystem* TraceQueue = World->GetSubsystem<UHitscanTraceQueueSubsystem>();
+    if (!TraceQueue)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("AChargedShotgun::PerformHitscanShot - No hitscan trace queue in this world"));
+        return;
+    }
+
     UAbilitySystemComponent* SourceASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(InstigatorPawn);
 
-    for (int32 i = 0; i < PelletCount; ++i)
+    FPelletShot Shot;
+    Shot.StartLocation = StartLocation;
+    Shot.AimDirection = AimDirection;
+    Shot.HitscanRange = HitscanRange;
+    Shot.DamageToApply = DamageToApply;
+    Shot.DamageTypeClass = DamageTypeClass;
+    Shot.InstigatorPawn = InstigatorPawn;
+    Shot.InstigatorController = InstigatorController;
+    Shot.ImpactCueTag = OptionalImpactCueTag;
+    Shot.SourceASC = SourceASC;
+    // Callers fire inside the activation's prediction window; the cue is executed under the same key later
+    Shot.PredictionKey = SourceASC ? SourceASC->ScopedPredictionKey : FPredictionKey();
+
+    // Seeded, so the server reproduces exactly the spread the predicting client rendered
+    Shot.PelletDirs.SetNum(FMath::Max(PelletCount, 0));
+    FPelletSpread::GenerateDirections(SpreadSeed, AimDirection, SpreadAngle, SpreadPattern, bRotateSpreadPattern, Shot.PelletDirs);
+
+    FHitscanTraceBatch Batch;
+    Batch.Segments.Reserve(Shot.PelletDirs.Num());
+    for (const FVector& PelletDir : Shot.PelletDirs)
     {
-        // Calculate spread for each pellet
-        // This is a common way to do it: random point in a circle perpendicular to aim, then project.
-        // For simplicity here, we'll use a simpler cone spread.
-        const float HalfAngleRad = FMath::DegreesToRadians(SpreadAngle * 0.5f);
-        const FVector PelletDir = FMath::VRandCone(AimDirection, HalfAngleRad);
-
-        FVector TraceStart = StartLocation;
-        FVector TraceEnd = TraceStart + (PelletDir * HitscanRange);
-
-        FHitResult HitResult;
-        FCollisionQueryParams QueryParams;
-        QueryParams.AddIgnoredActor(this); // Ignore the weapon itself
-        QueryParams.AddIgnoredActor(InstigatorPawn); // Ignore the firer
-        QueryParams.bReturnPhysicalMaterial = true; // Useful for varied impact effects
-
-        bool bHit = GetWorld()->LineTraceSingleByChannel(
-            HitResult,
-            TraceStart,
-            TraceEnd,
-            ECC_Visibility, // Or a custom trace channel for projectiles/weapon fire
-            QueryParams
-        );
+        Batch.Segments.Emplace(StartLocation, StartLocation + (PelletDir * HitscanRange));
+    }
 
-        FVector EndPoint = bHit ? HitResult.ImpactPoint : TraceEnd;
+    Batch.Channel = ECC_Visibility; // Or a custom trace channel for projectiles/weapon fire
+    Batch.QueryParams.AddIgnoredActor(this); // Ignore the weapon itself
+    Batch.QueryParams.AddIgnoredActor(InstigatorPawn); // Ignore the firer
+    Batch.QueryParams.bReturnPhysicalMaterial = true; // Useful for varied impact effects
 
-        // Play impact effect using Gameplay Cue
-        if (OptionalImpactCueTag.IsValid() && SourceASC)
+    if (HasAuthority())
+    {
+        // Trace against targets where the shooter saw them; only the characters inside the blast cone move
+        FLagCompensationQuery LagCompensationQuery;
+        LagCompensationQuery.Origin = StartLocation;
+        LagCompensationQuery.Direction = AimDirection.GetSafeNormal();
+        LagCompensationQuery.Range = HitscanRange;
+        LagCompensationQuery.HalfAngleRadians = FMath::DegreesToRadians(SpreadAngle * 0.5f);
+
+        Batch.LagCompensatedShooter = InstigatorController;
+        Batch.LagCompensationQuery = LagCompensationQuery;
+    }
+
+    // Started with every other shot of the frame once all actors have ticked; resolved during the next frame
+    Batch.OnComplete.BindUObject(this, &AChargedShotgun::ResolvePelletTraces, MoveTemp(Shot));
+    TraceQueue->QueueTraces(MoveTemp(Batch));
+}
+
+void AChargedShotgun::ResolvePelletTraces(TConstArrayView<FHitscanTraceResult> Results, FPelletShot Shot)
+{
+    UWorld* World = GetWorld();
+    APawn* InstigatorPawn = Shot.InstigatorPawn.Get();
+    if (!World || !InstigatorPawn)
+    {
+        return;
+    }
+
+    UAbilitySystemComponent* SourceASC = Shot.SourceASC.Get();
+    const FVector& StartLocation = Shot.StartLocation;
+
+    // One entry per damaged actor; the first pellet that reached it supplies the hit and direction
+    struct FPelletDamage
+    {
+        AActor* Actor = nullptr;
+        int32 FirstPellet = INDEX_NONE;
+        int32 NumPellets = 0;
+    };
+    TArray<FPelletDamage, TInlineAllocator<8>> DamagedActors;
+
+    FPelletImpactBatch ImpactBatch;
+    ImpactBatch.Origin = StartLocation;
+
+    for (int32 i = 0; i < Results.Num(); ++i)
+    {
+        const FVector& PelletDir = Shot.PelletDirs[i];
+        const FHitResult& HitResult = Results[i].Hit;
+        const bool bHit = Results[i].bBlockingHit;
+
+        const FVector TraceEnd = StartLocation + (PelletDir * Shot.HitscanRange);
+        const FVector EndPoint = bHit ? FVector(HitResult.ImpactPoint) : TraceEnd;
+
+        if (bHit && ImpactBatch.Impacts.Num() < FPelletImpactBatch::MaxImpacts)
         {
-            FGameplayCueParameters CueParams;
-            CueParams.Location = EndPoint;
-            CueParams.Normal = HitResult.ImpactNormal; // If bHit is true, otherwise AimDirection
-            CueParams.PhysicalMaterial = HitResult.PhysMaterial;
-            CueParams.Instigator = InstigatorPawn;
-            CueParams.EffectContext = SourceASC->MakeEffectContext();
-            CueParams.EffectContext.AddSourceObject(this);
-
-            // Differentiate between surface hit and no-hit for the cue if needed
-            // For example, by adding a GameplayTag to CueParams.AggregatedSourceTags or TargetTags
-            if (bHit)
+            FPelletImpact& Impact = ImpactBatch.Impacts.AddDefaulted_GetRef();
+            Impact.Location = HitResult.ImpactPoint;
+            Impact.Normal = HitResult.ImpactNormal;
+            if (const UPhysicalMaterial* PhysMaterial = HitResult.PhysMaterial.Get())
             {
-                CueParams.TargetAttachComponent = HitResult.GetComponent(); // Attach to what was hit
+                Impact.SurfaceType = PhysMaterial->SurfaceType;
             }
-            SourceASC->ExecuteGameplayCue(OptionalImpactCueTag, CueParams);
         }
 
-        // Apply damage if something was hit
-        if (bHit && HitResult.GetActor())
+        if (AActor* HitActor = bHit ? HitResult.GetActor() : nullptr)
         {
-            UGameplayStatics::ApplyPointDamage(
-                HitResult.GetActor(),
-                DamageToApply,
-                PelletDir, // Direction of this pellet
-                HitResult,
-                InstigatorController,
-                this, // Damage causer (the weapon)
-                DamageTypeClass
-            );
+            FPelletDamage* Damage = DamagedActors.FindByPredicate([HitActor](const FPelletDamage& Entry) { return Entry.Actor == HitActor; });
+            if (!Damage)
+            {
+                Damage = &DamagedActors.AddDefaulted_GetRef();
+                Damage->Actor = HitActor;
+                Damage->FirstPellet = i;
+            }
+            ++Damage->NumPellets;
         }
 
         // Debug drawing (optional, remove for release)
@@ -118,8 +175,73 @@ void AChargedShotgun::PerformHitscanShot(
         // For multiplayer, consider using a replicated debug draw system if needed.
         if (GetNetMode() != NM_DedicatedServer) // Only draw on clients/listen server
         {
-            DrawDebugLine(GetWorld(), TraceStart, EndPoint, FColor::Red, false, 1.0f, 0, 0.5f);
-            if (bHit) DrawDebugSphere(GetWorld(), HitResult.ImpactPoint, 5.f, 8, FColor::Yellow, false, 1.0f);
+            DrawDebugLine(World, StartLocation, EndPoint, FColor::Red, false, 1.0f, 0, 0.5f);
+            if (bHit) DrawDebugSphere(World, HitResult.ImpactPoint, 5.f, 8, FColor::Yellow, false, 1.0f);
         }
     }
-}
\ No newline at end of file
+
+    // One impact cue for the whole blast; the cue reads every impact back with GetPelletImpacts
+    if (Shot.ImpactCueTag.IsValid() && SourceASC)
+    {
+        FGameplayCueParameters CueParams;
+        CueParams.Location = StartLocation;
+        CueParams.Normal = Shot.AimDirection;
+        CueParams.Instigator = InstigatorPawn;
+        CueParams.EffectContext = SourceASC->MakeEffectContext();
+        CueParams.EffectContext.AddSourceObject(this);
+
+        if (FStrafeGameplayEffectContext* StrafeContext = FStrafeGameplayEffectContext::ExtractEffectContext(CueParams.EffectContext))
+        {
+            StrafeContext->PelletImpacts = MoveTemp(ImpactBatch);
+        }
+        else
+        {
+            UE_LOG(LogTemp, Warning, TEXT("AChargedShotgun::ResolvePelletTraces - Effect context is not FStrafeGameplayEffectContext, impact points are not sent. Check AbilitySystemGlobalsClassName."));
+        }
+
+        if (HasAuthority())
+        {
+            // Carries the activation's key, so the predicting client skips it
+            FScopedPredictionWindow ScopedPrediction(SourceASC, Shot.PredictionKey);
+            SourceASC->ExecuteGameplayCue(Shot.ImpactCueTag, CueParams);
+        }
+        else if (InstigatorPawn->IsLocallyControlled() && Shot.PredictionKey.IsLocalClientKey())
+        {
+            // Same seed, same pellets: the shooter sees its impacts now instead of a round trip later.
+            // Without a local key the server's cue isn't skipped here, so playing it now would double it.
+            SourceASC->ExecuteGameplayCueLocal(Shot.ImpactCueTag, CueParams);
+        }
+    }
+
+    if (!HasAuthority())
+    {
+        return;
+    }
+
+    // Damage summed per actor and applied once
+    for (const FPelletDamage& Damage : DamagedActors)
+    {
+        UGameplayStatics::ApplyPointDamage(
+            Damage.Actor,
+            Shot.DamageToApply * Damage.NumPellets,
+            Shot.PelletDirs[Damage.FirstPellet],
+            Results[Damage.FirstPellet].Hit,
+            Shot.InstigatorController.Get(),
+            this, // Damage causer (the weapon)
+            Shot.DamageTypeClass
+        );
+    }
+}
+
+bool AChargedShotgun::GetPelletImpacts(const FGameplayCueParameters& Parameters, TArray<FPelletImpact>& OutImpacts)
+{
+    const FStrafeGameplayEffectContext* StrafeContext = FStrafeGameplayEffectContext::ExtractEffectContext(Parameters.EffectContext);
+    if (!StrafeContext)
+    {
+        OutImpacts.Reset();
+        return false;
+    }
+
+    OutImpacts = StrafeContext->PelletImpacts.Impacts;
+    return OutImpacts.Num() > 0;
+}
@@ -2,11 +2,12 @@
 
 #include "Weapons/GA_ChargedShotgun_PrimaryFire.h"
 #include "Weapons/ChargedShotgun.h" // Specific weapon
+#include "WeaponAimSubsystem.h"
 #include "WeaponDataAsset.h" // Access to weapon stats and GEs
 #include "StrafeCharacter.h" // Or your base character class
 #include "AbilitySystemComponent.h"
 #include "AbilitySystemBlueprintLibrary.h"
-#include "GameplayTagsManager.h"
+#include "StrafeGameplayTags.h"
 #include "Abilities/Tasks/AbilityTask_WaitInputRelease.h"
 #include "Abilities/Tasks/AbilityTask_PlayMontageAndWait.h"
 #include "Abilities/Tasks/AbilityTask_WaitDelay.h"
@@ -27,14 +28,14 @@ UGA_ChargedShotgun_PrimaryFire::UGA_ChargedShotgun_PrimaryFire()
     bChargeComplete = false;
     bInputReleasedEarly = false;
 
-    ChargeInProgressTag = FGameplayTag::RequestGameplayTag(FName("State.Weapon.ChargedShotgun.Charging.PrimaryFire"));
+    ChargeInProgressTag = StrafeGameplayTags::State_Weapon_ChargedShotgun_Charging_PrimaryFire;
 
     // Add tags directly to the AbilityTags member in the constructor
-    AbilityTags.AddTag(FGameplayTag::RequestGameplayTag(FName("Ability.Weapon.PrimaryFire")));
-    AbilityTags.AddTag(FGameplayTag::RequestGameplayTag(FName("Ability.Weapon.ChargedShotgun.PrimaryFire")));
+    AbilityTags.AddTag(StrafeGameplayTags::Ability_Weapon_PrimaryFire);
+    AbilityTags.AddTag(StrafeGameplayTags::Ability_Weapon_ChargedShotgun_PrimaryFire);
 
 
-    ActivationBlockedTags.AddTag(FGameplayTag::RequestGameplayTag(FName("Cooldown.Weapon.ChargedShotgun.PrimaryFire")));
+    ActivationBlockedTags.AddTag(StrafeGameplayTags::Cooldown_Weapon_ChargedShotgun_PrimaryFire);
 }
 
 bool UGA_ChargedShotgun_PrimaryFire::CanActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayTagContainer* SourceTags, const FGameplayTagContainer* TargetTags, OUT FGameplayTagContainer* OptionalRelevantTags) const
@@ -69,13 +70,15 @@ bool UGA_ChargedShotgun_PrimaryFire::CanActivateAbility(const FGameplayAbilitySp
     }
 
     UAbilitySystemComponent* ASC = ActorInfo->AbilitySystemComponent.Get();
-    if (ASC && TempWeaponData->AmmoAttribute.IsValid())
+    float CurrentAmmo = 0.0f;
+    float MaxAmmo = 0.0f;
+    if (ASC && TempWeaponData->GetAmmo(ASC, CurrentAmmo, MaxAmmo))
     {
-        if (ASC->GetNumericAttribute(TempWeaponData->AmmoAttribute) <= 0)
+        if (CurrentAmmo <= 0)
         {
             if (OptionalRelevantTags)
             {
-                OptionalRelevantTags->AddTag(FGameplayTag::RequestGameplayTag(FName("Ability.Feedback.OutOfAmmo")));
+                OptionalRelevantTags->AddTag(StrafeGameplayTags::Ability_Feedback_OutOfAmmo);
             }
             if (TempWeaponData->EmptySound)
             {
@@ -84,12 +87,12 @@ bool UGA_ChargedShotgun_PrimaryFire::CanActivateAbility(const FGameplayAbilitySp
             return false;
         }
     }
-    else if (!ASC || (TempWeaponData && !TempWeaponData->AmmoAttribute.IsValid()))
+    else
     {
-        UE_LOG(LogTemp, Warning, TEXT("GA_Shotgun_PrimaryFire::CanActivateAbility: ASC or AmmoAttribute is invalid. Ammo check skipped."));
+        UE_LOG(LogTemp, Warning, TEXT("GA_Shotgun_PrimaryFire::CanActivateAbility: ASC is null or the weapon has no readable ammo. Ammo check skipped."));
     }
 
-    FGameplayTag WeaponLockoutTag = FGameplayTag::RequestGameplayTag(FName("State.Weapon.ChargedShotgun.Lockout"));
+    const FGameplayTag& WeaponLockoutTag = StrafeGameplayTags::State_Weapon_ChargedShotgun_Lockout;
     if (ASC && ASC->HasMatchingGameplayTag(WeaponLockoutTag))
     {
         if (OptionalRelevantTags) OptionalRelevantTags->AddTag(WeaponLockoutTag);
@@ -270,14 +273,13 @@ void UGA_ChargedShotgun_PrimaryFire::PerformShot()
         return;
     }
 
-    APlayerController* PC = Cast<APlayerController>(Controller);
-
     if (AmmoCostGEClass)
     {
         FGameplayEffectSpecHandle SpecHandle = MakeOutgoingGameplayEffectSpec(AmmoCostGEClass, GetAbilityLevel());
         if (SpecHandle.IsValid())
         {
             ApplyGameplayEffectSpecToOwner(GetCurrentAbilitySpecHandle(), GetCurrentActorInfo(), GetCurrentActivationInfo(), SpecHandle);
+            PredictAmmoSpend(AmmoCostGEClass.GetDefaultObject(), GetCurrentAbilitySpecHandle(), GetCurrentActorInfo());
         }
     }
     else
@@ -287,11 +289,12 @@ void UGA_ChargedShotgun_PrimaryFire::PerformShot()
 
     ApplyPrimaryFireCooldown();
 
-    FVector MuzzleLocationForEffects;
-    FRotator AimRotation;
+    // View only; pellets don't need the shared aim trace
+    UWeaponAimSubsystem* AimSubsystem = GetWorld()->GetSubsystem<UWeaponAimSubsystem>();
+    const FWeaponAimResult Aim = AimSubsystem ? AimSubsystem->GetAim(Controller, false) : FWeaponAimResult();
 
-    AimRotation = Controller->GetControlRotation();
-    FVector AimDirection = AimRotation.Vector();
+    FVector MuzzleLocationForEffects;
+    const FVector AimDirection = Aim.AimDirection;
 
     if (EquippedWeapon->GetWeaponMeshComponent() && WeaponData->MuzzleFlashSocketName != NAME_None)
     {
@@ -299,9 +302,7 @@ void UGA_ChargedShotgun_PrimaryFire::PerformShot()
     }
     else
     {
-        FVector CamLoc;
-        Character->GetActorEyesViewPoint(CamLoc, AimRotation);
-        MuzzleLocationForEffects = CamLoc + AimDirection * 100.0f;
+        MuzzleLocationForEffects = Aim.ViewLocation + AimDirection * 100.0f;
     }
 
 
@@ -324,24 +325,29 @@ void UGA_ChargedShotgun_PrimaryFire::PerformShot()
     float DamagePerPellet = 10.0f;
     TSubclassOf<UDamageType> DamageType = UDamageType::StaticClass();
 
-    FVector TraceStartLocation;
-    FRotator TempRot;
-    if (PC) PC->GetPlayerViewPoint(TraceStartLocation, TempRot);
-    else Character->GetActorEyesViewPoint(TraceStartLocation, TempRot);
-
-
-    EquippedWeapon->PerformHitscanShot(
-        TraceStartLocation,
-        AimDirection,
-        WeaponData->WeaponStats.PrimaryPelletCount,
-        WeaponData->WeaponStats.PrimarySpreadAngle,
-        WeaponData->WeaponStats.PrimaryHitscanRange,
-        DamagePerPellet,
-        DamageType,
-        Character,
-        Controller,
-        WeaponData->ImpactEffectCueTag
-    );
+    const FVector TraceStartLocation = Aim.ViewLocation;
+
+
+    {
+        // Lets the server's impact cue carry this activation's key, so the predicting client doesn't play it twice
+        FScopedPredictionWindow ScopedPrediction(GetAbilitySystemComponentFromActorInfo(), GetCurrentActivationInfo().GetActivationPredictionKey());
+
+        EquippedWeapon->PerformHitscanShot(
+            TraceStartLocation,
+            AimDirection,
+            WeaponData->WeaponStats.PrimaryPelletCount,
+            WeaponData->WeaponStats.PrimarySpreadAngle,
+            WeaponData->WeaponStats.PrimaryHitscanRange,
+            DamagePerPellet,
+            DamageType,
+            Character,
+            Controller,
+            WeaponData->ImpactEffectCueTag,
+            NextSpreadSeed(),
+            WeaponData->WeaponStats.PrimarySpreadPattern,
+            WeaponData->WeaponStats.bRotateSpreadPattern
+        );
+    }
 
     if (WeaponData->MuzzleFlashCueTag.IsValid() && ActorInfo->AbilitySystemComponent.Get())
     {
@@ -2,11 +2,12 @@
 
 #include "Weapons/GA_ChargedShotgun_SecondaryFire.h"
 #include "Weapons/ChargedShotgun.h"
+#include "WeaponAimSubsystem.h"
 #include "WeaponDataAsset.h"
 #include "StrafeCharacter.h" 
 #include "AbilitySystemComponent.h"
 #include "AbilitySystemBlueprintLibrary.h"
-#include "GameplayTagsManager.h"
+#include "StrafeGameplayTags.h"
 #include "Abilities/Tasks/AbilityTask_WaitInputRelease.h"
 #include "Abilities/Tasks/AbilityTask_PlayMontageAndWait.h"
 #include "Kismet/GameplayStatics.h"
@@ -18,18 +19,19 @@ UGA_ChargedShotgun_SecondaryFire::UGA_ChargedShotgun_SecondaryFire()
 {
     AbilityInputID = 101; // Matches value in StrafeCharacter for secondary fire
     InstancingPolicy = EGameplayAbilityInstancingPolicy::InstancedPerActor;
-    NetExecutionPolicy = EGameplayAbilityNetExecutionPolicy::ServerInitiated;
+    // Predicted like the primary, so both sides share the activation key the spread seed is derived from
+    NetExecutionPolicy = EGameplayAbilityNetExecutionPolicy::LocalPredicted;
 
     bIsCharging = false;
     bOverchargedShotStored = false;
     bInputWasReleasedDuringCharge = false;
 
-    ChargeSecondaryInProgressTag = FGameplayTag::RequestGameplayTag(FName("State.Weapon.ChargedShotgun.Charging.SecondaryFire"));
-    OverchargedStateTag = FGameplayTag::RequestGameplayTag(FName("State.Weapon.ChargedShotgun.Overcharged.SecondaryFire"));
-    WeaponLockoutTag = FGameplayTag::RequestGameplayTag(FName("State.Weapon.ChargedShotgun.Lockout"));
+    ChargeSecondaryInProgressTag = StrafeGameplayTags::State_Weapon_ChargedShotgun_Charging_SecondaryFire;
+    OverchargedStateTag = StrafeGameplayTags::State_Weapon_ChargedShotgun_Overcharged_SecondaryFire;
+    WeaponLockoutTag = StrafeGameplayTags::State_Weapon_ChargedShotgun_Lockout;
 
-    AbilityTags.AddTag(FGameplayTag::RequestGameplayTag(FName("Ability.Weapon.SecondaryFire")));
-    AbilityTags.AddTag(FGameplayTag::RequestGameplayTag(FName("Ability.Weapon.ChargedShotgun.SecondaryFire")));
+    AbilityTags.AddTag(StrafeGameplayTags::Ability_Weapon_SecondaryFire);
+    AbilityTags.AddTag(StrafeGameplayTags::Ability_Weapon_ChargedShotgun_SecondaryFire);
 
     ActivationBlockedTags.AddTag(WeaponLockoutTag);
 }
@@ -69,18 +71,20 @@ bool UGA_ChargedShotgun_SecondaryFire::CanActivateAbility(const FGameplayAbility
         return false;
     }
 
-    if (TempWeaponData->AmmoAttribute.IsValid())
+    float CurrentAmmo = 0.0f;
+    float MaxAmmo = 0.0f;
+    if (TempWeaponData->GetAmmo(ASC, CurrentAmmo, MaxAmmo))
     {
-        if (ASC->GetNumericAttribute(TempWeaponData->AmmoAttribute) <= 0)
+        if (CurrentAmmo <= 0)
         {
-            if (OptionalRelevantTags) OptionalRelevantTags->AddTag(FGameplayTag::RequestGameplayTag(FName("Ability.Feedback.OutOfAmmo")));
+            if (OptionalRelevantTags) OptionalRelevantTags->AddTag(StrafeGameplayTags::Ability_Feedback_OutOfAmmo);
             if (TempWeaponData->EmptySound) UGameplayStatics::PlaySoundAtLocation(GetWorld(), TempWeaponData->EmptySound, Character->GetActorLocation());
             return false;
         }
     }
     else
     {
-        UE_LOG(LogTemp, Warning, TEXT("GA_Shotgun_SecondaryFire::CanActivateAbility: AmmoAttribute is invalid in WeaponData. Ammo check skipped."));
+        UE_LOG(LogTemp, Warning, TEXT("GA_Shotgun_SecondaryFire::CanActivateAbility: WeaponData has no readable ammo. Ammo check skipped."));
     }
 
     if (ASC->HasMatchingGameplayTag(WeaponLockoutTag))
@@ -281,7 +285,9 @@ void UGA_ChargedShotgun_SecondaryFire::AttemptFireOverchargedShot()
         return;
     }
 
-    if (WeaponData->AmmoAttribute.IsValid() && GetAbilitySystemComponentFromActorInfo()->GetNumericAttribute(WeaponData->AmmoAttribute) <= 0)
+    float CurrentAmmo = 0.0f;
+    float MaxAmmo = 0.0f;
+    if (WeaponData->GetAmmo(GetAbilitySystemComponentFromActorInfo(), CurrentAmmo, MaxAmmo) && CurrentAmmo <= 0)
     {
         UE_LOG(LogTemp, Log, TEXT("GA_Shotgun_SecondaryFire::AttemptFireOverchargedShot: Out of ammo just before firing."));
         if (WeaponData->EmptySound) UGameplayStatics::PlaySoundAtLocation(GetWorld(), WeaponData->EmptySound, GetAvatarActorFromActorInfo()->GetActorLocation());
@@ -296,6 +302,7 @@ void UGA_ChargedShotgun_SecondaryFire::AttemptFireOverchargedShot()
         if (SpecHandle.IsValid())
         {
             ApplyGameplayEffectSpecToOwner(GetCurrentAbilitySpecHandle(), GetCurrentActorInfo(), GetCurrentActivationInfo(), SpecHandle);
+            PredictAmmoSpend(AmmoCostGEClass.GetDefaultObject(), GetCurrentAbilitySpecHandle(), GetCurrentActorInfo());
         }
     }
     else
@@ -313,8 +320,6 @@ void UGA_ChargedShotgun_SecondaryFire::AttemptFireOverchargedShot()
         return;
     }
 
-    APlayerController* PC = Cast<APlayerController>(Controller);
-
     UAnimMontage* FireMontage1P = WeaponData->FireMontage_1P;
     UAnimMontage* FireMontage3P = WeaponData->FireMontage_3P;
     UAnimMontage* MontageToPlay = Character->IsLocallyControlled() && IsValid(FireMontage1P) ? FireMontage1P : FireMontage3P;
@@ -332,9 +337,12 @@ void UGA_ChargedShotgun_SecondaryFire::AttemptFireOverchargedShot()
         }
     }
 
+    // View only; pellets don't need the shared aim trace
+    UWeaponAimSubsystem* AimSubsystem = GetWorld()->GetSubsystem<UWeaponAimSubsystem>();
+    const FWeaponAimResult Aim = AimSubsystem ? AimSubsystem->GetAim(Controller, false) : FWeaponAimResult();
+
     FVector MuzzleLocationForEffects;
-    FRotator AimRotation = Controller->GetControlRotation(); // Aim from controller
-    FVector AimDirection = AimRotation.Vector();
+    const FVector AimDirection = Aim.AimDirection;
 
 
     if (EquippedWeapon->GetWeaponMeshComponent() && WeaponData->MuzzleFlashSocketName != NAME_None)
@@ -343,32 +351,35 @@ void UGA_ChargedShotgun_SecondaryFire::AttemptFireOverchargedShot()
     }
     else
     {
-        FVector CamLoc;
-        Character->GetActorEyesViewPoint(CamLoc, AimRotation);
-        MuzzleLocationForEffects = CamLoc + AimDirection * 100.0f;
+        MuzzleLocationForEffects = Aim.ViewLocation + AimDirection * 100.0f;
     }
 
     float DamagePerPellet = 15.0f; // This should ideally come from WeaponData or a GE
     TSubclassOf<UDamageType> DamageType = UDamageType::StaticClass();
 
-    FVector TraceStartLocation;
-    FRotator TempRot;
-    if (PC) PC->GetPlayerViewPoint(TraceStartLocation, TempRot);
-    else Character->GetActorEyesViewPoint(TraceStartLocation, TempRot);
-
-
-    EquippedWeapon->PerformHitscanShot(
-        TraceStartLocation, // Pellet traces start from camera/eye
-        AimDirection,      // Aim direction from controller
-        WeaponData->WeaponStats.SecondaryPelletCount,
-        WeaponData->WeaponStats.SecondarySpreadAngle,
-        WeaponData->WeaponStats.SecondaryHitscanRange,
-        DamagePerPellet,
-        DamageType,
-        Character,
-        Controller,
-        WeaponData->ImpactEffectCueTag
-    );
+    const FVector TraceStartLocation = Aim.ViewLocation;
+
+
+    {
+        // Lets the server's impact cue carry this activation's key, so the predicting client doesn't play it twice
+        FScopedPredictionWindow ScopedPrediction(GetAbilitySystemComponentFromActorInfo(), GetCurrentActivationInfo().GetActivationPredictionKey());
+
+        EquippedWeapon->PerformHitscanShot(
+            TraceStartLocation, // Pellet traces start from camera/eye
+            AimDirection,      // Aim direction from controller
+            WeaponData->WeaponStats.SecondaryPelletCount,
+            WeaponData->WeaponStats.SecondarySpreadAngle,
+            WeaponData->WeaponStats.SecondaryHitscanRange,
+            DamagePerPellet,
+            DamageType,
+            Character,
+            Controller,
+            WeaponData->ImpactEffectCueTag,
+            NextSpreadSeed(),
+            WeaponData->WeaponStats.SecondarySpreadPattern,
+            WeaponData->WeaponStats.bRotateSpreadPattern
+        );
+    }
 
     if (WeaponData->MuzzleFlashCueTag.IsValid() && GetAbilitySystemComponentFromActorInfo())
     {
@@ -0,0 +1,44 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Weapons/PelletSpread.h"
+#include "Math/RandomStream.h"
+
+int32 FPelletSpread::MakeSeed(int16 PredictionKey, int32 ShotIndex)
+{
+    return static_cast<int32>(HashCombine(GetTypeHash(PredictionKey), GetTypeHash(ShotIndex)));
+}
+
+void FPelletSpread::GenerateDirections(int32 Seed, const FVector& AimDirection, float SpreadAngle,
+    TConstArrayView<FVector2D> Pattern, bool bRotatePattern, TArrayView<FVector> OutDirections)
+{
+    const FRandomStream Stream(Seed);
+    const FVector Aim = AimDirection.GetSafeNormal();
+    const float HalfAngleRad = FMath::DegreesToRadians(SpreadAngle * 0.5f);
+
+    // Pattern points are projected onto the plane one unit ahead of the muzzle
+    FVector Right, Up;
+    Aim.FindBestAxisVectors(Right, Up);
+    const float PatternScale = FMath::Tan(FMath::Min(HalfAngleRad, UE_HALF_PI - KINDA_SMALL_NUMBER));
+
+    float RollSin = 0.0f;
+    float RollCos = 1.0f;
+    if (bRotatePattern && Pattern.Num() > 0)
+    {
+        FMath::SinCos(&RollSin, &RollCos, Stream.FRandRange(0.0f, UE_TWO_PI));
+    }
+
+    for (int32 i = 0; i < OutDirections.Num(); ++i)
+    {
+        if (Pattern.IsValidIndex(i))
+        {
+            const FVector2D Point = Pattern[i].SizeSquared() > 1.0 ? Pattern[i].GetSafeNormal() : Pattern[i];
+            const double X = Point.X * RollCos - Point.Y * RollSin;
+            const double Y = Point.X * RollSin + Point.Y * RollCos;
+            OutDirections[i] = (Aim + (Right * X + Up * Y) * PatternScale).GetSafeNormal();
+        }
+        else
+        {
+            OutDirections[i] = Stream.VRandCone(Aim, HalfAngleRad);
+        }
+    }
+}
@@ -0,0 +1,147 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "GameplayTagContainer.h"
+#include "GameplayPrediction.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "AmmoComponent.generated.h"
+
+class UAmmoComponent;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnAmmoChanged, FGameplayTag, AmmoType, int32, Current, int32, Max);
+
+/** Ammo of one type carried by a character. */
+USTRUCT()
+struct FAmmoEntry : public FFastArraySerializerItem
+{
+    GENERATED_BODY()
+
+    // e.g. Ammo.Rocket; matches UWeaponDataAsset::AmmoTypeTag
+    UPROPERTY()
+    FGameplayTag AmmoType;
+
+    UPROPERTY()
+    int32 Current = 0;
+
+    UPROPERTY()
+    int32 Max = 0;
+
+    void PostReplicatedAdd(const struct FAmmoList& InArraySerializer);
+    void PostReplicatedChange(const struct FAmmoList& InArraySerializer);
+    void PreReplicatedRemove(const struct FAmmoList& InArraySerializer);
+};
+
+USTRUCT()
+struct FAmmoList : public FFastArraySerializer
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TArray<FAmmoEntry> Entries;
+
+    // Set by the owning component; receives the client-side callbacks
+    UAmmoComponent* Owner = nullptr;
+
+    bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+    {
+        return FFastArraySerializer::FastArrayDeltaSerialize<FAmmoEntry, FAmmoList>(Entries, DeltaParms, *this);
+    }
+};
+
+template<>
+struct TStructOpsTypeTraits<FAmmoList> : public TStructOpsTypeTraitsBase2<FAmmoList>
+{
+    enum
+    {
+        WithNetDeltaSerializer = true,
+    };
+};
+
+/**
+ * Tag-keyed ammo store. Holds one entry per ammo type the character carries, so adding a weapon
+ * doesn't touch UStrafeAttributeSet and nothing replicates for weapons that aren't being carried.
+ * The list is a fast array sent to the owning client only: a shot resends one entry's counter.
+ * Lookups go through a tag-to-index map that's rebuilt whenever entries are added or removed.
+ * Weapons opt in through UWeaponDataAsset::AmmoTypeTag; fire abilities spend it via UAmmoCostExecution.
+ * The spend itself is server only, so the predicting client records it with PredictSpend: GetAmmo
+ * subtracts it until the server has answered the shot's prediction key.
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class STRAFEWEAPONSYSTEM_API UAmmoComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UAmmoComponent();
+
+    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+    /** The actor's ammo component; AStrafeCharacter hands its own out without a component search. */
+    static UAmmoComponent* FindAmmoComponent(const AActor* Actor);
+
+    /** Starts tracking an ammo type, or overwrites it if it's already tracked. Server only. */
+    UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Ammo")
+    void SetAmmo(FGameplayTag AmmoType, int32 Current, int32 Max);
+
+    /** Adds Amount (negative to spend), clamped to [0, Max]. Returns the change actually applied. Server only. */
+    UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Ammo")
+    int32 AddAmmo(FGameplayTag AmmoType, int32 Amount);
+
+    /** Stops tracking an ammo type. Server only. */
+    UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Ammo")
+    void RemoveAmmoType(FGameplayTag AmmoType);
+
+    /**
+     * Owning client: spends Amount locally ahead of the server. The spend is dropped once PredictionKey
+     * is caught up (the replicated count includes it by then) or rejected. Must be a local client key.
+     */
+    void PredictSpend(FGameplayTag AmmoType, int32 Amount, FPredictionKey PredictionKey);
+
+    /** Current count, less any spends predicted locally that the server hasn't answered yet. */
+    UFUNCTION(BlueprintPure, Category = "Ammo")
+    int32 GetAmmo(FGameplayTag AmmoType) const;
+
+    UFUNCTION(BlueprintPure, Category = "Ammo")
+    int32 GetMaxAmmo(FGameplayTag AmmoType) const;
+
+    UFUNCTION(BlueprintPure, Category = "Ammo")
+    bool HasAmmoType(FGameplayTag AmmoType) const { return FindEntry(AmmoType) != nullptr; }
+
+    const FAmmoEntry* FindEntry(const FGameplayTag& AmmoType) const;
+
+    UPROPERTY(BlueprintAssignable, Category = "Ammo")
+    FOnAmmoChanged OnAmmoChanged;
+
+protected:
+    friend struct FAmmoEntry;
+
+    // Client-side callbacks from the fast array
+    void OnEntryReplicated(const FAmmoEntry& Entry, bool bAdded);
+    void OnEntryRemoved(const FAmmoEntry& Entry);
+
+    void RebuildIndex() const;
+
+    int32 GetPredictedSpend(const FGameplayTag& AmmoType) const;
+    void OnSpendPredictionResolved(int16 PredictionKeyId);
+
+    UPROPERTY(Replicated)
+    FAmmoList AmmoList;
+
+private:
+    // AmmoType -> index into AmmoList.Entries
+    mutable TMap<FGameplayTag, int32> EntryIndexByType;
+    mutable bool bIndexStale = true;
+
+    struct FPredictedSpend
+    {
+        FGameplayTag AmmoType;
+        int32 Amount = 0;
+        int16 PredictionKeyId = 0;
+    };
+
+    // Owning client only; a handful at most, one per shot in flight
+    TArray<FPredictedSpend> PredictedSpends;
+};
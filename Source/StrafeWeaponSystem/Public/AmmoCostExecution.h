@@ -0,0 +1,29 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEffectExecutionCalculation.h"
+#include "AmmoCostExecution.generated.h"
+
+class UWeaponDataAsset;
+
+/**
+ * Spends tag-keyed ammo from the target's UAmmoComponent, so ammo cost effects keep working for
+ * weapons that use UWeaponDataAsset::AmmoTypeTag instead of an ammo attribute. Add it as the
+ * execution of an instant cost effect. The ammo type is the effect's Ammo.* asset tag when it has
+ * one, otherwise the instigator's equipped weapon's AmmoTypeTag. The amount is the
+ * SetByCaller.AmmoCost magnitude, or 1 when the caller doesn't set it. Executions run on the server
+ * only; UGA_WeaponActivate::ApplyCost predicts the default spend on the owning client.
+ */
+UCLASS()
+class STRAFEWEAPONSYSTEM_API UAmmoCostExecution : public UGameplayEffectExecutionCalculation
+{
+    GENERATED_BODY()
+
+public:
+    /** The Ammo.* tag among AssetTags, otherwise WeaponData's AmmoTypeTag. Also used to predict the spend. */
+    static FGameplayTag ResolveAmmoType(const FGameplayTagContainer& AssetTags, const UWeaponDataAsset* WeaponData);
+
+    virtual void Execute_Implementation(const FGameplayEffectCustomExecutionParameters& ExecutionParams, FGameplayEffectCustomExecutionOutput& OutExecutionOutput) const override;
+};
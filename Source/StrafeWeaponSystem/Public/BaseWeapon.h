@@ -6,11 +6,83 @@
 #include "GameFramework/Actor.h"
 #include "WeaponDataAsset.h"
 #include "GameplayTagContainer.h"
+#include "GameplayPrediction.h"
 #include "BaseWeapon.generated.h"
 
 class AProjectileBase;
 class USkeletalMeshComponent;
 
+/**
+ * One batched remote-detonation command, sent through the weapon's channel instead of
+ * one reliable RPC per projectile.
+ */
+USTRUCT()
+struct FProjectileDetonationRequest
+{
+    GENERATED_BODY()
+
+    // Projectiles the client selected; replicated as net GUIDs. Unresolved entries arrive as null.
+    UPROPERTY()
+    TArray<TObjectPtr<AProjectileBase>> Projectiles;
+
+    // Fallback / top-up: detonate Count projectiles of this class from the server's registry
+    UPROPERTY()
+    TSubclassOf<AProjectileBase> ProjectileClass;
+
+    // -1 = all of ProjectileClass
+    UPROPERTY()
+    int16 Count = 0;
+
+    UPROPERTY()
+    bool bOldestFirst = true;
+
+    // Prediction key the request was made under; with ProjectileClass, used to drop repeats
+    UPROPERTY()
+    FPredictionKey PredictionKey;
+};
+
+/**
+ * Active projectiles of one concrete class, in spawn order.
+ * Each projectile remembers its slot, so removal is O(1); out-of-order removal leaves a hole that is
+ * skipped on iteration and squeezed out once holes outnumber live entries.
+ */
+USTRUCT()
+struct FActiveProjectileRing
+{
+    GENERATED_BODY()
+
+    // Power-of-two sized; null entries are holes
+    UPROPERTY()
+    TArray<TObjectPtr<AProjectileBase>> Slots;
+
+    // Slot of the oldest entry
+    int32 Head = 0;
+
+    // Occupied slots from Head, holes included
+    int32 Span = 0;
+
+    // Live entries
+    int32 Num = 0;
+
+    void Add(AProjectileBase* Projectile);
+    bool Remove(AProjectileBase* Projectile);
+
+    // Offset 0 is the oldest slot, Span - 1 the newest. May return null for a hole.
+    AProjectileBase* GetAtOffset(int32 Offset) const { return Slots[(Head + Offset) & (Slots.Num() - 1)]; }
+
+private:
+    void Repack(int32 NewCapacity);
+};
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnWeaponOwnerChanged, ABaseWeapon* /*Weapon*/, AActor* /*OldOwner*/);
+
+/** A client's stand-in for a projectile the server has not replicated yet. */
+struct FPredictedProjectile
+{
+    TWeakObjectPtr<AProjectileBase> Projectile;
+    double SpawnTime = 0.0;
+};
+
 UCLASS(Abstract)
 class STRAFEWEAPONSYSTEM_API ABaseWeapon : public AActor
 {
@@ -32,13 +104,23 @@ protected:
     UPROPERTY(Replicated, BlueprintReadOnly, Category = "Weapon")
     bool  bIsEquipped = false;
 
-    UPROPERTY(BlueprintReadOnly, Category = "Weapon")
-    TArray<AProjectileBase*> ActiveProjectiles;
+    // Active projectiles keyed by their concrete class. Mirrored on clients through OnRep_OwningWeapon.
+    UPROPERTY()
+    TMap<TSubclassOf<AProjectileBase>, FActiveProjectileRing> ProjectileRegistry;
+
+    int32 NumActiveProjectiles = 0;
+
+    // Spawn order across classes, for queries that span several rings
+    uint32 NextProjectileSequence = 0;
 
 
 public:
     virtual void BeginPlay() override;
     virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+    virtual void SetOwner(AActor* NewOwner) override;
+
+    // Any weapon in any world; the replication graph re-parents the weapon onto its new owner (under Iris, SetOwner does)
+    static FOnWeaponOwnerChanged OnWeaponOwnerChanged;
 
     UFUNCTION(BlueprintPure, Category = "Weapon")
     UWeaponDataAsset* GetWeaponData() const { return WeaponData; }
@@ -55,11 +137,77 @@ public:
     void RegisterProjectile(AProjectileBase* Projectile);
     void UnregisterProjectile(AProjectileBase* Projectile);
 
+    // All active projectiles, oldest first
     UFUNCTION(BlueprintPure, Category = "Weapon")
-    const TArray<AProjectileBase*>& GetActiveProjectiles() const { return ActiveProjectiles; }
+    TArray<AProjectileBase*> GetActiveProjectiles() const;
+
+    UFUNCTION(BlueprintPure, Category = "Weapon")
+    int32 GetNumActiveProjectiles() const { return NumActiveProjectiles; }
+
+    // False when MaxActiveProjectiles is reached and the limit policy is BlockFire
+    UFUNCTION(BlueprintPure, Category = "Weapon")
+    bool CanFireProjectile() const;
+
+    // Active projectiles of the class in spawn order (oldest first unless bOldestFirst is false); Count -1 = all
+    void GetProjectilesToDetonate(TSubclassOf<AProjectileBase> ProjectileClass, int32 Count, bool bOldestFirst, TArray<AProjectileBase*>& OutProjectiles) const;
+
+    // Validates and resolves a detonation request in one step. Authority only. Returns the number detonated.
+    int32 DetonateProjectiles(const FProjectileDetonationRequest& Request);
+
+    UFUNCTION(Server, Reliable)
+    void ServerDetonateProjectiles(const FProjectileDetonationRequest& Request);
+
+    // Collects client-side Detonate() calls made this frame into one ServerDetonateProjectiles per projectile class
+    void QueueClientDetonation(AProjectileBase* Projectile);
+
+    /**
+     * Shooter's client: spawns a local projectile right away for a fire activation. It is replaced when the
+     * server's projectile for the same key arrives, and destroyed if the key is rejected or nothing arrives in time.
+     */
+    AProjectileBase* SpawnPredictedProjectile(TSubclassOf<AProjectileBase> ProjectileClass, const FTransform& SpawnTransform, FPredictionKey PredictionKey);
+
+    /** Removes and returns the predicted projectile for the key, or null. The caller takes over (or destroys) it. */
+    AProjectileBase* TakePredictedProjectile(int16 PredictionKeyId);
+
+    float GetPredictedProjectileBlendTime() const { return PredictedProjectileBlendTime; }
+    float GetPredictedProjectileTimeout() const { return PredictedProjectileTimeout; }
+
 protected:
-    UFUNCTION() void OnProjectileDestroyed(AActor* DestroyedActor);
+    void FlushClientDetonations();
+
+    void OnPredictedProjectileRejected(int16 PredictionKeyId);
+    void ExpirePredictedProjectiles();
+
+    // Predicted projectiles with no authoritative counterpart after this long are removed
+    UPROPERTY(EditDefaultsOnly, Category = "Weapon|Prediction")
+    float PredictedProjectileTimeout = 1.0f;
+
+    // How long the authoritative projectile's mesh takes to slide from the predicted position onto its own,
+    // once the projectile has been fast-forwarded to the predicted copy's flight time
+    UPROPERTY(EditDefaultsOnly, Category = "Weapon|Prediction")
+    float PredictedProjectileBlendTime = 0.15f;
+
+    TMap<int16, FPredictedProjectile> PredictedProjectiles;
+    FTimerHandle PredictedProjectileTimer;
+
+    // Hard cap on projectiles a single request may name, to bound server work per RPC
+    static constexpr int32 MaxDetonationsPerRequest = 32;
+
+    // One per projectile class and prediction key, so a mixed frame doesn't ask for the wrong class
+    TArray<FProjectileDetonationRequest, TInlineAllocator<2>> PendingClientDetonations;
+
+    // Recently handled (prediction key, class) pairs, so a repeated request can't detonate another batch.
+    // A window rather than the last key alone, since requests from two activations can interleave.
+    static constexpr int32 HandledDetonationWindow = 16;
+    TArray<TPair<int16, const UClass*>, TInlineAllocator<HandledDetonationWindow>> HandledDetonations;
+    int32 NextHandledDetonation = 0;
 
 private:
     friend class AProjectileBase;
+
+    // Registry walk in spawn order over every ring whose class is a ProjectileClass (all rings when null)
+    void CollectInSpawnOrder(TSubclassOf<AProjectileBase> ProjectileClass, int32 Count, bool bOldestFirst, TArray<AProjectileBase*>& OutProjectiles) const;
+
+    // Applies MaxActiveProjectiles before a new projectile is registered. Authority only.
+    void EnforceProjectileLimit();
 };
\ No newline at end of file
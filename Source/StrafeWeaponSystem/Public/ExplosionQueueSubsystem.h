@@ -0,0 +1,46 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ExplosionResolver.h"
+#include "ExplosionQueueSubsystem.generated.h"
+
+/**
+ * Collects every explosion issued during a frame and resolves them together at the end of it.
+ * Explosions whose spheres overlap share one broad-phase overlap; each one still skips its own causer
+ * and owner, and an actor reached by several clusters is merged. Damage is summed per actor and instigator, and
+ * launch impulses are summed and capped so a character gets exactly one LaunchCharacter, however
+ * many stickies went off around it.
+ */
+UCLASS(Config = Game)
+class STRAFEWEAPONSYSTEM_API UExplosionQueueSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    /** Defers the explosion until this frame's batch is resolved. Server only. */
+    void QueueExplosion(const FExplosionInstance& Explosion);
+
+    /** Resolves everything queued so far. Called from Tick; exposed for code that needs results immediately. */
+    void FlushExplosions();
+
+protected:
+    // Upper bound on the summed launch velocity one character can receive from a single batch
+    UPROPERTY(Config)
+    float MaxCombinedLaunchSpeed = 3000.0f;
+
+    // Upper bound on the summed impulse one physics body can receive from a single batch
+    UPROPERTY(Config)
+    float MaxCombinedPhysicsImpulse = 5000.0f;
+
+private:
+    void ResolveBatch(UWorld* World);
+
+    TArray<FExplosionInstance> PendingExplosions;
+};
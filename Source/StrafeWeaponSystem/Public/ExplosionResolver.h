@@ -0,0 +1,76 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProjectileBase.h" // FExplosionParams
+
+class UDamageType;
+class UPrimitiveComponent;
+
+/** One explosion to resolve. Built by the detonating projectile (or anything else that explodes). */
+struct STRAFEWEAPONSYSTEM_API FExplosionInstance
+{
+    FVector Location = FVector::ZeroVector;
+    FExplosionParams Params;
+
+    TWeakObjectPtr<AActor> DamageCauser;
+    TWeakObjectPtr<AController> InstigatorController;
+
+    // Pawn that counts as "self" for SelfDamageMultiplier / SelfImpulseMultiplier
+    TWeakObjectPtr<AActor> SelfActor;
+
+    // Skipped entirely when Params.bIgnoreOwner is set
+    TWeakObjectPtr<AActor> IgnoredActor;
+
+    TSubclassOf<UDamageType> DamageTypeClass;
+
+    /** DamageCauser, or SelfActor once the causer is gone (a detonated projectile may be destroyed before a batch resolves). */
+    AActor* GetDamageCauser() const { return DamageCauser.IsValid() ? DamageCauser.Get() : SelfActor.Get(); }
+};
+
+/** What one explosion does to one actor, computed once per actor. */
+struct STRAFEWEAPONSYSTEM_API FExplosionActorEffect
+{
+    TWeakObjectPtr<AActor> Actor;
+
+    // Damage already scaled by falloff and self multiplier; 0 when line of sight is blocked
+    float Damage = 0.0f;
+    FHitResult DamageHit;
+
+    // Velocity for ACharacter::LaunchCharacter, zero for non-characters
+    FVector LaunchVelocity = FVector::ZeroVector;
+
+    // Impulse for simulating root primitives, zero otherwise
+    TWeakObjectPtr<UPrimitiveComponent> PhysicsComponent;
+    FVector PhysicsImpulse = FVector::ZeroVector;
+    FVector PhysicsImpulseLocation = FVector::ZeroVector;
+};
+
+/**
+ * Shared explosion resolution for all projectile types.
+ * One overlap query gathers unique actors; falloff, damage and impulse are then computed and applied
+ * once per actor, so multi-component pawns are launched exactly once.
+ */
+class STRAFEWEAPONSYSTEM_API FExplosionResolver
+{
+public:
+    /** Gather, evaluate and apply in one go. */
+    static void ResolveExplosion(UWorld* World, const FExplosionInstance& Explosion);
+
+    /**
+     * Single overlap against all dynamic object types, deduplicated per actor.
+     * OutTargets pairs each actor with the component used for the line-of-sight test (root preferred).
+     */
+    static void GatherTargets(UWorld* World, const FVector& Center, const FCollisionShape& Shape,
+        const FCollisionQueryParams& QueryParams, TArray<TPair<AActor*, UPrimitiveComponent*>>& OutTargets);
+
+    /** Evaluates one explosion against one gathered target. Returns false when the actor is unaffected. */
+    static bool EvaluateTarget(UWorld* World, const FExplosionInstance& Explosion, AActor* Actor,
+        UPrimitiveComponent* Component, FExplosionActorEffect& OutEffect);
+
+    /** Applies damage (as a radial damage event) and launch/impulse for one actor. */
+    static void ApplyEffect(const FExplosionActorEffect& Effect, const FExplosionInstance& Explosion);
+
+    static FCollisionQueryParams MakeQueryParams(const FExplosionInstance& Explosion);
+};
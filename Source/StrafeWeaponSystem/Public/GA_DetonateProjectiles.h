@@ -4,6 +4,13 @@
 #include "GA_WeaponActivate.h"
 #include "GA_DetonateProjectiles.generated.h"
 
+struct FProjectileDetonationRequest;
+
+/**
+ * Detonates the weapon's active projectiles of one class. A remote client sends its selection as the
+ * activation's target data, so the server only detonates inside an activation it accepted (tags,
+ * cooldown, cost) and resolves the whole selection in one DetonateProjectiles call.
+ */
 UCLASS(Abstract)
 class STRAFEWEAPONSYSTEM_API UGA_DetonateProjectiles : public UGA_WeaponActivate
 {
@@ -14,6 +21,7 @@ public:
 
     virtual void ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData) override;
     virtual bool CanActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayTagContainer* SourceTags = nullptr, const FGameplayTagContainer* TargetTags = nullptr, OUT FGameplayTagContainer* OptionalRelevantTags = nullptr) const override;
+    virtual void EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled) override;
 
 protected:
     // How many projectiles to detonate per activation (-1 = all)
@@ -29,4 +37,10 @@ protected:
 
     UFUNCTION(BlueprintImplementableEvent, Category = "Ability|Detonation")
     void K2_OnProjectilesDetonated(int32 NumDetonated);
+
+    // Class, count, order and key of the current activation; the explicit list is left to the caller
+    FProjectileDetonationRequest MakeDetonationRequest() const;
+
+    // Server, remote activation: the client's selection arrived
+    void OnDetonationTargetData(const FGameplayAbilityTargetDataHandle& Data, FGameplayTag ApplicationTag);
 };
\ No newline at end of file
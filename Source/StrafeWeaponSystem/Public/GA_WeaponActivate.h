@@ -15,9 +15,22 @@ class STRAFEWEAPONSYSTEM_API UGA_WeaponActivate : public UGameplayAbility
 public:
 	UGA_WeaponActivate();
 
+	/** Blocks abilities of carried but holstered weapons (see UWeaponDataAsset::EquippedTag). */
+	virtual bool CanActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayTagContainer* SourceTags = nullptr, const FGameplayTagContainer* TargetTags = nullptr, OUT FGameplayTagContainer* OptionalRelevantTags = nullptr) const override;
+
+	/** With bRequiresAmmo, also requires a round of the weapon's ammo, counting spends the owning client has predicted. */
+	virtual bool CheckCost(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, OUT FGameplayTagContainer* OptionalRelevantTags = nullptr) const override;
+
+	/** On the predicting client, also spends the round UAmmoCostExecution will take on the server. */
+	virtual void ApplyCost(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo) const override;
+
 	UPROPERTY(EditDefaultsOnly, Category = "Ability") // <<<<<<< ADDED AbilityInputID
 	int32 AbilityInputID = -1; // Default to an invalid/unused ID
 
+	// CheckCost fails while the weapon is out of ammo. Off for abilities that don't fire, e.g. detonating.
+	UPROPERTY(EditDefaultsOnly, Category = "Ability")
+	bool bRequiresAmmo = true;
+
 	/** Retrieves the weapon from the owning character */
 	UFUNCTION(BlueprintCallable, Category = "Ability|Weapon")
 	ABaseWeapon* GetEquippedWeaponFromActorInfo() const;
@@ -25,4 +38,22 @@ public:
 	/** Retrieves the StrafeCharacter from the owning actor info */
 	UFUNCTION(BlueprintCallable, Category = "Ability|Weapon")
 	AStrafeCharacter* GetStrafeCharacterFromActorInfo() const;
+
+	/**
+	 * Spread seed for the next shot of the current activation. Derived from the activation's prediction key
+	 * and the shot's index within it, so the predicting client and the server get the same value.
+	 */
+	int32 NextSpreadSeed();
+
+protected:
+	/**
+	 * Owning client: if CostEffect runs UAmmoCostExecution, spends its default round from the UAmmoComponent
+	 * under the current prediction key so CheckCost sees it before the server's count replicates.
+	 * ApplyCost calls this for the cost effect; abilities applying their own ammo cost effect call it too.
+	 */
+	void PredictAmmoSpend(const UGameplayEffect* CostEffect, const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo) const;
+
+private:
+	int16 SpreadSeedPredictionKey = 0;
+	int32 SpreadShotIndex = 0;
 };
\ No newline at end of file
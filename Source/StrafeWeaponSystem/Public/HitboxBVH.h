@@ -0,0 +1,87 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+
+class UPrimitiveComponent;
+class UPhysicalMaterial;
+
+/** One character hitbox: a capsule around the segment Start-End. */
+struct FHitboxCapsule
+{
+    FVector Start = FVector::ZeroVector;
+    FVector End = FVector::ZeroVector;
+    float Radius = 0.0f;
+
+    // Only valid for the frame the capsules were gathered in
+    AActor* Actor = nullptr;
+    UPrimitiveComponent* Component = nullptr;
+    uint32 ActorId = 0; // AActor::GetUniqueID, matched against FCollisionQueryParams' ignored actors
+    FName BoneName;     // Physics-asset body the capsule stands for; none for a movement capsule
+    UPhysicalMaterial* PhysMaterial = nullptr;
+
+    // One bit per ECollisionChannel the body blocks; a ray on any other channel passes through it
+    uint32 BlockedChannels = 0;
+
+    bool BlocksChannel(ECollisionChannel Channel) const { return (BlockedChannels & (1u << Channel)) != 0; }
+};
+
+struct FHitboxRayHit
+{
+    int32 CapsuleIndex = INDEX_NONE;
+    float Distance = 0.0f;
+    FVector Location = FVector::ZeroVector;
+    FVector Normal = FVector::ZeroVector;
+};
+
+/**
+ * Small 4-wide bounding volume hierarchy over character hitboxes, for weapon ray tests that only care
+ * about pawns. Each node keeps its four child boxes as structure-of-arrays floats, so one SIMD slab
+ * test covers all of them. Build once when the set of capsules changes; Refit every frame (or for a
+ * rewound set of the same capsules) just recomputes the boxes bottom-up.
+ */
+class STRAFEWEAPONSYSTEM_API FHitboxBVH
+{
+public:
+    /** Rebuilds the tree over the capsules. */
+    void Build(TConstArrayView<FHitboxCapsule> InCapsules);
+
+    /** Updates the boxes for moved capsules. Must be the same capsules, in the same order, as the last Build. */
+    void Refit(TConstArrayView<FHitboxCapsule> InCapsules);
+
+    /** Builds when the capsule count changed since the last Build, refits otherwise. */
+    void Update(TConstArrayView<FHitboxCapsule> InCapsules);
+
+    /** Closest capsule hit along Start-End that blocks Channel, skipping capsules whose ActorId is in IgnoredActorIds. */
+    bool Raycast(const FVector& Start, const FVector& End, ECollisionChannel Channel, TConstArrayView<uint32> IgnoredActorIds, FHitboxRayHit& OutHit) const;
+
+    int32 GetNumCapsules() const { return Capsules.Num(); }
+    const FHitboxCapsule& GetCapsule(int32 Index) const { return Capsules[Index]; }
+
+private:
+    static constexpr int32 EmptySlot = MAX_int32;
+
+    struct alignas(16) FNode
+    {
+        float MinX[4];
+        float MinY[4];
+        float MinZ[4];
+        float MaxX[4];
+        float MaxY[4];
+        float MaxZ[4];
+
+        // >= 0: child node index, < 0: capsule ~Index, EmptySlot: unused
+        int32 Children[4];
+    };
+
+    int32 BuildNode(TArrayView<int32> Indices);
+    void SetSlotBounds(FNode& Node, int32 Slot, const FBox& Bounds) const;
+    FBox GetNodeBounds(const FNode& Node) const;
+    static FBox GetCapsuleBounds(const FHitboxCapsule& Capsule);
+    static bool IntersectCapsule(const FVector& Origin, const FVector& Direction, const FHitboxCapsule& Capsule, float& OutDistance);
+
+    TArray<FNode> Nodes;
+    TArray<FHitboxCapsule> Capsules;
+};
@@ -0,0 +1,129 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CollisionQueryParams.h"
+#include "WorldCollision.h"
+#include "LagCompensationSubsystem.h" // FLagCompensationQuery
+#include "HitboxBVH.h"
+#include "HitscanTraceQueueSubsystem.generated.h"
+
+class AController;
+
+/** Outcome of one queued line trace. */
+struct FHitscanTraceResult
+{
+    FHitResult Hit;
+    bool bBlockingHit = false;
+};
+
+DECLARE_DELEGATE_OneParam(FOnHitscanTracesComplete, TConstArrayView<FHitscanTraceResult> /*Results, in segment order*/);
+
+/** The traces of one shot. Resolved together, and under one lag-compensation rewind on the server. */
+struct STRAFEWEAPONSYSTEM_API FHitscanTraceBatch
+{
+    TArray<TPair<FVector, FVector>, TInlineAllocator<16>> Segments; // Start, end
+
+    ECollisionChannel Channel = ECC_Visibility;
+    FCollisionQueryParams QueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(QueuedHitscanTrace), false);
+
+    // When set (server only), other characters are rewound to this shooter's view while the batch traces
+    TWeakObjectPtr<AController> LagCompensatedShooter;
+    TOptional<FLagCompensationQuery> LagCompensationQuery;
+
+    FOnHitscanTracesComplete OnComplete;
+};
+
+/**
+ * Collects every hitscan trace requested during a frame and starts them together once all actors have
+ * ticked, instead of synchronously inside each ability activation. The world traces go to the engine's
+ * async trace tasks, which answer during the next frame; callbacks fire from the next Tick, on the game
+ * thread and in queue order.
+ * Batches are grouped by lag-compensated shooter. Without hitboxes a shooter's group has to trace the
+ * rewound world, so it is rewound once, traced as one ParallelFor of read-only scene queries and
+ * restored on the spot; its callbacks still wait for the rest of the flush.
+ *
+ * With bResolvePawnHitsWithHitboxes (server only, where characters are recorded for lag compensation),
+ * pawns whose bodies block the batch's channel are taken out of the physics queries: each trace only
+ * asks the scene for world occlusion and tests the recorded character hitboxes (the mesh's physics-asset bodies, see
+ * ULagCompensationSubsystem::GatherHitboxes) through an FHitboxBVH, refit to the present once per
+ * flush and to each shooter's view time instead of rewinding the actors.
+ */
+UCLASS(Config = Game)
+class STRAFEWEAPONSYSTEM_API UHitscanTraceQueueSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    /** Starts the batch at the end of the frame. OnComplete runs from the next frame's Tick, unless its object is gone. */
+    void QueueTraces(FHitscanTraceBatch&& Batch);
+
+    /** Resolves everything queued so far on the game thread and runs the callbacks, for code that can't wait a frame. */
+    void FlushTraces();
+
+    UFUNCTION(BlueprintPure, Category = "Hitscan")
+    int32 GetNumQueuedBatches() const { return PendingBatches.Num(); }
+
+    /** Times NumRays random rays at the recorded characters through both paths and logs rays per second. */
+    void RunHitboxBenchmark(int32 NumRays, ECollisionChannel Channel = ECC_Visibility);
+
+protected:
+    // Groups with fewer traces than this run on the game thread; task dispatch isn't free
+    UPROPERTY(Config)
+    int32 MinTracesForParallel = 16;
+
+    // Resolve pawn hits against HitboxBVH and keep characters out of the physics queries.
+    // Pawn hits carry the mesh, bone and physical material of the body they hit, as the scene path reports them.
+    UPROPERTY(Config)
+    bool bResolvePawnHitsWithHitboxes = true;
+
+private:
+    // The batches started together and their results, kept until every async world trace has come back
+    struct FTraceFlush
+    {
+        TArray<FHitscanTraceBatch> Batches;
+        TArray<int32> ResultOffsets;
+        TArray<FHitscanTraceResult> Results;
+        TArray<FCollisionQueryParams> WorldQueryParams; // Per batch with hitboxes: its params plus the hitbox actors
+        uint32 Serial = 0;
+        uint64 StartFrame = 0;
+        int32 NumOutstanding = 0; // Async world traces not answered yet
+    };
+
+    // Takes PendingBatches into Flush and traces them. With bAsync the world traces are handed to the
+    // engine; traces against a rewound world always run before this returns.
+    void StartFlush(FTraceFlush& Flush, bool bAsync);
+
+    // Runs the callbacks of a flush whose results are in
+    void CompleteFlush(FTraceFlush& Flush);
+
+    // Async world trace delegate; UserData is the result index within the flush
+    void OnWorldTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum, uint32 FlushSerial);
+
+    // Traces every segment of the given batches into the flush's results, starting at each batch's offset.
+    // With bUseHitboxes, the physics query skips the hitbox actors and HitboxBVH supplies pawn hits.
+    void RunTraces(UWorld* World, FTraceFlush& Flush, TConstArrayView<int32> BatchIndices, bool bUseHitboxes, bool bAsync);
+
+    // Gathers the recorded characters at Time into Hitboxes and refits HitboxBVH to them
+    void UpdateHitboxes(const ULagCompensationSubsystem& LagCompensation, double Time);
+
+    static void MakePawnHit(const FHitboxCapsule& Capsule, const FHitboxRayHit& RayHit, const FVector& Start, const FVector& End, FHitResult& OutHit);
+
+    TArray<FHitscanTraceBatch> PendingBatches;
+    TArray<TUniquePtr<FTraceFlush>> InFlightFlushes; // Oldest first
+    TArray<TUniquePtr<FTraceFlush>> SpareFlushes;    // Completed flushes, reused so their arrays keep capacity
+    uint32 NextFlushSerial = 1;
+    bool bFlushing = false;
+
+    // Scratch buffers reused every flush
+    TArray<TPair<int32, int32>> FlatTraces; // Batch index, segment index
+
+    FHitboxBVH HitboxBVH;
+    TArray<FHitboxCapsule> Hitboxes;
+};
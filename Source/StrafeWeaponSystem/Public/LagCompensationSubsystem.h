@@ -0,0 +1,173 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "LagCompensationSubsystem.generated.h"
+
+class ACharacter;
+class AController;
+class USkeletalMeshComponent;
+struct FHitboxCapsule;
+
+/** One physics-asset body of a character mesh, as a capsule in the mesh's component space. */
+struct FLagCompensationBody
+{
+    FVector Start = FVector::ZeroVector;
+    FVector End = FVector::ZeroVector;
+    float Radius = 0.0f;
+    FName BoneName;
+    int32 BodyIndex = INDEX_NONE; // Into the mesh's Bodies, for its collision settings and physical material
+};
+
+/** Where one character's collision was at the end of one server frame. */
+struct FLagCompensationSample
+{
+    double Time = 0.0;
+    FVector Location = FVector::ZeroVector;
+    FQuat Rotation = FQuat::Identity;
+    float CapsuleRadius = 0.0f;
+    float CapsuleHalfHeight = 0.0f;
+
+    // World transform of the character mesh, which carries the physics-asset hitboxes
+    FTransform MeshTransform = FTransform::Identity;
+
+    // The mesh's physics-asset bodies in its current pose; empty when it has no physics asset
+    TArray<FLagCompensationBody> Bodies;
+};
+
+/**
+ * Optional shape of the traces a rewind is made for. Characters that can't be inside it at the
+ * rewound time are left where they are, which keeps a narrow shot from moving every pawn on the server.
+ */
+struct FLagCompensationQuery
+{
+    FVector Origin = FVector::ZeroVector;
+    FVector Direction = FVector::ForwardVector;
+    float Range = 0.0f;
+    float HalfAngleRadians = 0.0f;
+};
+
+/**
+ * Server-side lag compensation for hitscan weapons.
+ * At the end of every server frame the capsule, mesh transform and posed physics-asset bodies of each
+ * registered character are appended to a per-character ring of HistoryDepth samples. FScopedLagCompensation moves the other
+ * characters back to where the shooter saw them (server time minus the shooter's ping and
+ * ExtraRewindTime, capped at MaxRewindTime) for the duration of a trace batch and restores them when
+ * it goes out of scope. Rewinds are teleports with overlap events suppressed, so triggers never see them.
+ */
+UCLASS(Config = Game)
+class STRAFEWEAPONSYSTEM_API ULagCompensationSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    /** Starts recording the character. Server only; AStrafeCharacter registers itself. */
+    void RegisterCharacter(ACharacter* Character);
+    void UnregisterCharacter(ACharacter* Character);
+
+    /** World time the shooter was looking at when their shot reached the server. */
+    double GetEstimatedViewTime(const AController* Shooter) const;
+
+    /** Interpolated sample at a past world time. Returns false when the character isn't recorded. */
+    bool GetSampleAtTime(const ACharacter* Character, double Time, FLagCompensationSample& OutSample) const;
+
+    /**
+     * Appends the hitboxes of every recorded character with collision enabled, as they were at Time
+     * (or as they are now, for the current time): one capsule per query-enabled physics-asset body of
+     * the mesh, or the movement capsule for a mesh without a physics asset. Boxes are approximated by a
+     * capsule along their longest axis. Each capsule carries the channels its body blocks and its
+     * physical material. The order is stable between calls within a frame.
+     */
+    void GatherHitboxes(double Time, TArray<FHitboxCapsule>& OutHitboxes) const;
+
+    UFUNCTION(BlueprintPure, Category = "LagCompensation")
+    int32 GetNumRecordedCharacters() const { return Histories.Num(); }
+
+    void LogLagCompensationStats() const;
+
+protected:
+    // Samples kept per character; at 60Hz the default covers a little over half a second
+    UPROPERTY(Config)
+    int32 HistoryDepth = 40;
+
+    // Shots are never rewound further than this, whatever the shooter's ping
+    UPROPERTY(Config)
+    float MaxRewindTime = 0.25f;
+
+    // Fraction of the shooter's round-trip ping to rewind by. Simulated proxies are shown roughly
+    // half a trip late and the shot takes the other half to arrive, so the whole trip is the default.
+    UPROPERTY(Config)
+    float PingRewindScale = 1.0f;
+
+    // Added on top of the ping, e.g. for client-side smoothing of simulated proxies
+    UPROPERTY(Config)
+    float ExtraRewindTime = 0.0f;
+
+private:
+    friend struct FScopedLagCompensation;
+
+    struct FCharacterHistory
+    {
+        TWeakObjectPtr<ACharacter> Character;
+        TArray<FLagCompensationSample> Samples; // HistoryDepth slots used as a ring
+        int32 Head = 0;                         // Oldest sample
+        int32 Num = 0;
+    };
+
+    // Current state of a character, in the same form as the recorded samples. Writes into OutSample so
+    // the ring slots keep their body arrays; restoring a rewind doesn't need the bodies at all.
+    static void CaptureSample(const ACharacter* Character, double Time, FLagCompensationSample& OutSample, bool bWithBodies = true);
+
+    // Sphyl, sphere and box elements of the mesh's physics asset, posed with its current bone transforms
+    static void CaptureBodies(const USkeletalMeshComponent* Mesh, TArray<FLagCompensationBody>& OutBodies);
+
+    // Teleports the character's capsule and mesh to the sample; callers suppress overlap events
+    static void ApplySample(ACharacter* Character, const FLagCompensationSample& Sample);
+
+    bool SampleHistory(const FCharacterHistory& History, double Time, FLagCompensationSample& OutSample) const;
+
+    TArray<FCharacterHistory> Histories;
+
+    // Running totals for LogLagCompensationStats
+    uint64 TotalRewinds = 0;
+    uint64 TotalCharactersMoved = 0;
+    uint64 TotalCharactersSkipped = 0;
+    uint64 TotalRewindCycles = 0;
+    uint32 MaxRewindCycles = 0;
+    int32 MaxCharactersMoved = 0;
+};
+
+/**
+ * Rewinds every recorded character except the shooter's pawn to the shooter's estimated view time
+ * for as long as the scope lives. Does nothing on clients or for locally controlled shooters.
+ * Keep the scope tight around the traces: the world is in a past state while it's alive.
+ */
+struct STRAFEWEAPONSYSTEM_API FScopedLagCompensation
+{
+    FScopedLagCompensation(UWorld* World, AController* Shooter, const FLagCompensationQuery* Query = nullptr);
+    ~FScopedLagCompensation();
+
+    FScopedLagCompensation(const FScopedLagCompensation&) = delete;
+    FScopedLagCompensation& operator=(const FScopedLagCompensation&) = delete;
+
+    int32 GetNumRewound() const { return Rewound.Num(); }
+
+private:
+    struct FRewoundCharacter
+    {
+        TWeakObjectPtr<ACharacter> Character;
+        FLagCompensationSample Original;
+        bool bCapsuleOverlaps = false;
+        bool bMeshOverlaps = false;
+    };
+
+    TWeakObjectPtr<ULagCompensationSubsystem> Subsystem;
+    TArray<FRewoundCharacter, TInlineAllocator<16>> Rewound;
+    uint32 WorkCycles = 0; // Rewind plus restore, excluding whatever ran inside the scope
+};
@@ -0,0 +1,30 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+
+/**
+ * Dormancy rules for replicated actors that sit idle most of the match (checkpoints, pickups,
+ * holstered weapons). Such actors start dormant and are only woken for an actual state change, so
+ * they drop out of the server's per-tick consider list. Strafe.Net.Dormancy 0 keeps everything awake
+ * for debugging. Strafe.Net.ReplicationReport logs what the server still considers every net tick.
+ */
+struct STRAFEWEAPONSYSTEM_API FNetDormancyPolicy
+{
+    /** Dormancy an actor should be constructed with: Requested, or DORM_Awake while dormancy is disabled. */
+    static ENetDormancy GetInitialDormancy(ENetDormancy Requested);
+
+    /** Sends the actor's changed properties once and lets it go back to sleep. Server only; no-op for awake actors. */
+    static void FlushStateChange(AActor* Actor);
+
+    /** Replicates every update again, e.g. while the actor carries client RPCs. Server only. */
+    static void Wake(AActor* Actor);
+
+    /** Replicates the pending state, then nothing until the next flush or wake. Server only. */
+    static void Sleep(AActor* Actor);
+
+    /** Logs active versus dormant network objects, the classes that dominate the consider list, and server bandwidth. */
+    static void LogReplicationReport(UWorld* World);
+};
@@ -6,6 +6,11 @@
 #include "GameFramework/Actor.h"
 #include "ProjectileBase.generated.h"
 
+class ABaseWeapon;
+class UWeaponDataAsset;
+class UProjectilePoolSubsystem;
+class UProjectileSimulationSubsystem;
+class AProjectileSpawnReplicator;
 
 USTRUCT(BlueprintType)
 struct FExplosionParams
@@ -70,7 +75,7 @@ protected:
     UPROPERTY(Replicated)
     AController* ProjectileOwner;
 
-    UPROPERTY(Replicated)
+    UPROPERTY(ReplicatedUsing = OnRep_OwningWeapon)
     ABaseWeapon* OwningWeapon;
 
     UPROPERTY()
@@ -78,18 +83,83 @@ protected:
 
     FTimerHandle LifetimeTimer;
 
+    // False while parked in the projectile pool; drives hide/show on clients
+    UPROPERTY(ReplicatedUsing = OnRep_PoolActive)
+    bool bPoolActive = true;
+
+    // Set by UProjectilePoolSubsystem before BeginPlay. Server only.
+    bool bManagedByPool = false;
+
+    // Record index in UProjectileSimulationSubsystem while batched simulation owns our movement
+    int32 SimulationIndex = INDEX_NONE;
+
+    // Activation prediction key of the fire ability that spawned us; lets the shooter's client swap out its predicted copy
+    UPROPERTY(ReplicatedUsing = OnRep_PredictionKeyId)
+    int16 PredictionKeyId = 0;
+
+    // Shooter's client, after taking over from a predicted projectile: how far ahead of the replicated
+    // movement we run, so we stay where the predicted copy would have been instead of falling back
+    float PredictionLeadTime = 0.0f;
+
+    // Visual offset of ProjectileMesh being blended out after taking over from a predicted projectile
+    FVector HandoffOffset = FVector::ZeroVector;
+    FVector HandoffMeshRelativeLocation = FVector::ZeroVector;
+    float HandoffBlendTime = 0.0f;
+    float HandoffBlendRemaining = 0.0f;
+
+    // Record in AProjectileSpawnReplicator while clients simulate us from a spawn record. Server only.
+    int32 SpawnRecordId = INDEX_NONE;
+
+    // Slot in the owning weapon's FActiveProjectileRing while registered
+    int32 RegistrySlot = INDEX_NONE;
+
+    // Spawn order within the owning weapon, assigned on registration
+    uint32 RegistrySequence = 0;
+
 public:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    virtual void Tick(float DeltaSeconds) override;
     virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+    virtual void PostNetReceiveLocationAndRotation() override;
 
+    // bRegisterWithWeapon is off for predicted copies, which must not count towards the weapon's limits
     UFUNCTION(BlueprintCallable, Category = "Projectile")
-    void InitializeProjectile(AController* NewOwner, ABaseWeapon* Weapon, const UWeaponDataAsset* InWeaponData);
+    void InitializeProjectile(AController* NewOwner, ABaseWeapon* Weapon, const UWeaponDataAsset* InWeaponData, bool bRegisterWithWeapon = true);
 
+    // On clients this is forwarded to the owning weapon's batched ServerDetonateProjectiles
     UFUNCTION(BlueprintCallable, Category = "Projectile")
     virtual void Detonate();
 
-    UFUNCTION(Server, Reliable)
-    void ServerDetonate();
+    // Pool lifecycle, driven by UProjectilePoolSubsystem on the server
+    void ActivateFromPool(const FTransform& SpawnTransform, AController* NewOwner, ABaseWeapon* Weapon, const UWeaponDataAsset* InWeaponData);
+    void DeactivateToPool();
+
+    bool IsPoolActive() const { return bPoolActive; }
+
+    // Movement accessors that work for both the movement component and batched simulation
+    UFUNCTION(BlueprintPure, Category = "Projectile")
+    FVector GetProjectileVelocity() const;
+
+    UFUNCTION(BlueprintCallable, Category = "Projectile")
+    void SetProjectileVelocity(const FVector& NewVelocity);
+
+    UFUNCTION(BlueprintCallable, Category = "Projectile")
+    void StopProjectileMovement();
+
+    bool IsBatchSimulated() const { return SimulationIndex != INDEX_NONE; }
+
+    /**
+     * Spawns a client-only copy (spawn-record proxy or predicted projectile): never replicated and never
+     * authoritative, so it moves and collides locally while damage and lifetime stay with the server.
+     */
+    static AProjectileBase* SpawnLocalProjectile(UWorld* World, TSubclassOf<AProjectileBase> ProjectileClass, const FTransform& SpawnTransform);
+
+    /** Draws the mesh at VisualLocation and blends it back onto the actor over BlendTime. */
+    void BeginHandoffBlend(const FVector& VisualLocation, float BlendTime);
+
+    /** Moves the projectile along its ballistic path by Seconds of flight, sweeping. Client-side catch-up only. */
+    void FastForward(float Seconds);
 
 protected:
     UFUNCTION()
@@ -111,4 +181,44 @@ protected:
 
     void ApplyExplosionDamageAndImpulse(FVector ExplosionLocation);
     void SelfDestruct();
+
+    // Fires OnProjectileSpawned and arms the lifetime timer
+    void StartProjectile();
+    void ArmLifetimeTimer(float Seconds);
+
+    // Tells spawn-record clients that we stuck at our current location. No-op for actor-replicated projectiles.
+    void NotifyStuck();
+
+    // Impact reported by UProjectileSimulationSubsystem's batched sweep
+    void HandleSimulatedHit(const FHitResult& Hit);
+
+    // Restores per-shot state to class defaults before a pooled projectile is reused
+    virtual void ResetProjectileState();
+
+    // Unregisters from the weapon and hands the actor back to the pool (or destroys it)
+    void ReleaseProjectile();
+
+    // The pool's spawn record replicator, or null when this world has no pool
+    AProjectileSpawnReplicator* GetSpawnReplicator() const;
+
+    // Applies bPoolActive to visibility, collision and movement
+    void ApplyPoolActiveState();
+
+    UFUNCTION()
+    void OnRep_PoolActive();
+
+    // Shooter's client: replaces the predicted projectile for this key with us
+    UFUNCTION()
+    void OnRep_PredictionKeyId();
+
+    // Keeps the client-side weapon registry in sync so clients can select projectiles to detonate
+    UFUNCTION()
+    void OnRep_OwningWeapon(ABaseWeapon* PreviousWeapon);
+
+private:
+    friend class UProjectilePoolSubsystem;
+    friend class UProjectileSimulationSubsystem;
+    friend class ABaseWeapon;
+    friend struct FActiveProjectileRing;
+    friend class AProjectileSpawnReplicator;
 };
\ No newline at end of file
@@ -0,0 +1,114 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ProjectilePoolSubsystem.generated.h"
+
+class AProjectileBase;
+class ABaseWeapon;
+class UWeaponDataAsset;
+class AProjectileSpawnReplicator;
+
+USTRUCT(BlueprintType)
+struct FProjectilePoolStats
+{
+    GENERATED_BODY()
+
+    // Acquisitions served by a parked actor
+    UPROPERTY(BlueprintReadOnly, Category = "Projectile|Pool")
+    int32 Hits = 0;
+
+    // Acquisitions that had to fall back to SpawnActor
+    UPROPERTY(BlueprintReadOnly, Category = "Projectile|Pool")
+    int32 Misses = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Projectile|Pool")
+    int32 Releases = 0;
+
+    // Releases that destroyed the actor because the pool was already full
+    UPROPERTY(BlueprintReadOnly, Category = "Projectile|Pool")
+    int32 Overflows = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Projectile|Pool")
+    int32 Available = 0;
+};
+
+USTRUCT()
+struct FProjectilePool
+{
+    GENERATED_BODY()
+
+    // Inactive (hidden, collision off, movement stopped, dormant) projectiles ready for reuse
+    UPROPERTY()
+    TArray<TObjectPtr<AProjectileBase>> Available;
+
+    // Same, for spawn-record weapons: these actors were spawned unreplicated and stay that way
+    UPROPERTY()
+    TArray<TObjectPtr<AProjectileBase>> AvailableUnreplicated;
+
+    TArray<TObjectPtr<AProjectileBase>>& GetAvailable(bool bReplicated) { return bReplicated ? Available : AvailableUnreplicated; }
+
+    FProjectilePoolStats Stats;
+};
+
+/**
+ * Per-world pool of projectile actors keyed by projectile class.
+ * Replaces SpawnActor/Destroy per shot with an activate/deactivate cycle on the server.
+ * Parked projectiles go dormant once clients have them hidden, so they cost no replication until they
+ * are handed out again, and clients reuse their copy as well. Spawn-record projectiles never replicate
+ * as actors and are pooled separately, so no reused actor ever has to switch replication on or off.
+ */
+UCLASS(Config = Game)
+class STRAFEWEAPONSYSTEM_API UProjectilePoolSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+    virtual void Deinitialize() override;
+
+    /** Spawns parked projectiles until at least Count of the class are available. Server only. */
+    UFUNCTION(BlueprintCallable, Category = "Projectile|Pool")
+    void PrewarmPool(TSubclassOf<AProjectileBase> ProjectileClass, int32 Count, bool bReplicated = true);
+
+    /**
+     * Takes a parked projectile (or spawns one on a miss), places it at SpawnTransform and runs
+     * the activation path that replaces BeginPlay + InitializeProjectile for pooled actors.
+     * PredictionKeyId ties the projectile to the shooter's predicted stand-in (0 = not predicted).
+     */
+    AProjectileBase* AcquireProjectile(TSubclassOf<AProjectileBase> ProjectileClass, const FTransform& SpawnTransform,
+        AActor* NewOwner, APawn* NewInstigator, AController* ProjectileOwner, ABaseWeapon* Weapon, const UWeaponDataAsset* WeaponData,
+        int16 PredictionKeyId = 0);
+
+    /** Deactivates the projectile and parks it. Destroys it instead when the class pool is full. */
+    void ReleaseProjectile(AProjectileBase* Projectile);
+
+    UFUNCTION(BlueprintPure, Category = "Projectile|Pool")
+    FProjectilePoolStats GetPoolStats(TSubclassOf<AProjectileBase> ProjectileClass) const;
+
+    UFUNCTION(BlueprintPure, Category = "Projectile|Pool")
+    FProjectilePoolStats GetTotalPoolStats() const;
+
+    void LogPoolStats() const;
+
+    /** The world's spawn-record replicator. Spawned on first use on the server; null on clients until it replicates. */
+    AProjectileSpawnReplicator* GetSpawnReplicator();
+
+    void RegisterSpawnReplicator(AProjectileSpawnReplicator* Replicator);
+
+protected:
+    // Upper bound of parked actors per class; releases beyond this are destroyed
+    UPROPERTY(Config)
+    int32 MaxPooledPerClass = 64;
+
+private:
+    AProjectileBase* SpawnPooledProjectile(TSubclassOf<AProjectileBase> ProjectileClass, const FTransform& SpawnTransform, bool bReplicated);
+
+    UPROPERTY()
+    TMap<TSubclassOf<AProjectileBase>, FProjectilePool> Pools;
+
+    UPROPERTY()
+    TObjectPtr<AProjectileSpawnReplicator> SpawnReplicator;
+};
@@ -0,0 +1,175 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CollisionQueryParams.h"
+#include "ProjectileSimulationSubsystem.generated.h"
+
+class AProjectileBase;
+class AController;
+class UWeaponDataAsset;
+class UPrimitiveComponent;
+
+/** One fixed-step state of a simulated projectile, kept for rewinding. */
+struct FProjectileStateSample
+{
+    double Time = 0.0;     // World time at the end of the step
+    FVector Position = FVector::ZeroVector;
+    FVector Velocity = FVector::ZeroVector;
+};
+
+/**
+ * Server-side batched movement for projectiles whose weapon opts in through FWeaponStats::SimulationMode.
+ * Live projectiles are kept as structure-of-arrays records, integrated in one loop per frame and swept
+ * as one batch afterwards: a ParallelFor of read-only scene queries, applied back on the game thread.
+ * The actors themselves only receive the resulting transform (for replication) and the impact
+ * callback; their UProjectileMovementComponent stays deactivated.
+ *
+ * Analytic records follow the closed-form ballistic path from their launch state. Static geometry
+ * along that path is swept ahead in long segments when the record is added, and the impact is
+ * scheduled for the predicted flight time. Per-frame sweeps only run when a dynamic object overlaps
+ * the frame's path segment (one broad-phase overlap per cluster of nearby paths) or the scheduled impact is due.
+ *
+ * Both modes advance in fixed steps (FixedTimeStep, at most MaxSubStepsPerFrame per frame), so hit
+ * results don't depend on the server tick rate. Every step appends to a short per-record history
+ * that GetStateAtTime interpolates for rewinds.
+ */
+UCLASS(Config = Game)
+class STRAFEWEAPONSYSTEM_API UProjectileSimulationSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    /**
+     * Starts simulating the projectile from its current location with the given world-space velocity.
+     * bAnalytic selects closed-form motion with predicted impacts; speed clamping does not apply to it.
+     */
+    void AddProjectile(AProjectileBase* Projectile, const FVector& LaunchVelocity, bool bAnalytic = false);
+
+    /** Stops simulating the projectile. Safe to call for projectiles that aren't registered. */
+    void RemoveProjectile(AProjectileBase* Projectile);
+
+    FVector GetVelocity(const AProjectileBase* Projectile) const;
+    void SetVelocity(AProjectileBase* Projectile, const FVector& NewVelocity);
+
+    UFUNCTION(BlueprintPure, Category = "Projectile|Simulation")
+    int32 GetNumSimulatedProjectiles() const { return Projectiles.Num(); }
+
+    /**
+     * Interpolated state at a past world time, from the fixed-step history.
+     * Returns false when the projectile isn't simulated or Time falls outside the recorded window.
+     */
+    bool GetStateAtTime(const AProjectileBase* Projectile, double Time, FVector& OutPosition, FVector& OutVelocity) const;
+
+    // Sub-steps run during the last Tick, for tuning FixedTimeStep against CPU cost
+    UFUNCTION(BlueprintPure, Category = "Projectile|Simulation")
+    int32 GetLastFrameSubSteps() const { return LastFrameSubSteps; }
+
+    void LogSimulationStats() const;
+
+protected:
+    // Integration step in seconds
+    UPROPERTY(Config)
+    float FixedTimeStep = 1.0f / 60.0f;
+
+    // Steps beyond this in one frame are dropped rather than simulated late
+    UPROPERTY(Config)
+    int32 MaxSubStepsPerFrame = 8;
+
+    // Past states kept per projectile (HistoryLength * FixedTimeStep seconds of rewind)
+    UPROPERTY(Config)
+    int32 HistoryLength = 32;
+
+    // How far ahead (in flight seconds) static geometry is swept for analytic records
+    UPROPERTY(Config)
+    float AnalyticPredictionHorizon = 2.0f;
+
+    // Length of one predictive sweep along a curved path; straight paths use a single sweep
+    UPROPERTY(Config)
+    float AnalyticSegmentTime = 0.1f;
+
+    // Steps with fewer sweeps than this run them on the game thread; task dispatch isn't free
+    UPROPERTY(Config)
+    int32 MinSweepsForParallel = 16;
+
+private:
+    void RemoveAtSwap(int32 Index);
+    bool IsValidIndex(const AProjectileBase* Projectile, int32& OutIndex) const;
+
+    // Position on the analytic path FlightTime seconds after the record's launch state
+    FVector EvaluatePath(int32 Index, float FlightTime) const;
+
+    // Re-bases an analytic record on its current state, e.g. after SetVelocity
+    void ResetPath(int32 Index);
+
+    // Sweeps static geometry from FromTime to the horizon and schedules the first impact found
+    void PredictImpact(UWorld* World, int32 Index, float FromTime);
+
+    // Collects bounds of dynamic objects near the analytic paths for the next FrameTime seconds
+    void GatherDynamicBounds(UWorld* World, float FrameTime);
+
+    // One fixed step over every record; returns the number of analytic sweeps skipped
+    int32 StepSimulation(UWorld* World, float StepTime, double StepEndTime);
+
+    void WriteTransform(int32 Index);
+    void RecordHistory(int32 Index, double Time);
+
+    // True when a dynamic object the record would block against overlaps its segment for this frame
+    bool IsSegmentObstructed(int32 Index, const FVector& Start, const FVector& End) const;
+
+    // Structure-of-arrays records. Index i across all arrays describes one projectile and
+    // AProjectileBase::SimulationIndex points back into them.
+    UPROPERTY()
+    TArray<TObjectPtr<AProjectileBase>> Projectiles;
+
+    // Read by LogSimulationStats for the per-weapon breakdown
+    UPROPERTY()
+    TArray<TObjectPtr<const UWeaponDataAsset>> WeaponData;
+
+    // The owner's pawn is left out of the corridor test, as the sweeps ignore it
+    TArray<TWeakObjectPtr<AController>> Owners;
+    TArray<FVector> Positions;
+    TArray<FVector> Velocities;
+    TArray<float> GravityScales;
+    TArray<float> MaxSpeeds;
+    TArray<float> Lifetimes;
+    TArray<float> Radii;
+
+    // Collision setup copied from the projectile's sphere at registration
+    TArray<TEnumAsByte<ECollisionChannel>> Channels;
+    TArray<FCollisionResponseParams> ResponseParams;
+    TArray<FCollisionQueryParams> QueryParams;
+
+    // Analytic records only (ignored otherwise): path origin, time along it and the prediction state
+    TArray<bool> Analytic;
+    TArray<FVector> LaunchPositions;
+    TArray<FVector> LaunchVelocities;
+    TArray<float> FlightTimes;
+    TArray<float> PredictedImpactTimes;  // Max when no static impact lies within the predicted span
+    TArray<float> PredictedUntilTimes;   // Static geometry is known clear up to this flight time
+
+    // HistoryLength samples per record, used as a ring starting at HistoryHeads[i]
+    TArray<FProjectileStateSample> HistorySamples;
+    TArray<int32> HistoryHeads;
+    TArray<int32> HistoryCounts;
+
+    float TimeAccumulator = 0.0f;
+    int32 LastFrameSubSteps = 0;
+    uint64 TotalSubSteps = 0;
+    uint64 TotalFrames = 0;
+
+    // Scratch buffers reused every frame
+    TArray<FVector> SweepEnds;
+    TArray<int32> SweepIndices;      // Records that need a sweep this step
+    TArray<FHitResult> SweepHits;    // Parallel to SweepIndices
+    TArray<TPair<FBox, TWeakObjectPtr<UPrimitiveComponent>>> DynamicBounds;
+    TArray<TPair<TWeakObjectPtr<AProjectileBase>, FHitResult>> PendingHits;
+    TArray<TWeakObjectPtr<AProjectileBase>> PendingExpired;
+};
@@ -0,0 +1,162 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "ProjectileSpawnReplicator.generated.h"
+
+class AProjectileBase;
+class ABaseWeapon;
+class AProjectileSpawnReplicator;
+
+UENUM()
+enum class EProjectileRecordState : uint8
+{
+    Flying,
+    Stuck,
+    Detonated,
+};
+
+/** Everything a client needs to simulate one projectile locally. */
+USTRUCT()
+struct FProjectileSpawnRecord : public FFastArraySerializerItem
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    int32 RecordId = 0;
+
+    // Index into AProjectileSpawnReplicator::ProjectileClasses
+    UPROPERTY()
+    uint8 ClassIndex = 0;
+
+    UPROPERTY()
+    FVector_NetQuantize Origin;
+
+    UPROPERTY()
+    FVector_NetQuantizeNormal Direction;
+
+    // Launch speed in whole units per second
+    UPROPERTY()
+    uint16 Speed = 0;
+
+    UPROPERTY()
+    float SpawnServerTime = 0.0f;
+
+    // APlayerState::GetPlayerId of the shooter; INDEX_NONE for unowned projectiles
+    UPROPERTY()
+    int32 OwnerPlayerId = INDEX_NONE;
+
+    // Lets the shooter's client keep its weapon registry (and detonation selection) working
+    UPROPERTY()
+    TObjectPtr<ABaseWeapon> Weapon;
+
+    // Fire ability's prediction key; the shooter's client adopts its predicted projectile instead of spawning a proxy
+    UPROPERTY()
+    int16 PredictionKey = 0;
+
+    UPROPERTY()
+    EProjectileRecordState State = EProjectileRecordState::Flying;
+
+    // Where the projectile stuck or detonated
+    UPROPERTY()
+    FVector_NetQuantize EventLocation;
+
+    void PostReplicatedAdd(const struct FProjectileSpawnRecordArray& InArraySerializer);
+    void PostReplicatedChange(const struct FProjectileSpawnRecordArray& InArraySerializer);
+    void PreReplicatedRemove(const struct FProjectileSpawnRecordArray& InArraySerializer);
+};
+
+USTRUCT()
+struct FProjectileSpawnRecordArray : public FFastArraySerializer
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TArray<FProjectileSpawnRecord> Records;
+
+    // Set by the owning replicator; receives the client-side callbacks
+    AProjectileSpawnReplicator* Owner = nullptr;
+
+    bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+    {
+        return FFastArraySerializer::FastArrayDeltaSerialize<FProjectileSpawnRecord, FProjectileSpawnRecordArray>(Records, DeltaParms, *this);
+    }
+};
+
+template<>
+struct TStructOpsTypeTraits<FProjectileSpawnRecordArray> : public TStructOpsTypeTraitsBase2<FProjectileSpawnRecordArray>
+{
+    enum
+    {
+        WithNetDeltaSerializer = true,
+    };
+};
+
+/**
+ * Always-relevant carrier for projectiles whose weapon uses EProjectileReplicationMode::SpawnRecord.
+ * The server keeps the real projectile actor unreplicated and publishes a quantized spawn record here
+ * instead. Clients spawn a local proxy from the record and move it themselves; afterwards only stick
+ * and detonate events (and the final removal) are sent.
+ */
+UCLASS(NotPlaceable, NotBlueprintable)
+class STRAFEWEAPONSYSTEM_API AProjectileSpawnReplicator : public AActor
+{
+    GENERATED_BODY()
+
+public:
+    AProjectileSpawnReplicator();
+
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+    /** Publishes a record for a freshly launched projectile. Server only. Returns the record id. */
+    int32 AddRecord(AProjectileBase* Projectile, const FVector& LaunchVelocity);
+
+    /** Server only. */
+    void MarkStuck(int32 RecordId, const FVector& Location);
+
+    /** Server only. The record lingers for DetonatedRecordLifetime so the event reaches clients before the removal. */
+    void MarkDetonated(int32 RecordId, const FVector& Location);
+
+    /** Drops the record without an event, e.g. when the projectile fizzles. Server only. */
+    void RemoveRecord(int32 RecordId);
+
+    // Client-side record callbacks from FProjectileSpawnRecord
+    void OnRecordAdded(const FProjectileSpawnRecord& Record);
+    void OnRecordChanged(const FProjectileSpawnRecord& Record);
+    void OnRecordRemoved(const FProjectileSpawnRecord& Record);
+
+protected:
+    UPROPERTY(Replicated)
+    FProjectileSpawnRecordArray SpawnRecords;
+
+    // Append-only class table referenced by FProjectileSpawnRecord::ClassIndex
+    UPROPERTY(ReplicatedUsing = OnRep_ProjectileClasses)
+    TArray<TSubclassOf<AProjectileBase>> ProjectileClasses;
+
+    // How long a detonated record stays published before it is removed
+    UPROPERTY(EditDefaultsOnly, Category = "Projectile")
+    float DetonatedRecordLifetime = 1.0f;
+
+    UFUNCTION()
+    void OnRep_ProjectileClasses();
+
+private:
+    int32 FindRecordIndex(int32 RecordId) const;
+    void RemoveExpiredRecords();
+    void SpawnProxy(const FProjectileSpawnRecord& Record);
+
+    int32 NextRecordId = 1;
+
+    // Server: detonated records waiting for removal, with their removal time
+    TArray<TPair<int32, double>> PendingRemovals;
+    FTimerHandle RemovalTimer;
+
+    // Client: local proxies by record id, and records whose class hasn't replicated yet
+    TMap<int32, TWeakObjectPtr<AProjectileBase>> Proxies;
+    TArray<int32> PendingProxyRecords;
+};
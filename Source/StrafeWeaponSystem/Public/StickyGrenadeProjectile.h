@@ -31,5 +31,7 @@ protected:
     UFUNCTION()
     void OnRep_IsStuck();
 
+    virtual void ResetProjectileState() override;
+
     virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 };
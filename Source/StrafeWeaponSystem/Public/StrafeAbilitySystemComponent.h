@@ -0,0 +1,25 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AbilitySystemComponent.h"
+#include "StrafeAbilitySystemComponent.generated.h"
+
+/**
+ * Tells its owner when the granted ability specs change, so per-spec setup such as weapon input IDs
+ * runs once when a spec arrives instead of on every input press.
+ */
+UCLASS()
+class STRAFEWEAPONSYSTEM_API UStrafeAbilitySystemComponent : public UAbilitySystemComponent
+{
+    GENERATED_BODY()
+
+public:
+    // Server: a spec was given. Owning client: specs replicated in, including a SourceObject that resolved late.
+    FSimpleMulticastDelegate OnAbilitySpecsChanged;
+
+protected:
+    virtual void OnGiveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+    virtual void OnRep_ActivateAbilities() override;
+};
@@ -0,0 +1,20 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AbilitySystemGlobals.h"
+#include "StrafeAbilitySystemGlobals.generated.h"
+
+/**
+ * Makes every ability system in the game allocate FStrafeGameplayEffectContext.
+ * Selected through AbilitySystemGlobalsClassName in DefaultGame.ini.
+ */
+UCLASS()
+class STRAFEWEAPONSYSTEM_API UStrafeAbilitySystemGlobals : public UAbilitySystemGlobals
+{
+    GENERATED_BODY()
+
+public:
+    virtual FGameplayEffectContext* AllocGameplayEffectContext() const override;
+};
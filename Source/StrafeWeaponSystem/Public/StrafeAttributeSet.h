@@ -12,7 +12,13 @@
 	GAMEPLAYATTRIBUTE_VALUE_SETTER(PropertyName) \
 	GAMEPLAYATTRIBUTE_VALUE_INITTER(PropertyName)
 
-UCLASS()
+/**
+ * Ammo attributes replicate to the owning client only: nobody else needs exact counts, and sending
+ * them to everyone made attribute traffic grow with the square of the player count; PublicAttributes
+ * switches that back per attribute, and bReplicateHasAmmoFlags sends a coarse per-ammo-type flag to
+ * the other clients for spectator HUDs.
+ */
+UCLASS(Config = Game)
 class STRAFEWEAPONSYSTEM_API UStrafeAttributeSet : public UAttributeSet
 {
 	GENERATED_BODY()
@@ -21,6 +27,14 @@ public:
 	UStrafeAttributeSet();
 
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual void PostAttributeChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue) override;
+
+	/**
+	 * Whether the owner has any of this ammo. Exact on the server, the owning client and for public
+	 * attributes; elsewhere it comes from HasAmmoFlags and is false while those aren't replicated.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Ammo")
+	bool HasAmmo(const FGameplayAttribute& AmmoAttribute) const;
 
 	// --- Ammo Attributes ---
 	UPROPERTY(BlueprintReadOnly, Category = "Ammo", ReplicatedUsing = OnRep_RocketAmmo)
@@ -68,6 +82,21 @@ public:
 	// ATTRIBUTE_ACCESSORS(UStrafeAttributeSet, MovementSpeed);
 
 protected:
+	// Attributes replicated to every client instead of only the owner, by property name (e.g. RocketAmmo)
+	UPROPERTY(Config)
+	TArray<FName> PublicAttributes;
+
+	// Sends HasAmmoFlags to the non-owning clients
+	UPROPERTY(Config)
+	bool bReplicateHasAmmoFlags = false;
+
+	// One bit per ammo type (rocket, sticky grenade, shotgun), set while that ammo is above zero. Server driven.
+	UPROPERTY(Replicated)
+	uint8 HasAmmoFlags = 0;
+
+	// Bit in HasAmmoFlags for an ammo attribute, INDEX_NONE for anything else
+	static int32 GetHasAmmoFlagBit(const FGameplayAttribute& Attribute);
+
 	UFUNCTION()
 	virtual void OnRep_RocketAmmo(const FGameplayAttributeData& OldRocketAmmo);
 	UFUNCTION()
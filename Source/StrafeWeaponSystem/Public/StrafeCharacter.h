@@ -11,10 +11,12 @@
 #include "StrafeCharacter.generated.h"
 
 class UWeaponInventoryComponent;
+class UAmmoComponent;
 class ABaseWeapon;
 class UInputAction;
 class UInputMappingContext;
 class UAbilitySystemComponent; // Forward declaration
+class UStrafeAbilitySystemComponent;
 class UStrafeAttributeSet;   // Forward declaration
 class UGameplayEffect;       // Forward declaration
 class UGameplayAbility;      // Forward declaration
@@ -38,6 +40,7 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void PossessedBy(AController* NewController) override;
 	virtual void OnRep_PlayerState() override;
 
@@ -46,8 +49,12 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
 	UWeaponInventoryComponent* WeaponInventoryComponent;
 
+	// Tag-keyed ammo for weapons whose data asset sets AmmoTypeTag
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+	TObjectPtr<UAmmoComponent> AmmoComponent;
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Abilities, meta = (AllowPrivateAccess = "true"))
-	TObjectPtr<UAbilitySystemComponent> AbilitySystemComponent;
+	TObjectPtr<UStrafeAbilitySystemComponent> AbilitySystemComponent;
 
 	// WEAPON PROPERTIES
 	UPROPERTY(EditDefaultsOnly, Category = "Weapons")
@@ -106,6 +113,17 @@ public:
 	UFUNCTION()
 	void OnWeaponEquipped(ABaseWeapon* NewWeapon);
 
+	// Grants the weapon's fire abilities for as long as it's carried. Server only; called by the inventory on AddWeapon.
+	void GrantWeaponAbilities(ABaseWeapon* Weapon);
+
+	// Clears the abilities granted for the weapon. Server only; runs when it's destroyed or changes owner.
+	void RevokeWeaponAbilities(ABaseWeapon* Weapon);
+
+	UFUNCTION()
+	void OnWeaponEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason);
+
+	void HandleWeaponOwnerChanged(ABaseWeapon* Weapon, AActor* OldOwner);
+
 
 protected:
 	// INPUT HANDLER FUNCTIONS
@@ -117,6 +135,10 @@ protected:
 	void Input_SecondaryFire_Pressed();
 	void Input_SecondaryFire_Released();
 
+	// Rebinds the equipped weapon's input IDs whenever specs are given or replicate in, since on the owning
+	// client they and their SourceObject can arrive after the equip
+	void OnAbilitySpecsChanged();
+
 
 	// Weapon Switching
 	void NextWeapon();
@@ -131,9 +153,20 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Weapon")
 	UWeaponInventoryComponent* GetWeaponInventoryComponent() const { return WeaponInventoryComponent; }
 
+	UFUNCTION(BlueprintPure, Category = "Weapon")
+	UAmmoComponent* GetAmmoComponent() const { return AmmoComponent; }
+
 private:
-	// Store handles to granted weapon abilities to be able to remove them
-	TArray<FGameplayAbilitySpecHandle> CurrentWeaponAbilityHandles;
+	// Abilities granted per carried weapon (server only). Equipping doesn't touch these; losing the weapon clears them.
+	TMap<TWeakObjectPtr<ABaseWeapon>, TArray<FGameplayAbilitySpecHandle>> WeaponAbilityHandles;
+
+	FDelegateHandle WeaponOwnerChangedHandle;
+
+	// Gives EquippedWeapon's granted specs their ability's input ID and clears it on every other weapon's
+	void BindWeaponAbilityInputIDs(const ABaseWeapon* EquippedWeapon);
+
+	// UWeaponDataAsset::EquippedTag of the equipped weapon, held as a loose tag on the ASC
+	FGameplayTag CurrentEquippedWeaponTag;
 
 	// Default attribute values
 	UPROPERTY(EditDefaultsOnly, Category = "Abilities|Defaults")
@@ -0,0 +1,89 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEffectTypes.h"
+#include "Chaos/ChaosEngineInterface.h" // EPhysicalSurface
+#include "StrafeGameplayEffectContext.generated.h"
+
+/** Where one pellet of a multi-pellet shot came to rest. */
+USTRUCT(BlueprintType)
+struct STRAFEWEAPONSYSTEM_API FPelletImpact
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Impact")
+    FVector Location = FVector::ZeroVector;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Impact")
+    FVector Normal = FVector::UpVector;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Impact")
+    TEnumAsByte<EPhysicalSurface> SurfaceType = SurfaceType_Default;
+};
+
+/**
+ * Every blocking impact of one shot, so a single gameplay cue can spawn all of its decals.
+ * Impacts are sent as 1cm offsets from the shot origin (packed, so nearby hits take few bits)
+ * with 8-bit-per-axis normals and a 6-bit surface type.
+ */
+USTRUCT(BlueprintType)
+struct STRAFEWEAPONSYSTEM_API FPelletImpactBatch
+{
+    GENERATED_BODY()
+
+    static constexpr int32 MaxImpacts = 255;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Impact")
+    FVector Origin = FVector::ZeroVector;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Impact")
+    TArray<FPelletImpact> Impacts;
+
+    bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FPelletImpactBatch> : public TStructOpsTypeTraitsBase2<FPelletImpactBatch>
+{
+    enum
+    {
+        WithNetSerializer = true,
+    };
+};
+
+/**
+ * Effect context for this module, allocated by UStrafeAbilitySystemGlobals.
+ * Carries weapon-specific payloads through gameplay cue parameters.
+ */
+USTRUCT()
+struct STRAFEWEAPONSYSTEM_API FStrafeGameplayEffectContext : public FGameplayEffectContext
+{
+    GENERATED_BODY()
+
+    /** Returns the wrapped context when the handle holds one of ours, nullptr otherwise. */
+    static FStrafeGameplayEffectContext* ExtractEffectContext(FGameplayEffectContextHandle Handle);
+
+    // Empty unless the context describes a multi-pellet shot
+    UPROPERTY()
+    FPelletImpactBatch PelletImpacts;
+
+    virtual UScriptStruct* GetScriptStruct() const override
+    {
+        return FStrafeGameplayEffectContext::StaticStruct();
+    }
+
+    virtual FStrafeGameplayEffectContext* Duplicate() const override;
+    virtual bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess) override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FStrafeGameplayEffectContext> : public TStructOpsTypeTraitsBase2<FStrafeGameplayEffectContext>
+{
+    enum
+    {
+        WithNetSerializer = true,
+        WithCopy = true,
+    };
+};
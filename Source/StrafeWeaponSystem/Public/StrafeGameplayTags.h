@@ -0,0 +1,40 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NativeGameplayTags.h"
+
+/**
+ * Every gameplay tag the module's code refers to, registered natively at startup so code never looks
+ * a tag up by name. Tags that only data assets refer to (cue tags, per-weapon cooldowns) stay in
+ * DefaultGameplayTags.ini alone. Each tag here must also be listed there; ValidateAgainstConfig
+ * reports any that aren't.
+ */
+namespace StrafeGameplayTags
+{
+    STRAFEWEAPONSYSTEM_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Feedback_OutOfAmmo);
+    STRAFEWEAPONSYSTEM_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Weapon_PrimaryFire);
+    STRAFEWEAPONSYSTEM_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Weapon_SecondaryFire);
+    STRAFEWEAPONSYSTEM_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Weapon_ChargedShotgun_PrimaryFire);
+    STRAFEWEAPONSYSTEM_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Weapon_ChargedShotgun_SecondaryFire);
+
+    STRAFEWEAPONSYSTEM_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Cooldown_Weapon_ChargedShotgun_PrimaryFire);
+
+    STRAFEWEAPONSYSTEM_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(State_Dead);
+    STRAFEWEAPONSYSTEM_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(State_Stunned);
+    STRAFEWEAPONSYSTEM_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(State_Weapon_ChargedShotgun_Charging_PrimaryFire);
+    STRAFEWEAPONSYSTEM_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(State_Weapon_ChargedShotgun_Charging_SecondaryFire);
+    STRAFEWEAPONSYSTEM_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(State_Weapon_ChargedShotgun_Lockout);
+    STRAFEWEAPONSYSTEM_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(State_Weapon_ChargedShotgun_Overcharged_SecondaryFire);
+
+    STRAFEWEAPONSYSTEM_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ammo);
+    STRAFEWEAPONSYSTEM_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Weapon_Equipped);
+
+    STRAFEWEAPONSYSTEM_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(SetByCaller_AmmoCost);
+    STRAFEWEAPONSYSTEM_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(SetByCaller_AmmoInitial);
+    STRAFEWEAPONSYSTEM_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(SetByCaller_AmmoMax);
+
+    /** Logs an error for each tag above that DefaultGameplayTags.ini doesn't list. Run once tags are loaded. */
+    void ValidateAgainstConfig();
+}
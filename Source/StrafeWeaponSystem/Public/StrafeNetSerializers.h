@@ -0,0 +1,29 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Iris/Serialization/NetSerializerConfig.h"
+#include "StrafeNetSerializers.generated.h"
+
+/*
+ * Iris serializers for the module's structs with a custom NetSerialize. Everything else that
+ * replicates (FPlayerRaceTime, FPlayerScoreboardEntry, the spawn record fast array) is plain
+ * UPROPERTY data that Iris describes by reflection. The serializers themselves only exist in
+ * builds with UE_WITH_IRIS and are registered under the struct names, so Iris picks them up
+ * wherever the structs are replicated.
+ */
+
+/** FPelletImpactBatch: same quantization as FPelletImpactBatch::NetSerialize. */
+USTRUCT()
+struct FPelletImpactBatchNetSerializerConfig : public FNetSerializerConfig
+{
+    GENERATED_BODY()
+};
+
+/** FStrafeGameplayEffectContext: the engine's effect context serializer followed by the pellet impacts. */
+USTRUCT()
+struct FStrafeGameplayEffectContextNetSerializerConfig : public FNetSerializerConfig
+{
+    GENERATED_BODY()
+};
@@ -0,0 +1,111 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ReplicationGraph.h"
+#include "StrafeReplicationGraph.generated.h"
+
+class ABaseWeapon;
+
+/** How actors of a class are routed into the graph. */
+enum class EStrafeClassRepPolicy : uint8
+{
+    NotRouted,              // Replicated some other way (weapons ride along with their character)
+    RelevantAllConnections, // Game state, race manager, player states
+    RelevantOwnerOnly,      // Controllers and other owner-only actors
+    Spatialize_Dynamic,     // Moves every frame: arena characters
+    Spatialize_Dormancy,    // Mostly idle: pickups, checkpoints, parked pooled projectiles
+    RaceRival,              // Characters in race mode: relevant everywhere, replicated in frequency buckets
+};
+
+USTRUCT()
+struct FStrafeConnectionAlwaysRelevantNode
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TObjectPtr<UNetConnection> NetConnection = nullptr;
+
+    UPROPERTY()
+    TObjectPtr<UReplicationGraphNode_AlwaysRelevant_ForConnection> Node = nullptr;
+};
+
+/**
+ * Replication graph for the arena and race modes, replacing the per-actor relevancy scan.
+ * Projectiles, pickups and checkpoints live in a 2D spatial grid, so each connection only gathers the
+ * cells around its view. Game state, race manager and player states are in one always-relevant list.
+ * Weapons are not routed at all: they are dependents of the character that owns them and replicate
+ * to whichever connections the character does. In race mode the other racers are relevant everywhere
+ * but split into RaceRivalBuckets buckets, so each one is only considered every few frames.
+ * Enabled through ReplicationDriverClassName in DefaultEngine.ini. "stat StrafeNet" shows how many
+ * properties the server still polls for changes each frame, next to the push-model ones it skips.
+ */
+UCLASS(Transient, Config = Engine)
+class STRAFEWEAPONSYSTEM_API UStrafeReplicationGraph : public UReplicationGraph
+{
+    GENERATED_BODY()
+
+public:
+    virtual void InitGlobalActorClassSettings() override;
+    virtual void InitGlobalGraphNodes() override;
+    virtual void InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection) override;
+    virtual void OnRemoveConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection) override;
+    virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+    virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+    virtual int32 ServerReplicateActors(float DeltaSeconds) override;
+    virtual void BeginDestroy() override;
+
+protected:
+    UPROPERTY(Config)
+    float GridCellSize = 10000.0f;
+
+    // Lower-left corner of the grid; actors beyond it are clamped into the edge cells
+    UPROPERTY(Config)
+    FVector2D SpatialBias = FVector2D(-200000.0, -200000.0);
+
+    // Other racers are considered once every this many frames
+    UPROPERTY(Config)
+    int32 RaceRivalBuckets = 3;
+
+    UPROPERTY()
+    TObjectPtr<UReplicationGraphNode_GridSpatialization2D> GridNode;
+
+    UPROPERTY()
+    TObjectPtr<UReplicationGraphNode_ActorList> AlwaysRelevantNode;
+
+    UPROPERTY()
+    TObjectPtr<UReplicationGraphNode_ActorListFrequencyBuckets> RaceRivalsNode;
+
+    UPROPERTY()
+    TArray<FStrafeConnectionAlwaysRelevantNode> AlwaysRelevantForConnection;
+
+    // Owner-only actors whose owning connection wasn't known yet when they were added
+    UPROPERTY()
+    TArray<TObjectPtr<AActor>> ActorsWithoutNetConnection;
+
+private:
+    EStrafeClassRepPolicy GetPolicy(const AActor* Actor) const;
+    EStrafeClassRepPolicy GetClassPolicy(const UClass* Class, const AActor* ActorCDO) const;
+    UReplicationGraphNode_AlwaysRelevant_ForConnection* GetAlwaysRelevantNodeForConnection(const UNetConnection* Connection) const;
+    bool IsRaceMode() const;
+
+    // Weapons with an owner are its dependents; unowned ones (dropped) fall back to the grid
+    void AddWeapon(ABaseWeapon* Weapon, FGlobalActorReplicationInfo& GlobalInfo);
+    void RemoveWeapon(ABaseWeapon* Weapon, AActor* Owner);
+    void HandleWeaponOwnerChanged(ABaseWeapon* Weapon, AActor* OldOwner);
+
+    // Fills the StrafeNet stat group from the actors this frame's ServerReplicateActors replicated
+    void UpdatePropertyCompareStats(uint32 FrameNum);
+
+    struct FReplicatedPropertyCounts
+    {
+        int32 Polled = 0; // Compared against the shadow state every time the object replicates
+        int32 Push = 0;   // Only compared after a MARK_PROPERTY_DIRTY
+    };
+    const FReplicatedPropertyCounts& GetReplicatedPropertyCounts(const UClass* Class);
+
+    TClassMap<EStrafeClassRepPolicy> ClassRepPolicies;
+    TMap<TObjectKey<UClass>, FReplicatedPropertyCounts> ReplicatedPropertyCounts;
+    FDelegateHandle WeaponOwnerChangedHandle;
+};
@@ -0,0 +1,97 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineTypes.h"
+#include "WeaponAimSubsystem.generated.h"
+
+class AController;
+struct FHitscanTraceResult;
+
+/** Where a controller is looking this frame, and what the crosshair is on. */
+USTRUCT(BlueprintType)
+struct FWeaponAimResult
+{
+    GENERATED_BODY()
+
+    // Controller view point (camera for players, eyes for AI)
+    UPROPERTY(BlueprintReadOnly, Category = "Weapon|Aim")
+    FVector ViewLocation = FVector::ZeroVector;
+
+    // Control rotation; the server sees the same value for remote players
+    UPROPERTY(BlueprintReadOnly, Category = "Weapon|Aim")
+    FRotator ViewRotation = FRotator::ZeroRotator;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Weapon|Aim")
+    FVector AimDirection = FVector::ForwardVector;
+
+    // This frame's view ray at the distance of the last aim trace's impact, or at the trace's end when it
+    // hit nothing or no recent trace has come back
+    UPROPERTY(BlueprintReadOnly, Category = "Weapon|Aim")
+    FVector AimPoint = FVector::ZeroVector;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Weapon|Aim")
+    bool bAimTraceHit = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Weapon|Aim")
+    TWeakObjectPtr<AActor> AimActor;
+
+    // Distance along the view ray of the last aim trace's impact
+    float AimTraceDistance = 0.0f;
+
+    // GFrameCounter of the last view update, the last aim trace queued and the last one resolved; 0 = never
+    uint64 ViewFrame = 0;
+    uint64 TraceRequestFrame = 0;
+    uint64 TraceFrame = 0;
+
+    bool HasCurrentView() const { return ViewFrame != 0 && ViewFrame == GFrameCounter; }
+
+    // Traces resolve a frame after they're queued, so the one that came back last frame is as recent as it gets
+    bool HasRecentTrace() const { return TraceFrame != 0 && GFrameCounter - TraceFrame <= 1; }
+};
+
+/**
+ * Per-controller aim shared by every weapon ability and the HUD crosshair.
+ * The view point is computed at most once per frame per controller, and only when somebody asks: a
+ * request with a stale frame stamp recomputes, later requests in the same frame reuse the result.
+ * The aim trace goes through UHitscanTraceQueueSubsystem with the frame's other traces, at most once
+ * per frame per controller; its hit distance arrives a frame later and is applied to the current view.
+ * The aim trace ignores the pawn and everything attached to it (the held weapon).
+ */
+UCLASS(Config = Game)
+class STRAFEWEAPONSYSTEM_API UWeaponAimSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+    /** This frame's aim for the controller; with bTraceAimPoint the aim trace fields are filled in too. */
+    UFUNCTION(BlueprintCallable, Category = "Weapon|Aim")
+    FWeaponAimResult GetAim(AController* Controller, bool bTraceAimPoint = true);
+
+    UFUNCTION(BlueprintPure, Category = "Weapon|Aim")
+    float GetAimTraceRange() const { return AimTraceRange; }
+
+protected:
+    UPROPERTY(Config)
+    float AimTraceRange = 10000.0f;
+
+    UPROPERTY(Config)
+    TEnumAsByte<ECollisionChannel> AimTraceChannel = ECC_Visibility;
+
+private:
+    void UpdateView(AController* Controller, FWeaponAimResult& Aim) const;
+
+    // Queues this frame's aim trace and fills the trace fields from the last one that came back
+    void UpdateTrace(AController* Controller, FWeaponAimResult& Aim);
+
+    void OnAimTraceComplete(TConstArrayView<FHitscanTraceResult> Results, TWeakObjectPtr<AController> Controller);
+
+    TMap<TWeakObjectPtr<AController>, FWeaponAimResult> Aims;
+
+    // Aims are keyed weakly; dead controllers are dropped once per frame when a new key shows up
+    uint64 LastPruneFrame = 0;
+};
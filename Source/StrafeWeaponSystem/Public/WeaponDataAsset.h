@@ -15,6 +15,8 @@
 
 #include "WeaponDataAsset.generated.h"
 
+class UAbilitySystemComponent;
+
 UENUM(BlueprintType)
 enum class EAmmoType : uint8 // This enum might become redundant if ammo is purely attribute-based
 {
@@ -25,6 +27,35 @@ enum class EAmmoType : uint8 // This enum might become redundant if ammo is pure
     // Add more as needed
 };
 
+UENUM(BlueprintType)
+enum class EProjectileSimulationMode : uint8
+{
+    // Each projectile ticks and sweeps its own UProjectileMovementComponent
+    MovementComponent,
+    // Server movement runs in UProjectileSimulationSubsystem's batched loop
+    Batched,
+    // Batched, following the closed-form ballistic path with predicted impacts; sweeps only near dynamic objects
+    Analytic,
+};
+
+UENUM(BlueprintType)
+enum class EProjectileReplicationMode : uint8
+{
+    // The projectile actor replicates its movement like any other actor
+    Actor,
+    // Only a quantized spawn record (plus stick/detonate events) replicates; clients simulate a local proxy
+    SpawnRecord,
+};
+
+UENUM(BlueprintType)
+enum class EProjectileLimitPolicy : uint8
+{
+    // Firing past MaxActiveProjectiles removes the weapon's oldest projectile without exploding
+    EvictOldest,
+    // Fire abilities can't activate while MaxActiveProjectiles are out
+    BlockFire,
+};
+
 USTRUCT(BlueprintType)
 struct FWeaponStats
 {
@@ -60,7 +91,23 @@ struct FWeaponStats
     TSubclassOf<class AProjectileBase> SecondaryProjectileClass; // If secondary fire also spawns a projectile
 
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
-    int32 MaxActiveProjectiles = 0; // 0 = unlimited. This might be checked by the ability or a separate system.
+    int32 MaxActiveProjectiles = 0; // 0 = unlimited. Enforced by the weapon's projectile registry.
+
+    // What happens when MaxActiveProjectiles is reached
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (EditCondition = "MaxActiveProjectiles > 0"))
+    EProjectileLimitPolicy ActiveProjectileLimitPolicy = EProjectileLimitPolicy::EvictOldest;
+
+    // Parked projectiles spawned per projectile class when the weapon begins play on the server
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Projectile|Pool", meta = (ClampMin = "0"))
+    int32 ProjectilePoolPrewarmCount = 8;
+
+    // How this weapon's projectiles are moved on the server
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Projectile|Simulation")
+    EProjectileSimulationMode SimulationMode = EProjectileSimulationMode::MovementComponent;
+
+    // How this weapon's projectiles reach clients. SpawnRecord suits deterministic paths (rockets, stickies).
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Projectile|Replication")
+    EProjectileReplicationMode ReplicationMode = EProjectileReplicationMode::Actor;
 
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Projectile|Sticky")
     bool bCanStickToCharacters = true;
@@ -84,6 +131,11 @@ struct FWeaponStats
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weapon|ChargedShotgun", meta = (EditCondition = "WeaponName == 'ChargedShotgun'", EditConditionHides))
     float PrimaryHitscanRange = 5000.0f;
 
+    // Fixed pellet layout for primary fire, as points in the unit disk (1 = edge of the spread cone).
+    // Empty means fully random spread; pellets beyond the pattern are random either way.
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weapon|ChargedShotgun", meta = (EditCondition = "WeaponName == 'ChargedShotgun'", EditConditionHides))
+    TArray<FVector2D> PrimarySpreadPattern;
+
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weapon|ChargedShotgun", meta = (EditCondition = "WeaponName == 'ChargedShotgun'", EditConditionHides))
     float SecondaryChargeTime = 3.0f;
 
@@ -98,6 +150,14 @@ struct FWeaponStats
 
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weapon|ChargedShotgun", meta = (EditCondition = "WeaponName == 'ChargedShotgun'", EditConditionHides))
     float SecondaryHitscanRange = 7500.0f;
+
+    // Fixed pellet layout for secondary fire; see PrimarySpreadPattern
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weapon|ChargedShotgun", meta = (EditCondition = "WeaponName == 'ChargedShotgun'", EditConditionHides))
+    TArray<FVector2D> SecondarySpreadPattern;
+
+    // Rolls the spread pattern by a per-shot seeded angle so fixed patterns don't always line up the same way
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weapon|ChargedShotgun", meta = (EditCondition = "WeaponName == 'ChargedShotgun'", EditConditionHides))
+    bool bRotateSpreadPattern = true;
 };
 
 UCLASS()
@@ -168,6 +228,11 @@ public:
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "GAS|Abilities")
     TSubclassOf<UGameplayAbility> SecondaryFireAbility;
 
+    // Loose tag the owner carries while this weapon is equipped (e.g. Weapon.Equipped.RocketLauncher).
+    // The fire abilities stay granted while the weapon is holstered and only activate with this tag present.
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "GAS|Abilities", meta = (Categories = "Weapon.Equipped"))
+    FGameplayTag EquippedTag;
+
     // This tag should be unique for this specific weapon's primary fire cooldown
     // The GameplayEffect for the cooldown will also use this tag.
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "GAS|Cooldowns", meta = (DisplayName = "Primary Cooldown Tag"))
@@ -178,6 +243,12 @@ public:
     FGameplayTag CooldownGameplayTag_Secondary;
 
     // Ammo
+    // Tag-keyed ammo held by the character's UAmmoComponent (e.g. Ammo.Rocket). Takes precedence over
+    // AmmoAttribute/MaxAmmoAttribute, which remain for assets that still keep their ammo in the attribute set.
+    // Cost effects for tag-keyed ammo use UAmmoCostExecution instead of an attribute modifier.
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "GAS|Attributes", meta = (Categories = "Ammo"))
+    FGameplayTag AmmoTypeTag;
+
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "GAS|Attributes", meta = (DisplayName = "Ammo Attribute"))
     FGameplayAttribute AmmoAttribute; // e.g., UStrafeAttributeSet::GetRocketAmmoAttribute()
 
@@ -200,6 +271,30 @@ public:
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "GAS|Attributes", meta = (DisplayName = "Default Max Ammo Value"))
     float DefaultMaxAmmo = 20.f;
 
+    bool UsesAmmo() const { return AmmoTypeTag.IsValid() || AmmoAttribute.IsValid(); }
+
+    /**
+     * Current and max ammo of this weapon for the ASC's avatar, from its UAmmoComponent when AmmoTypeTag
+     * is set and from the ammo attributes otherwise. Returns false when there's nothing to read.
+     */
+    bool GetAmmo(const UAbilitySystemComponent* ASC, float& OutCurrent, float& OutMax) const;
+
+    /**
+     * Instant effect overriding AmmoAttribute and MaxAmmoAttribute with the SetByCaller.AmmoInitial and
+     * SetByCaller.AmmoMax magnitudes. Built the first time it's needed and kept with the asset, so granting
+     * the weapon applies a spec instead of creating a UGameplayEffect. Null without both ammo attributes.
+     */
+    const UGameplayEffect* GetAmmoInitEffect() const;
+
+    /** Spec of GetAmmoInitEffect carrying InitialAmmoCount and DefaultMaxAmmo. Invalid without ammo attributes. */
+    FGameplayEffectSpecHandle MakeAmmoInitSpec(const UAbilitySystemComponent* ASC, UObject* SourceObject) const;
+
+    virtual void PostLoad() override;
+
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
     // Gameplay Cue tags
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "GAS|Effects")
     FGameplayTag MuzzleFlashCueTag;
@@ -240,4 +335,9 @@ public:
 
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "GAS|ChargedShotgun", meta = (EditCondition = "WeaponStats.WeaponName == 'ChargedShotgun'", EditConditionHides))
     FGameplayTag OverchargedCueTag; // GameplayCue for when secondary fire is fully charged and held
+
+private:
+    // Cache for GetAmmoInitEffect
+    UPROPERTY(Transient)
+    mutable TObjectPtr<UGameplayEffect> AmmoInitEffect;
 };
\ No newline at end of file
@@ -3,8 +3,14 @@
 
 #include "CoreMinimal.h"
 #include "BaseWeapon.h"
+#include "StrafeGameplayEffectContext.h"
+#include "GameplayPrediction.h"
 #include "ChargedShotgun.generated.h"
 
+class UAbilitySystemComponent;
+class UDamageType;
+struct FHitscanTraceResult;
+
 /**
  * A hitscan weapon that can be charged for primary fire,
  * and over-charged for a powerful secondary shot.
@@ -40,9 +46,15 @@ public:
      * @param DamageTypeClass The class of damage to apply.
      * @param InstigatorPawn The pawn that instigated this shot.
      * @param InstigatorController The controller of the instigator.
-     * @param OptionalImpactCueTag A gameplay cue to play at hit locations.
+     * @param OptionalImpactCueTag A gameplay cue executed once per shot; its effect context carries every pellet impact.
+     * @param SpreadSeed Seeds the pellet directions; the same seed and aim always give the same spread (see FPelletSpread).
+     * @param SpreadPattern Optional fixed pellet layout in the unit disk; extra pellets are random.
+     * @param bRotateSpreadPattern Rolls SpreadPattern by a seeded angle.
+     *
+     * Pellets are traced through UHitscanTraceQueueSubsystem at the end of the frame (under lag compensation
+     * on the server); damage is then summed per actor and applied once.
      */
-    UFUNCTION(BlueprintCallable, Category = "Weapon|ChargedShotgun")
+    UFUNCTION(BlueprintCallable, Category = "Weapon|ChargedShotgun", meta = (AutoCreateRefTerm = "SpreadPattern"))
     void PerformHitscanShot(
         const FVector& StartLocation,
         const FVector& AimDirection,
@@ -53,6 +65,35 @@ public:
         TSubclassOf<class UDamageType> DamageTypeClass,
         APawn* InstigatorPawn,
         AController* InstigatorController,
-        FGameplayTag OptionalImpactCueTag
+        FGameplayTag OptionalImpactCueTag,
+        int32 SpreadSeed,
+        const TArray<FVector2D>& SpreadPattern,
+        bool bRotateSpreadPattern
     );
-};
\ No newline at end of file
+
+    /**
+     * Reads the pellet impacts packed into a shot's impact cue.
+     * Call from the impact GameplayCueNotify to spawn every decal from the single event.
+     */
+    UFUNCTION(BlueprintPure, Category = "Weapon|ChargedShotgun")
+    static bool GetPelletImpacts(const FGameplayCueParameters& Parameters, TArray<FPelletImpact>& OutImpacts);
+
+private:
+    // Everything needed to resolve a shot once its queued traces come back
+    struct FPelletShot
+    {
+        FVector StartLocation = FVector::ZeroVector;
+        FVector AimDirection = FVector::ForwardVector;
+        float HitscanRange = 0.0f;
+        float DamageToApply = 0.0f;
+        TSubclassOf<UDamageType> DamageTypeClass;
+        TWeakObjectPtr<APawn> InstigatorPawn;
+        TWeakObjectPtr<AController> InstigatorController;
+        TWeakObjectPtr<UAbilitySystemComponent> SourceASC;
+        FGameplayTag ImpactCueTag;
+        FPredictionKey PredictionKey;
+        TArray<FVector, TInlineAllocator<16>> PelletDirs;
+    };
+
+    void ResolvePelletTraces(TConstArrayView<FHitscanTraceResult> Results, FPelletShot Shot);
+};
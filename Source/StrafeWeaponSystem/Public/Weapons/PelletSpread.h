@@ -0,0 +1,24 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Deterministic pellet directions for multi-pellet hitscan weapons.
+ * Everything comes from an FRandomStream seeded per shot, so the predicting client and the server
+ * produce the same spread from the same seed and aim; no directions need to be sent.
+ */
+struct STRAFEWEAPONSYSTEM_API FPelletSpread
+{
+    /** Seed for one shot of one activation. Both sides know the activation's prediction key. */
+    static int32 MakeSeed(int16 PredictionKey, int32 ShotIndex);
+
+    /**
+     * Fills OutDirections (one per pellet) with normalized directions inside a cone of SpreadAngle degrees.
+     * Pattern points lie in the unit disk (1 = edge of the cone) and place the first pellets; pellets
+     * beyond the pattern are spread randomly. bRotatePattern rolls the whole pattern by a seeded angle.
+     */
+    static void GenerateDirections(int32 Seed, const FVector& AimDirection, float SpreadAngle,
+        TConstArrayView<FVector2D> Pattern, bool bRotatePattern, TArrayView<FVector> OutDirections);
+};
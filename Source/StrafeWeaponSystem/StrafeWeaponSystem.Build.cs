@@ -8,10 +8,13 @@ public class StrafeWeaponSystem : ModuleRules
 	{
 		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
 	
-		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput", "Niagara", "GameplayTags", "GameplayAbilities", "GameplayTasks", "UMG" });
+		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput", "Niagara", "GameplayTags", "GameplayAbilities", "GameplayTasks", "UMG", "NetCore", "ReplicationGraph" });
 
 		PrivateDependencyModuleNames.AddRange(new string[] {  });
 
+		// Iris serializers for the custom structs; legacy replication and the replication graph still work without it
+		SetupIrisSupport(Target);
+
 		// Uncomment if you are using Slate UI
 		// PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore" });
 		
@@ -1,6 +1,19 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "StrafeWeaponSystem.h"
+#include "StrafeGameplayTags.h"
+#include "GameplayTagsManager.h"
 #include "Modules/ModuleManager.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, StrafeWeaponSystem, "StrafeWeaponSystem" );
+class FStrafeWeaponSystemModule : public FDefaultGameModuleImpl
+{
+public:
+    virtual void StartupModule() override
+    {
+#if !UE_BUILD_SHIPPING
+        UGameplayTagsManager::Get().CallOrRegister_OnDoneAddingNativeTagsDelegate(FSimpleDelegate::CreateStatic(&StrafeGameplayTags::ValidateAgainstConfig));
+#endif
+    }
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FStrafeWeaponSystemModule, StrafeWeaponSystem, "StrafeWeaponSystem" );
@@ -11,5 +11,6 @@ public class StrafeWeaponSystemEditorTarget : TargetRules
 		DefaultBuildSettings = BuildSettingsVersion.V5;
 		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_5;
 		ExtraModuleNames.Add("StrafeWeaponSystem");
+		bUseIris = true;
 	}
 }